@@ -0,0 +1,563 @@
+#include "uiee_engine.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <new>
+#include <numeric>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/utsname.h>
+
+// UIEE 引擎自身开销的微基准与长稳测试
+// 每个用例自动标定迭代次数（累计耗时不少于 --min-time），报告 ns/op、分配次数/op、分配字节/op 和 RSS。
+// 结果每行一个 JSON 对象写到标准输出（或 --output），首行是构建与设备信息，可直接 diff；
+// --compare 读入之前的结果文件，按用例与规模对比耗时。
+// 引擎以临时目录作为 $MODPATH 构造，不会改动设备上的模块数据。
+
+// 分配计数只统计基准线程，引擎后台线程（日志等）的分配不计入
+namespace {
+thread_local uint64_t t_allocations = 0;
+thread_local uint64_t t_allocated_bytes = 0;
+}
+
+void* operator new(size_t size) {
+    t_allocations++;
+    t_allocated_bytes += size;
+    if (void* p = malloc(size != 0 ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](size_t size) {
+    return operator new(size);
+}
+
+void* operator new(size_t size, std::align_val_t alignment) {
+    t_allocations++;
+    t_allocated_bytes += size;
+    size_t align = std::max(static_cast<size_t>(alignment), sizeof(void*));
+    void* p = nullptr;
+    if (posix_memalign(&p, align, size != 0 ? size : 1) != 0) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void* operator new[](size_t size, std::align_val_t alignment) {
+    return operator new(size, alignment);
+}
+
+// 与上面的 operator new 配对；GCC 看不出替换后的 new 来自 malloc，会误报 new/free 不匹配
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+void operator delete(void* p) noexcept { free(p); }
+#pragma GCC diagnostic pop
+void operator delete[](void* p) noexcept { operator delete(p); }
+void operator delete(void* p, size_t) noexcept { operator delete(p); }
+void operator delete[](void* p, size_t) noexcept { operator delete(p); }
+void operator delete(void* p, std::align_val_t) noexcept { operator delete(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { operator delete(p); }
+void operator delete(void* p, size_t, std::align_val_t) noexcept { operator delete(p); }
+void operator delete[](void* p, size_t, std::align_val_t) noexcept { operator delete(p); }
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+using Engine = UIEECoreEngine;
+
+struct Options {
+    double min_time_ms = 200.0;
+    std::string filter;
+    std::string output;
+    std::string compare;
+    int soak_seconds = 0;
+    bool quick = false;          // 只跑每组最小的两档规模
+};
+
+struct Result {
+    std::string name;
+    long param = 0;
+    uint64_t iterations = 0;
+    double ns_per_op = 0.0;
+    double allocs_per_op = 0.0;
+    double bytes_per_op = 0.0;
+    long rss_kb = 0;
+    long peak_rss_kb = 0;
+};
+
+// 每次调用执行 iterations 次被测操作
+using Body = std::function<void(uint64_t iterations)>;
+
+// 阻止编译器把结果未被使用的计算优化掉
+template <typename T>
+inline void keep(const T& value) {
+    asm volatile("" : : "g"(&value) : "memory");
+}
+
+long readStatusKb(const char* field) {
+    FILE* file = fopen("/proc/self/status", "r");
+    if (file == nullptr) {
+        return 0;
+    }
+    char line[256];
+    long value = 0;
+    size_t length = strlen(field);
+    while (fgets(line, sizeof(line), file) != nullptr) {
+        if (strncmp(line, field, length) == 0 && line[length] == ':') {
+            value = strtol(line + length + 1, nullptr, 10);
+            break;
+        }
+    }
+    fclose(file);
+    return value;
+}
+
+class Runner {
+public:
+    explicit Runner(const Options& options) : options_(options) {}
+
+    bool selected(const std::string& name) const {
+        return options_.filter.empty() || name.find(options_.filter) != std::string::npos;
+    }
+
+    // 先跑一次预热，再按上一轮耗时估算迭代次数，直到单轮耗时达到 min_time
+    void run(const std::string& name, long param, const Body& body) {
+        if (!selected(name)) {
+            return;
+        }
+        body(1);
+
+        uint64_t iterations = 1;
+        double elapsed_ns = 0.0;
+        uint64_t allocations = 0;
+        uint64_t bytes = 0;
+        const double target_ns = options_.min_time_ms * 1e6;
+        for (;;) {
+            uint64_t allocations_before = t_allocations;
+            uint64_t bytes_before = t_allocated_bytes;
+            auto start = Clock::now();
+            body(iterations);
+            elapsed_ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+            allocations = t_allocations - allocations_before;
+            bytes = t_allocated_bytes - bytes_before;
+            if (elapsed_ns >= target_ns || iterations >= (1ull << 40)) {
+                break;
+            }
+            double scale = elapsed_ns > 0.0 ? target_ns * 1.2 / elapsed_ns : 100.0;
+            iterations = static_cast<uint64_t>(iterations * std::min(std::max(scale, 2.0), 100.0));
+        }
+
+        Result result;
+        result.name = name;
+        result.param = param;
+        result.iterations = iterations;
+        result.ns_per_op = elapsed_ns / iterations;
+        result.allocs_per_op = static_cast<double>(allocations) / iterations;
+        result.bytes_per_op = static_cast<double>(bytes) / iterations;
+        result.rss_kb = readStatusKb("VmRSS");
+        result.peak_rss_kb = readStatusKb("VmHWM");
+        results_.push_back(result);
+
+        fprintf(stderr, "%-28s %8ld %14.1f ns/op %10.2f 次分配/op %12.1f B/op  RSS %ld KB\n",
+                name.c_str(), param, result.ns_per_op, result.allocs_per_op, result.bytes_per_op, result.rss_kb);
+    }
+
+    const std::vector<Result>& results() const { return results_; }
+    void clear() { results_.clear(); }
+
+private:
+    const Options& options_;
+    std::vector<Result> results_;
+};
+
+// 每组规模；--quick 时只取前两档
+std::vector<long> sizes(const Options& options, std::initializer_list<long> all) {
+    std::vector<long> values(all);
+    if (options.quick && values.size() > 2) {
+        values.resize(2);
+    }
+    return values;
+}
+
+Engine::PerformanceMetrics sampleMetrics() {
+    Engine::PerformanceMetrics metrics{};
+    metrics.cpu_usage = 42.0;
+    metrics.memory_usage = 55.0;
+    metrics.thermal_state = 38.0;
+    metrics.battery_level = 80.0;
+    metrics.responsiveness_score = 100.0 - metrics.cpu_usage;
+    metrics.fluency_score = 100.0 - metrics.thermal_state;
+    metrics.efficiency_score = 100.0 - metrics.memory_usage;
+    metrics.ces_score = 60.0;
+    return metrics;
+}
+
+void benchSampler(Runner& runner) {
+    UIEESystemSampler sampler;
+    if (!sampler.open()) {
+        fprintf(stderr, "无法打开 /proc/stat，跳过采样用例\n");
+        return;
+    }
+    runner.run("sampler_cpu", 0, [&sampler](uint64_t n) {
+        for (uint64_t i = 0; i < n; ++i) {
+            auto sample = sampler.sampleCPU();
+            keep(sample);
+        }
+    });
+    runner.run("sampler_memory", 0, [&sampler](uint64_t n) {
+        for (uint64_t i = 0; i < n; ++i) {
+            double value = sampler.readMemoryUsage();
+            keep(value);
+        }
+    });
+    runner.run("sampler_thermal", 0, [&sampler](uint64_t n) {
+        for (uint64_t i = 0; i < n; ++i) {
+            double value = sampler.readThermalState();
+            keep(value);
+        }
+    });
+}
+
+void benchMonitorScan(Runner& runner, const Options& options) {
+    // 真实 /proc 目录扫描（规模为当前进程数）
+    UIEEPidRescanner rescanner;
+    long live = static_cast<long>(rescanner.rescan().size());
+    runner.run("proc_rescan", live, [&rescanner](uint64_t n) {
+        for (uint64_t i = 0; i < n; ++i) {
+            keep(rescanner.rescan());
+        }
+    });
+
+    // 监控循环的校正路径：任务表取PID、排序、与扫描结果做集合差、增删任务。
+    // 合成 N 个PID，每轮约 2% 的进程退出并有同样数量的新进程出现
+    for (long count : sizes(options, {100, 1000, 10000})) {
+        UIEETaskTable table;
+        std::vector<int> current(static_cast<size_t>(count));
+        std::iota(current.begin(), current.end(), 1000);
+        auto now = Clock::now();
+        for (int pid : current) {
+            table.insert(pid, "com.example.app" + std::to_string(pid % 97), 0, 0, false, 0.0f, now);
+        }
+        int next_pid = 1000 + static_cast<int>(count);
+        const size_t churn = std::max<size_t>(1, static_cast<size_t>(count) / 50);
+        std::vector<int> known, added, removed;
+        known.reserve(current.size());
+
+        runner.run("monitor_scan", count, [&](uint64_t n) {
+            for (uint64_t i = 0; i < n; ++i) {
+                // 最老的 churn 个进程退出，追加同样数量的新PID（保持有序）
+                current.erase(current.begin(), current.begin() + static_cast<long>(churn));
+                for (size_t k = 0; k < churn; ++k) {
+                    current.push_back(next_pid++);
+                }
+
+                known.clear();
+                table.collectPids(known);
+                std::sort(known.begin(), known.end());
+                added.clear();
+                removed.clear();
+                UIEEPidRescanner::diff(known, current, added, removed);
+                for (int pid : removed) {
+                    table.erase(pid);
+                }
+                for (int pid : added) {
+                    table.insert(pid, "com.example.app", 0, 0, false, 0.0f, now);
+                }
+            }
+        });
+    }
+}
+
+void benchPareto(Runner& runner, const Options& options, Engine& engine) {
+    for (long count : sizes(options, {100, 1000, 10000, 100000})) {
+        std::mt19937 rng(static_cast<uint32_t>(count));
+        std::uniform_real_distribution<double> dist(0.0, 100.0);
+        std::vector<Engine::ParetoPoint> points(static_cast<size_t>(count));
+        for (auto& point : points) {
+            point.performance = dist(rng);
+            point.power_consumption = dist(rng);
+            point.thermal_impact = dist(rng);
+        }
+        runner.run("pareto_frontier", count, [&](uint64_t n) {
+            for (uint64_t i = 0; i < n; ++i) {
+                auto frontier = engine.calculateParetoFrontier(points);
+                keep(frontier);
+            }
+        });
+    }
+}
+
+void benchNash(Runner& runner, const Options& options, Engine& engine) {
+    for (long size : sizes(options, {2, 4, 8, 16, 32, 64})) {
+        std::mt19937 rng(static_cast<uint32_t>(size));
+        std::uniform_real_distribution<double> dist(-10.0, 10.0);
+        std::vector<std::vector<double>> payoff(static_cast<size_t>(size), std::vector<double>(static_cast<size_t>(size)));
+        for (auto& row : payoff) {
+            for (double& value : row) {
+                value = dist(rng);
+            }
+        }
+        runner.run("nash_equilibrium", size, [&](uint64_t n) {
+            for (uint64_t i = 0; i < n; ++i) {
+                auto equilibrium = engine.calculateNashEquilibrium(payoff);
+                keep(equilibrium);
+            }
+        });
+    }
+}
+
+void benchEvolution(Runner& runner, const Options& options) {
+    const auto metrics = sampleMetrics();
+    for (long size : sizes(options, {50, 500, 5000})) {
+        auto fitness = std::make_shared<Engine::HamiltonFitnessFunction>();
+        Engine::PopulationEvolutionManager population(static_cast<size_t>(size));
+        population.setFitnessFunction(fitness);
+        population.initializePopulation();
+
+        std::vector<double> scores;
+        runner.run("fitness_batch", size, [&](uint64_t n) {
+            for (uint64_t i = 0; i < n; ++i) {
+                auto view = population.view();
+                scores.resize(view.size);
+                fitness->calculateFitnessBatch(metrics, view.parameters, view.size, view.dims, scores.data());
+                keep(scores);
+            }
+        });
+
+        // 与 evaluatePopulationFitnessBatch 相同的分块方式；块数为 1 时即为串行，可与上一项对照投递开销
+        Engine::ThreadPoolManager pool(3);
+        const size_t chunk_size = Engine::HamiltonFitnessFunction::parallelChunkSize(static_cast<size_t>(size),
+                                                                                   pool.getThreadCount());
+        runner.run("fitness_batch_pool", size, [&](uint64_t n) {
+            for (uint64_t i = 0; i < n; ++i) {
+                auto view = population.view();
+                scores.resize(view.size);
+                size_t chunks = (view.size + chunk_size - 1) / chunk_size;
+                pool.parallelFor(0, chunks, [&](size_t chunk) {
+                    size_t begin = chunk * chunk_size;
+                    fitness->calculateFitnessBatch(metrics, view.row(begin), std::min(chunk_size, view.size - begin),
+                                                   view.dims, scores.data() + begin);
+                }, 1);
+                keep(scores);
+            }
+        });
+
+        auto components = fitness->calculateComponents(metrics);
+        runner.run("evolve_generation", size, [&](uint64_t n) {
+            for (uint64_t i = 0; i < n; ++i) {
+                auto view = population.view();
+                scores.resize(view.size);
+                fitness->calculateFitnessBatch(metrics, view.parameters, view.size, view.dims, scores.data());
+                population.applyFitnessScores(scores, components.performance, components.efficiency,
+                                              components.energy_cost);
+                population.evolveGeneration();
+            }
+        });
+    }
+}
+
+void runAll(Runner& runner, const Options& options, Engine& engine) {
+    benchSampler(runner);
+    benchMonitorScan(runner, options);
+    benchPareto(runner, options, engine);
+    benchNash(runner, options, engine);
+    benchEvolution(runner, options);
+}
+
+std::string formatResult(const Result& result) {
+    char line[512];
+    snprintf(line, sizeof(line),
+             "{\"bench\": \"%s\", \"param\": %ld, \"iterations\": %llu, \"ns_per_op\": %.1f, "
+             "\"allocs_per_op\": %.3f, \"bytes_per_op\": %.1f, \"rss_kb\": %ld, \"peak_rss_kb\": %ld}",
+             result.name.c_str(), result.param, static_cast<unsigned long long>(result.iterations),
+             result.ns_per_op, result.allocs_per_op, result.bytes_per_op, result.rss_kb, result.peak_rss_kb);
+    return line;
+}
+
+std::string formatMeta(const Options& options) {
+    struct utsname name;
+    if (uname(&name) != 0) {
+        memset(&name, 0, sizeof(name));
+    }
+    char line[512];
+    snprintf(line, sizeof(line),
+             "{\"meta\": {\"compiler\": \"%s\", \"machine\": \"%s\", \"kernel\": \"%s\", \"cpus\": %ld, "
+             "\"timestamp\": %lld, \"min_time_ms\": %.0f}}",
+             __VERSION__, name.machine, name.release, sysconf(_SC_NPROCESSORS_ONLN),
+             static_cast<long long>(time(nullptr)), options.min_time_ms);
+    return line;
+}
+
+// 读入之前输出的结果文件（只识别本程序写出的格式）
+std::vector<Result> loadResults(const std::string& path) {
+    std::vector<Result> results;
+    FILE* file = fopen(path.c_str(), "r");
+    if (file == nullptr) {
+        return results;
+    }
+    char line[512];
+    while (fgets(line, sizeof(line), file) != nullptr) {
+        char name[64];
+        Result result;
+        unsigned long long iterations = 0;
+        if (sscanf(line, "{\"bench\": \"%63[^\"]\", \"param\": %ld, \"iterations\": %llu, \"ns_per_op\": %lf, "
+                         "\"allocs_per_op\": %lf",
+                   name, &result.param, &iterations, &result.ns_per_op, &result.allocs_per_op) == 5) {
+            result.name = name;
+            result.iterations = iterations;
+            results.push_back(result);
+        }
+    }
+    fclose(file);
+    return results;
+}
+
+void compareResults(const std::vector<Result>& baseline, const std::vector<Result>& current) {
+    fprintf(stderr, "\n%-28s %8s %14s %14s %9s %14s\n", "用例", "规模", "基线 ns/op", "当前 ns/op", "变化", "分配/op 变化");
+    for (const auto& now : current) {
+        for (const auto& before : baseline) {
+            if (before.name == now.name && before.param == now.param && before.ns_per_op > 0.0) {
+                double delta = (now.ns_per_op - before.ns_per_op) / before.ns_per_op * 100.0;
+                fprintf(stderr, "%-28s %8ld %14.1f %14.1f %+8.1f%% %+14.2f\n", now.name.c_str(), now.param,
+                        before.ns_per_op, now.ns_per_op, delta, now.allocs_per_op - before.allocs_per_op);
+                break;
+            }
+        }
+    }
+}
+
+void usage(const char* program) {
+    fprintf(stderr,
+            "用法: %s [选项]\n"
+            "  --filter <子串>     只运行名称包含该子串的用例\n"
+            "  --min-time <毫秒>   每个用例的最短计时（默认 200）\n"
+            "  --quick             每组只跑最小的两档规模\n"
+            "  --output <文件>     结果写入文件（默认标准输出）\n"
+            "  --compare <文件>    与之前的结果文件对比耗时\n"
+            "  --soak <秒>         长稳测试：循环运行全部用例，报告每轮的RSS与耗时漂移\n",
+            program);
+}
+
+bool parseOptions(int argc, char* argv[], Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool has_value = i + 1 < argc;
+        if (arg == "--filter" && has_value) {
+            options.filter = argv[++i];
+        } else if (arg == "--min-time" && has_value) {
+            options.min_time_ms = std::max(1.0, atof(argv[++i]));
+        } else if (arg == "--quick") {
+            options.quick = true;
+        } else if (arg == "--output" && has_value) {
+            options.output = argv[++i];
+        } else if (arg == "--compare" && has_value) {
+            options.compare = argv[++i];
+        } else if (arg == "--soak" && has_value) {
+            options.soak_seconds = std::max(1, atoi(argv[++i]));
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+// 引擎构造时会创建日志、性能历史与检查点文件，全部放到临时目录
+std::string prepareScratchDirectory() {
+    const char* base = access("/data/local/tmp", W_OK) == 0 ? "/data/local/tmp" : "/tmp";
+    std::string pattern = std::string(base) + "/uiee_bench.XXXXXX";
+    std::vector<char> buffer(pattern.begin(), pattern.end());
+    buffer.push_back('\0');
+    if (mkdtemp(buffer.data()) == nullptr) {
+        return "";
+    }
+    std::string directory(buffer.data());
+    for (const char* sub : {"/data", "/data/performance", "/data/evolution", "/data/config", "/logs"}) {
+        mkdir((directory + sub).c_str(), 0755);
+    }
+    return directory;
+}
+
+void removeScratchDirectory(const std::string& directory) {
+    if (!directory.empty() && directory.find("/uiee_bench.") != std::string::npos) {
+        std::string command = "rm -rf '" + directory + "'";
+        if (system(command.c_str()) != 0) {
+            fprintf(stderr, "无法清理临时目录: %s\n", directory.c_str());
+        }
+    }
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    std::string scratch = prepareScratchDirectory();
+    if (scratch.empty()) {
+        fprintf(stderr, "无法创建临时目录\n");
+        return 1;
+    }
+    setenv("MODPATH", scratch.c_str(), 1);
+
+    FILE* out = stdout;
+    if (!options.output.empty()) {
+        out = fopen(options.output.c_str(), "w");
+        if (out == nullptr) {
+            fprintf(stderr, "无法写入结果文件: %s\n", options.output.c_str());
+            removeScratchDirectory(scratch);
+            return 1;
+        }
+    }
+
+    int status = 0;
+    {
+        Engine engine;
+        Runner runner(options);
+        fprintf(out, "%s\n", formatMeta(options).c_str());
+
+        if (options.soak_seconds > 0) {
+            // 长稳：整轮重复，RSS 持续增长或耗时漂移说明有泄漏或退化
+            auto deadline = Clock::now() + std::chrono::seconds(options.soak_seconds);
+            long first_rss = 0;
+            for (int round = 0; Clock::now() < deadline; ++round) {
+                runner.clear();
+                auto start = Clock::now();
+                runAll(runner, options, engine);
+                double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+                long rss = readStatusKb("VmRSS");
+                first_rss = round == 0 ? rss : first_rss;
+                fprintf(out, "{\"soak_round\": %d, \"seconds\": %.3f, \"rss_kb\": %ld, \"rss_growth_kb\": %ld, "
+                             "\"peak_rss_kb\": %ld}\n",
+                        round, seconds, rss, rss - first_rss, readStatusKb("VmHWM"));
+                fflush(out);
+            }
+        } else {
+            runAll(runner, options, engine);
+        }
+
+        for (const auto& result : runner.results()) {
+            fprintf(out, "%s\n", formatResult(result).c_str());
+        }
+
+        if (!options.compare.empty()) {
+            auto baseline = loadResults(options.compare);
+            if (baseline.empty()) {
+                fprintf(stderr, "无法读取基线结果: %s\n", options.compare.c_str());
+                status = 1;
+            } else {
+                compareResults(baseline, runner.results());
+            }
+        }
+    }
+
+    if (out != stdout) {
+        fclose(out);
+    }
+    removeScratchDirectory(scratch);
+    return status;
+}
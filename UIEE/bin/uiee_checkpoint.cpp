@@ -0,0 +1,218 @@
+#include "uiee_checkpoint.h"
+#include <cstring>
+#include <ctime>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+// 二进制检查点实现
+
+namespace {
+
+constexpr uint32_t kCheckpointMagic = 0x504b4355;   // "UCKP"
+constexpr size_t kAlignment = 8;
+
+struct FileHeader {
+    uint32_t magic;
+    uint32_t format_version;
+    uint32_t header_size;      // sizeof(FileHeader)，结构变化时用于识别
+    uint32_t section_count;
+    uint64_t payload_size;     // 段表 + 数据区的字节数
+    uint64_t checksum;         // 覆盖段表与数据区
+    int64_t created_at;        // time_t
+};
+
+struct SectionEntry {
+    uint32_t tag;
+    uint32_t reserved;
+    uint64_t offset;           // 相对数据区起点
+    uint64_t size;
+};
+
+constexpr uint64_t kFnvOffset = 0xcbf29ce484222325ull;
+constexpr uint64_t kFnvPrime = 0x100000001b3ull;
+
+uint64_t fnv1a(const void* data, size_t size, uint64_t hash) {
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < size; ++i) {
+        hash = (hash ^ bytes[i]) * kFnvPrime;
+    }
+    return hash;
+}
+
+bool writeAll(int fd, const void* data, size_t size) {
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    while (size > 0) {
+        ssize_t n = ::write(fd, bytes, size);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        bytes += n;
+        size -= static_cast<size_t>(n);
+    }
+    return true;
+}
+
+} // namespace
+
+void UIEECheckpointWriter::addSection(uint32_t tag, const void* data, size_t size) {
+    Section section;
+    section.tag = tag;
+    section.offset = data_.size();
+    section.size = size;
+    sections_.push_back(section);
+
+    size_t padded = (size + kAlignment - 1) & ~(kAlignment - 1);
+    data_.resize(data_.size() + padded, 0);
+    if (size > 0) {
+        memcpy(data_.data() + section.offset, data, size);
+    }
+}
+
+bool UIEECheckpointWriter::commit(const std::string& path) const {
+    std::vector<SectionEntry> table(sections_.size());
+    for (size_t i = 0; i < sections_.size(); ++i) {
+        table[i].tag = sections_[i].tag;
+        table[i].reserved = 0;
+        table[i].offset = sections_[i].offset;
+        table[i].size = sections_[i].size;
+    }
+    size_t table_size = table.size() * sizeof(SectionEntry);
+
+    FileHeader header;
+    memset(&header, 0, sizeof(header));
+    header.magic = kCheckpointMagic;
+    header.format_version = format_version_;
+    header.header_size = sizeof(FileHeader);
+    header.section_count = static_cast<uint32_t>(table.size());
+    header.payload_size = table_size + data_.size();
+    header.checksum = fnv1a(data_.data(), data_.size(), fnv1a(table.data(), table_size, kFnvOffset));
+    header.created_at = static_cast<int64_t>(time(nullptr));
+
+    std::string temp_path = path + ".tmp";
+    int fd = ::open(temp_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        return false;
+    }
+    bool ok = writeAll(fd, &header, sizeof(header)) &&
+              writeAll(fd, table.data(), table_size) &&
+              writeAll(fd, data_.data(), data_.size()) &&
+              fsync(fd) == 0;
+    int err = errno;
+    ::close(fd);
+    if (!ok || rename(temp_path.c_str(), path.c_str()) != 0) {
+        if (ok) {
+            err = errno;
+        }
+        unlink(temp_path.c_str());
+        errno = err;
+        return false;
+    }
+
+    // rename 本身也要落盘，否则掉电后目录项可能仍指向旧文件
+    size_t slash = path.find_last_of('/');
+    std::string directory = slash == std::string::npos ? "." : path.substr(0, slash);
+    int dir_fd = ::open(directory.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (dir_fd >= 0) {
+        fsync(dir_fd);
+        ::close(dir_fd);
+    }
+    return true;
+}
+
+bool UIEECheckpointReader::open(const std::string& path, uint32_t format_version) {
+    close();
+
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        failure_reason_ = "无法打开";
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(FileHeader)) {
+        ::close(fd);
+        failure_reason_ = "文件过短";
+        return false;
+    }
+    size_t size = static_cast<size_t>(st.st_size);
+    void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        failure_reason_ = "映射失败";
+        return false;
+    }
+
+    auto reject = [&](const char* reason) {
+        munmap(mapping, size);
+        failure_reason_ = reason;
+        return false;
+    };
+
+    FileHeader header;
+    memcpy(&header, mapping, sizeof(header));
+    if (header.magic != kCheckpointMagic || header.header_size != sizeof(FileHeader)) {
+        return reject("魔数不匹配");
+    }
+    if (header.format_version != format_version) {
+        return reject("版本不匹配");
+    }
+    uint64_t table_size = static_cast<uint64_t>(header.section_count) * sizeof(SectionEntry);
+    if (header.payload_size != size - sizeof(FileHeader) || table_size > header.payload_size) {
+        return reject("长度不一致");
+    }
+    const uint8_t* payload = static_cast<const uint8_t*>(mapping) + sizeof(FileHeader);
+    if (fnv1a(payload, header.payload_size, kFnvOffset) != header.checksum) {
+        return reject("校验和错误");
+    }
+
+    // 段表逐项检查越界，之后 section() 可以直接信任偏移
+    uint64_t data_size = header.payload_size - table_size;
+    for (uint32_t i = 0; i < header.section_count; ++i) {
+        SectionEntry entry;
+        memcpy(&entry, payload + i * sizeof(SectionEntry), sizeof(entry));
+        if (entry.offset > data_size || entry.size > data_size - entry.offset || entry.offset % kAlignment != 0) {
+            return reject("段表越界");
+        }
+    }
+
+    mapping_ = mapping;
+    mapping_size_ = size;
+    sections_ = payload;
+    section_count_ = header.section_count;
+    data_ = payload + table_size;
+    data_size_ = data_size;
+    created_at_ = header.created_at;
+    failure_reason_ = "";
+    return true;
+}
+
+void UIEECheckpointReader::close() {
+    if (mapping_ != nullptr) {
+        munmap(mapping_, mapping_size_);
+    }
+    mapping_ = nullptr;
+    mapping_size_ = 0;
+    sections_ = nullptr;
+    section_count_ = 0;
+    data_ = nullptr;
+    data_size_ = 0;
+    created_at_ = 0;
+}
+
+const void* UIEECheckpointReader::section(uint32_t tag, size_t& size) const {
+    for (uint32_t i = 0; i < section_count_; ++i) {
+        SectionEntry entry;
+        memcpy(&entry, sections_ + i * sizeof(SectionEntry), sizeof(entry));
+        if (entry.tag == tag) {
+            size = static_cast<size_t>(entry.size);
+            return data_ + entry.offset;
+        }
+    }
+    size = 0;
+    return nullptr;
+}
@@ -0,0 +1,96 @@
+#include "uiee_config_watcher.h"
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#endif
+
+// 配置文件变更检测实现
+
+UIEEConfigWatcher::UIEEConfigWatcher()
+    : inotify_fd_(-1), have_stat_(false), device_(0), inode_(0), size_(0), mtime_{} {}
+
+UIEEConfigWatcher::~UIEEConfigWatcher() {
+    close();
+}
+
+bool UIEEConfigWatcher::watch(const std::string& path) {
+    close();
+
+    size_t slash = path.find_last_of('/');
+    std::string directory = slash == std::string::npos ? "." : path.substr(0, slash);
+    struct stat st;
+    if (stat(directory.c_str(), &st) != 0 || !S_ISDIR(st.st_mode)) {
+        return false;
+    }
+    path_ = path;
+    name_ = slash == std::string::npos ? path : path.substr(slash + 1);
+    // 记录当前状态，回退模式下第一次 poll() 不会误报；文件尚不存在时出现即视为变更
+    statChanged();
+
+#ifdef __linux__
+    inotify_fd_ = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (inotify_fd_ >= 0 && inotify_add_watch(inotify_fd_, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO) < 0) {
+        ::close(inotify_fd_);
+        inotify_fd_ = -1;
+    }
+#endif
+    return true;
+}
+
+void UIEEConfigWatcher::close() {
+    if (inotify_fd_ >= 0) {
+        ::close(inotify_fd_);
+        inotify_fd_ = -1;
+    }
+    path_.clear();
+    name_.clear();
+    have_stat_ = false;
+}
+
+bool UIEEConfigWatcher::poll() {
+    if (path_.empty()) {
+        return false;
+    }
+
+#ifdef __linux__
+    if (inotify_fd_ >= 0) {
+        // 一次读空队列，同一周期内的多次写入只报告一次
+        alignas(struct inotify_event) char buffer[4096];
+        bool changed = false;
+        ssize_t n;
+        while ((n = read(inotify_fd_, buffer, sizeof(buffer))) > 0) {
+            for (char* p = buffer; p < buffer + n;) {
+                auto* event = reinterpret_cast<struct inotify_event*>(p);
+                if (event->len > 0 && name_ == event->name) {
+                    changed = true;
+                }
+                p += sizeof(struct inotify_event) + event->len;
+            }
+        }
+        return changed;
+    }
+#endif
+
+    return statChanged();
+}
+
+bool UIEEConfigWatcher::statChanged() {
+    struct stat st;
+    if (stat(path_.c_str(), &st) != 0) {
+        // 文件暂时不存在（正在替换），等它重新出现
+        have_stat_ = false;
+        return false;
+    }
+    bool changed = !have_stat_ || st.st_dev != device_ || st.st_ino != inode_ || st.st_size != size_ ||
+                   st.st_mtim.tv_sec != mtime_.tv_sec || st.st_mtim.tv_nsec != mtime_.tv_nsec;
+    have_stat_ = true;
+    device_ = st.st_dev;
+    inode_ = st.st_ino;
+    size_ = st.st_size;
+    mtime_ = st.st_mtim;
+    return changed;
+}
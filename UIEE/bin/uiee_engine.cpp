@@ -1,20 +1,62 @@
 #include "uiee_engine.h"
+#include "uiee_checkpoint.h"
+#include "uiee_trace.h"
 #include <iostream>
 #include <sys/stat.h>
 #include <unistd.h>
+#include <arpa/inet.h>
 #include <dirent.h>
 #include <fcntl.h>
 #include <signal.h>
 #include <cstring>
+#include <array>
 #include <sys/resource.h>
 #include <sched.h>
 #include <errno.h>
+#include <cstdarg>
+#include <cstdio>
+#include <ctime>
+#include <charconv>
+#include <string_view>
 
 // UIEE核心引擎实现
 
 UIEECoreEngine::UIEECoreEngine() 
     : running_(false), game_running_(false), evolution_active_(false) {
     
+    // 各工作循环的计时器：调度、监控（含温度档位检查）、长期进化
+    main_timer_ = scheduler_.addTimer(std::chrono::seconds(config_.read()->scheduling_interval), kEventCoalesceGap);
+    monitor_timer_ = scheduler_.addTimer(kMonitorPeriod);
+    evolution_timer_ = scheduler_.addTimer(kEvolutionPeriod);
+    evolution_frontier_.setCapacity(FRONTIER_CAPACITY);
+    
+    // 日志线程最先启动，构造期间的日志也走异步队列
+    logger_.start(resolveLogDirectory());
+    
+    // 性能历史挂载到映射文件，重启后直接恢复
+    std::string history_path = resolveDataDirectory() + "/performance/metrics_history.bin";
+    if (!performance_history_.attachFile(history_path)) {
+        logWarning("无法映射性能历史文件: " + history_path + "，历史仅保存在内存中");
+    } else if (!performance_history_.empty()) {
+        logInfo("已恢复 " + std::to_string(performance_history_.size()) + " 条性能历史");
+    }
+    
+    // 打开常驻的系统指标fd
+    if (!system_sampler_.open()) {
+        logWarning("无法打开 /proc/stat，CPU使用率将不可用");
+    }
+    
+    // 按类型识别温度分区（CPU/GPU/机身/电池），监控线程据此拟合热模型
+    if (thermal_model_.discover()) {
+        logInfo("已识别 " + std::to_string(thermal_model_.zoneCount()) + " 个温度分区");
+    } else {
+        logWarning("未找到可读的温度分区，热状态将不可用");
+    }
+    
+    if (!pressure_monitor_.open()) {
+        logWarning("内核未开启 PSI，CPU/内存/I/O 压力不可用");
+    }
+    
     // 初始化设备信息
     initializeDeviceInfo();
     
@@ -28,6 +70,9 @@ UIEECoreEngine::UIEECoreEngine()
     // 初始化Hamilton理论组件
     initializeHamiltonComponents();
     
+    // 从上次保存的检查点热恢复种群、博弈者与进化历史
+    loadEvolutionCheckpoint();
+    
     logInfo("UIEE核心引擎初始化完成 - 集成Hamilton适应度理论和连续囚徒困境 + 性能优化");
 }
 
@@ -49,19 +94,60 @@ bool UIEECoreEngine::start() {
         return false;
     }
     
-    if (!config_.enable_engine) {
-        logInfo("引擎被配置禁用");
-        return false;
+    bool enable_scene_detection;
+    bool enable_web_ui;
+    {
+        auto config = config_.read();
+        if (!config->enable_engine) {
+            logInfo("引擎被配置禁用");
+            return false;
+        }
+        enable_scene_detection = config->enable_scene_detection;
+        enable_web_ui = config->enable_web_ui;
     }
     
     running_ = true;
     
+    // 配置文件加载之后再应用检查点中的最佳个体，否则会被配置里的初始权重覆盖
+    if (checkpoint_restored_) {
+        checkpoint_restored_ = false;
+        applyEvolutionaryParameters();
+    }
+    
     // 启动主线程
     main_thread_ = std::thread(&UIEECoreEngine::mainLoop, this);
     
     // 启动监控线程
     monitor_thread_ = std::thread(&UIEECoreEngine::monitoringLoop, this);
     
+    // 前台应用检测（top-app cgroup 变化时回调）
+    if (enable_scene_detection) {
+        if (!scene_detector_.start([this](const UIEESceneDetector::ForegroundApp& app) {
+                handleForegroundChange(app);
+            })) {
+            logWarning("top-app cgroup 不可用，前台场景检测未启用");
+        } else if (scene_detector_.isEventDriven()) {
+            logInfo("已启用前台应用检测（inotify）");
+        } else {
+            logWarning("inotify 不可用，前台应用检测回退到轮询");
+        }
+    }
+    
+    // PSI 触发器：回收或 I/O 停顿超过阈值时立即重新调度，把后台 I/O 降级
+    if (pressure_monitor_.available()) {
+        if (pressure_monitor_.start([this](UIEEPressureMonitor::Resource) {
+                scheduler_.notify(UIEEEventScheduler::TRIGGER_PRESSURE);
+            })) {
+            logInfo("已登记 PSI 内存/I/O 压力触发器");
+        } else {
+            logWarning("无法登记 PSI 触发器，资源压力仅按周期采样");
+        }
+    }
+    
+    if (enable_web_ui) {
+        startWebServer();
+    }
+    
     logInfo("UIEE核心引擎启动成功");
     return true;
 }
@@ -72,7 +158,12 @@ void UIEECoreEngine::stop() {
     }
     
     running_ = false;
-    cv_.notify_all();
+    scheduler_.wake(main_timer_, UIEEEventScheduler::TRIGGER_SHUTDOWN);
+    scheduler_.wake(monitor_timer_, UIEEEventScheduler::TRIGGER_SHUTDOWN);
+    proc_events_.stop();
+    scene_detector_.stop();
+    pressure_monitor_.stop();
+    web_server_.stop();
     
     // 等待线程结束
     if (main_thread_.joinable()) {
@@ -83,79 +174,464 @@ void UIEECoreEngine::stop() {
         monitor_thread_.join();
     }
     
+    {
+        std::lock_guard<std::mutex> lock(history_mutex_);
+        performance_history_.sync();
+    }
+    
     logInfo("UIEE核心引擎已停止");
 }
 
 void UIEECoreEngine::loadConfig(const std::string& configPath) {
-    std::lock_guard<std::mutex> lock(config_mutex_);
-    
     // 首先尝试data/config目录
-    std::string primary_path = configPath;
-    size_t conf_pos = primary_path.find("/conf/");
+    std::string path = configPath;
+    size_t conf_pos = path.find("/conf/");
     if (conf_pos != std::string::npos) {
-        primary_path.replace(conf_pos, 6, "/data/config/");
+        path.replace(conf_pos, 6, "/data/config/");
     }
-    
-    std::ifstream configFile(primary_path);
-    if (!configFile.is_open()) {
+    if (access(path.c_str(), R_OK) != 0) {
         // 尝试原始路径
-        configFile.open(configPath);
-        if (!configFile.is_open()) {
-            logError("无法打开配置文件: " + primary_path + " 和 " + configPath);
+        if (access(configPath.c_str(), R_OK) != 0) {
+            logError("无法打开配置文件: " + path + " 和 " + configPath);
             return;
-        } else {
-            logInfo("使用配置文件: " + configPath);
         }
-    } else {
-        logInfo("使用配置文件: " + primary_path);
+        path = configPath;
     }
+    logInfo("使用配置文件: " + path);
     
-    std::string line;
-    while (std::getline(configFile, line)) {
-        // 跳过注释和空行
-        if (line.empty() || line[0] == '#') {
+    {
+        std::lock_guard<std::mutex> lock(config_mutex_);
+        config_path_ = path;
+    }
+    if (reloadConfig()) {
+        logInfo("配置文件加载完成: " + path);
+    }
+}
+
+// 一次读入整个文件；配置文件很小，超过上限视为异常
+static bool readConfigText(const std::string& path, std::string& text) {
+    constexpr size_t kMaxConfigSize = 64 * 1024;
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) > kMaxConfigSize) {
+        close(fd);
+        return false;
+    }
+    text.resize(static_cast<size_t>(st.st_size));
+    size_t total = 0;
+    while (total < text.size()) {
+        ssize_t n = read(fd, &text[total], text.size() - total);
+        if (n < 0 && errno == EINTR) {
             continue;
         }
+        if (n <= 0) {
+            break;
+        }
+        total += static_cast<size_t>(n);
+    }
+    close(fd);
+    text.resize(total);
+    return true;
+}
+
+static std::string_view trimView(std::string_view text) {
+    size_t begin = text.find_first_not_of(" \t\r");
+    if (begin == std::string_view::npos) {
+        return std::string_view();
+    }
+    size_t end = text.find_last_not_of(" \t\r");
+    return text.substr(begin, end - begin + 1);
+}
+
+static bool parseFlag(std::string_view value, bool& out) {
+    if (value == "true" || value == "1") {
+        out = true;
+    } else if (value == "false" || value == "0") {
+        out = false;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+static bool parseInteger(std::string_view value, int min, int max, int& out) {
+    int parsed = 0;
+    auto result = std::from_chars(value.data(), value.data() + value.size(), parsed);
+    if (result.ec != std::errc() || result.ptr != value.data() + value.size() || parsed < min || parsed > max) {
+        return false;
+    }
+    out = parsed;
+    return true;
+}
+
+static bool parseReal(std::string_view value, double min, double max, double& out) {
+    // strtod 需要以 '\0' 结尾，数值很短，拷到栈上
+    char buffer[32];
+    if (value.empty() || value.size() >= sizeof(buffer)) {
+        return false;
+    }
+    memcpy(buffer, value.data(), value.size());
+    buffer[value.size()] = '\0';
+    char* end = nullptr;
+    double parsed = strtod(buffer, &end);
+    if (end != buffer + value.size() || !std::isfinite(parsed) || parsed < min || parsed > max) {
+        return false;
+    }
+    out = parsed;
+    return true;
+}
+
+bool UIEECoreEngine::parseConfig(const std::string& text, Config& config) {
+    // 单遍扫描，行、节名、键值都是指向 text 的 string_view，只有字符串型配置项才拷贝；
+    // 未知的节或键只告警，取值非法时报告全部错误后返回 false，调用方整体放弃这份配置
+    static const char* const kPriorityKeys[SCENE_SOURCE_COUNT] = {
+        "user_manual_priority", "preset_mode_priority", "whitelist_rule_priority", "auto_smart_priority"
+    };
+    static const char* const kFpsTargetKeys[SCENE_UNKNOWN] = {
+        "game_fps_target", "social_fps_target", "media_fps_target", "productivity_fps_target"
+    };
+    
+    const std::string_view content(text);
+    std::string_view section;
+    int errors = 0;
+    int line_number = 0;
+    size_t pos = 0;
+    while (pos < content.size()) {
+        size_t end = content.find('\n', pos);
+        if (end == std::string_view::npos) {
+            end = content.size();
+        }
+        std::string_view line = trimView(content.substr(pos, end - pos));
+        pos = end + 1;
+        line_number++;
         
-        // 简单的配置解析
-        size_t pos = line.find('=');
-        if (pos == std::string::npos) {
+        // 跳过注释和空行
+        if (line.empty() || line[0] == '#' || line[0] == ';') {
+            continue;
+        }
+        if (line[0] == '[') {
+            if (line.back() != ']') {
+                logError("配置第 " + std::to_string(line_number) + " 行: 节名缺少 ']'");
+                errors++;
+                section = std::string_view();
+                continue;
+            }
+            section = trimView(line.substr(1, line.size() - 2));
             continue;
         }
         
-        std::string key = line.substr(0, pos);
-        std::string value = line.substr(pos + 1);
+        size_t eq = line.find('=');
+        if (eq == std::string_view::npos) {
+            logError("配置第 " + std::to_string(line_number) + " 行: 缺少 '='");
+            errors++;
+            continue;
+        }
+        std::string_view key = trimView(line.substr(0, eq));
+        std::string_view value = trimView(line.substr(eq + 1));
         
-        // 移除前后空格
-        key.erase(0, key.find_first_not_of(" \t\r\n"));
-        key.erase(key.find_last_not_of(" \t\r\n") + 1);
-        value.erase(0, value.find_first_not_of(" \t\r\n"));
-        value.erase(value.find_last_not_of(" \t\r\n") + 1);
+        bool known = true;
+        bool valid = true;
+        if (section == "system") {
+            if (key == "enable_engine") {
+                valid = parseFlag(value, config.enable_engine);
+            } else if (key == "scheduling_interval") {
+                valid = parseInteger(value, 1, 3600, config.scheduling_interval);
+            } else if (key == "optimization_enabled") {
+                valid = parseFlag(value, config.optimization_enabled);
+            } else {
+                known = false;
+            }
+        } else if (section == "ces_calculator") {
+            if (key == "responsiveness_weight") {
+                valid = parseReal(value, 0.0, 1.0, config.responsiveness_weight);
+            } else if (key == "fluency_weight") {
+                valid = parseReal(value, 0.0, 1.0, config.fluency_weight);
+            } else if (key == "efficiency_weight") {
+                valid = parseReal(value, 0.0, 1.0, config.efficiency_weight);
+            } else if (key == "thermal_weight") {
+                valid = parseReal(value, 0.0, 1.0, config.thermal_weight);
+            } else {
+                known = false;
+            }
+        } else if (section == "scheduling") {
+            known = false;
+            for (int i = 0; i < SCENE_SOURCE_COUNT; ++i) {
+                if (key == kPriorityKeys[i]) {
+                    known = true;
+                    valid = parseInteger(value, 1, 100, config.scene_source_priority[i]);
+                }
+            }
+        } else if (section == "scene_perception") {
+            int scene = -1;
+            if (key == "enable_scene_detection") {
+                valid = parseFlag(value, config.enable_scene_detection);
+            } else if (key == "enable_frame_timing") {
+                valid = parseFlag(value, config.enable_frame_timing);
+            } else if (key == "scene_table") {
+                config.scene_table.assign(value.data(), value.size());
+            } else if (key == "current_scene") {
+                valid = parseInteger(value, SCENE_GAME, SCENE_UNKNOWN, scene);
+                config.preset_scene = valid ? static_cast<SceneType>(scene) : SCENE_UNKNOWN;
+            } else {
+                known = false;
+                for (int i = 0; i < SCENE_UNKNOWN; ++i) {
+                    if (key == kFpsTargetKeys[i]) {
+                        known = true;
+                        valid = parseInteger(value, 1, 240, config.fps_target[i]);
+                    }
+                }
+            }
+        } else if (section == "cto_config") {
+            if (key == "enable_task_binding") {
+                valid = parseFlag(value, config.cto_config.enable_task_binding);
+            } else if (key == "enable_io_scheduling") {
+                valid = parseFlag(value, config.cto_config.enable_io_scheduling);
+            } else if (key == "enable_cpu_affinity") {
+                valid = parseFlag(value, config.cto_config.enable_cpu_affinity);
+            } else if (key == "enable_thread_scheduling") {
+                valid = parseFlag(value, config.cto_config.enable_thread_scheduling);
+            } else if (key == "max_bound_cores") {
+                valid = parseInteger(value, 0, UIEECpuTopology::MAX_CPU_CORES, config.cto_config.max_bound_cores);
+            } else if (key == "game_io_idle") {
+                valid = parseFlag(value, config.cto_config.game_io_idle);
+            } else {
+                known = false;
+            }
+        } else if (section == "logging") {
+            UIEELogger::Level level;
+            if (key == "log_level") {
+                config.log_level.assign(value.data(), value.size());
+                valid = UIEELogger::parseLevel(config.log_level, level);
+            } else if (key == "max_log_size") {
+                valid = parseInteger(value, 0, 1024, config.max_log_size);
+            } else if (key == "enable_performance_log") {
+                valid = parseFlag(value, config.enable_performance_log);
+            } else if (key == "enable_error_log") {
+                valid = parseFlag(value, config.enable_error_log);
+            } else if (key == "enable_trace_marker") {
+                valid = parseFlag(value, config.enable_trace_marker);
+            } else {
+                known = false;
+            }
+        } else if (section == "web_ui") {
+            if (key == "enable_web_ui") {
+                valid = parseFlag(value, config.enable_web_ui);
+            } else if (key == "web_ui_port") {
+                valid = parseInteger(value, 1, 65535, config.web_ui_port);
+            } else if (key == "bind_address") {
+                struct in_addr address;
+                config.web_ui_bind_address.assign(value.data(), value.size());
+                valid = inet_pton(AF_INET, config.web_ui_bind_address.c_str(), &address) == 1;
+            } else if (key == "require_token") {
+                valid = parseFlag(value, config.web_ui_require_token);
+            } else if (key == "web_root") {
+                config.web_root.assign(value.data(), value.size());
+            } else {
+                known = false;
+            }
+        } else if (section == "device_discovery") {
+            if (key == "enable_auto_discovery") {
+                valid = parseFlag(value, config.enable_auto_discovery);
+            } else if (key == "cache_device_info") {
+                valid = parseFlag(value, config.cache_device_info);
+            } else if (key == "performance_profiling") {
+                valid = parseFlag(value, config.performance_profiling);
+            } else {
+                known = false;
+            }
+        } else {
+            known = false;
+        }
         
-        // 解析配置项
-        if (key == "enable_engine") {
-            config_.enable_engine = (value == "true");
-        } else if (key == "scheduling_interval") {
-            config_.scheduling_interval = std::stoi(value);
-        } else if (key == "optimization_enabled") {
-            config_.optimization_enabled = (value == "true");
-        } else if (key == "responsiveness_weight") {
-            config_.responsiveness_weight = std::stod(value);
-        } else if (key == "fluency_weight") {
-            config_.fluency_weight = std::stod(value);
-        } else if (key == "efficiency_weight") {
-            config_.efficiency_weight = std::stod(value);
-        } else if (key == "thermal_weight") {
-            config_.thermal_weight = std::stod(value);
+        if (!known) {
+            logWarning("配置第 " + std::to_string(line_number) + " 行: 未知配置项 [" + std::string(section) + "] " +
+                       std::string(key) + "，已忽略");
+        } else if (!valid) {
+            logError("配置第 " + std::to_string(line_number) + " 行: 取值无效 " + std::string(key) + "=" +
+                     std::string(value));
+            errors++;
         }
     }
     
-    configFile.close();
-    logInfo("配置文件加载完成: " + configPath);
+    return errors == 0;
+}
+
+bool UIEECoreEngine::reloadConfig() {
+    std::string path;
+    {
+        std::lock_guard<std::mutex> lock(config_mutex_);
+        path = config_path_;
+    }
+    if (path.empty()) {
+        return false;
+    }
+    
+    std::string text;
+    if (!readConfigText(path, text)) {
+        logError("无法读取配置文件: " + path);
+        return false;
+    }
+    // 从默认值开始解析，文件中删掉的配置项恢复默认
+    Config config;
+    if (!parseConfig(text, config)) {
+        logError("配置文件校验失败，保持当前配置: " + path);
+        return false;
+    }
+    // 文件中的 CES 权重只是进化的初值，进化接管后同一次发布里换回当前最佳个体的权重
+    if (evolved_weights_active_ && population_manager_) {
+        overlayEvolvedWeights(config, population_manager_->getBestIndividual().parameters);
+    }
+    applyConfig(config);
+    return true;
+}
+
+// 在配置文本中把 [section] 下的 key 改为 value，其余行（含注释）保持不变；
+// 节内没有该键时追加在节的最后一个配置行之后，没有该节时在文件末尾新建
+static void setConfigValue(std::string& text, std::string_view section, std::string_view key, const std::string& value) {
+    const std::string line_text = std::string(key) + "=" + value;
+    if (!text.empty() && text.back() != '\n') {
+        text.push_back('\n');
+    }
+    std::string_view current;
+    bool in_section = false;
+    bool found_section = false;
+    size_t insert_at = std::string::npos;
+    size_t pos = 0;
+    while (pos < text.size()) {
+        size_t end = text.find('\n', pos);
+        size_t next = end + 1;
+        std::string_view line = trimView(std::string_view(text).substr(pos, end - pos));
+        if (!line.empty() && line[0] == '[' && line.back() == ']') {
+            current = trimView(line.substr(1, line.size() - 2));
+            in_section = current == section;
+            found_section |= in_section;
+            if (in_section) {
+                insert_at = next;
+            }
+        } else if (in_section && !line.empty() && line[0] != '#' && line[0] != ';') {
+            size_t eq = line.find('=');
+            if (eq != std::string_view::npos && trimView(line.substr(0, eq)) == key) {
+                text.replace(pos, end - pos, line_text);
+                return;
+            }
+            insert_at = next;
+        }
+        pos = next;
+    }
+    
+    if (found_section) {
+        text.insert(insert_at, line_text + "\n");
+    } else {
+        text += "\n[" + std::string(section) + "]\n" + line_text + "\n";
+    }
+}
+
+bool UIEECoreEngine::persistConfigValues(const std::vector<std::pair<std::string, std::string>>& values) {
+    // values 中的键形如 "节.键"；先写临时文件再 rename，监控线程随后按新文件重新加载
+    std::string path;
+    {
+        std::lock_guard<std::mutex> lock(config_mutex_);
+        path = config_path_;
+    }
+    std::string text;
+    if (path.empty() || !readConfigText(path, text)) {
+        return false;
+    }
+    for (const auto& entry : values) {
+        size_t dot = entry.first.find('.');
+        if (dot == std::string::npos) {
+            continue;
+        }
+        setConfigValue(text, std::string_view(entry.first).substr(0, dot),
+                       std::string_view(entry.first).substr(dot + 1), entry.second);
+    }
+    
+    std::string temp_path = path + ".tmp";
+    int fd = open(temp_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        return false;
+    }
+    size_t written = 0;
+    while (written < text.size()) {
+        ssize_t n = write(fd, text.data() + written, text.size() - written);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            break;
+        }
+        written += static_cast<size_t>(n);
+    }
+    bool ok = written == text.size() && fsync(fd) == 0;
+    close(fd);
+    if (!ok || rename(temp_path.c_str(), path.c_str()) != 0) {
+        unlink(temp_path.c_str());
+        return false;
+    }
+    return true;
+}
+
+void UIEECoreEngine::applyConfig(const Config& config) {
+    std::string config_path;
+    bool initial;
+    {
+        std::lock_guard<std::mutex> lock(config_mutex_);
+        const Config& previous = config_.current();
+        initial = config_.version() == 0;
+        if (!initial && (previous.enable_web_ui != config.enable_web_ui ||
+                         previous.web_ui_port != config.web_ui_port || previous.web_root != config.web_root ||
+                         previous.web_ui_bind_address != config.web_ui_bind_address ||
+                         previous.web_ui_require_token != config.web_ui_require_token ||
+                         previous.enable_scene_detection != config.enable_scene_detection)) {
+            logWarning("Web UI 与前台检测开关的修改在引擎重启后生效");
+        }
+        config_.publish(config);
+        config_path = config_path_;
+        
+        scene_claims_[SCENE_SOURCE_PRESET_MODE] = config.preset_scene;
+        current_scene_ = arbitrateScene(config);
+        
+        loadSceneTable(config_path, config.scene_table);
+        applyLoggingConfig(config);
+        frame_timing_.setEnabled(config.enable_frame_timing);
+        scheduler_.setPeriod(main_timer_, std::chrono::seconds(config.scheduling_interval));
+    }
+    if (!initial) {
+        logInfo("配置已重新加载: " + config_path + " (第 " + std::to_string(config_.version()) + " 版)");
+    }
+    scheduler_.notify(UIEEEventScheduler::TRIGGER_CONFIG_CHANGE);
+}
+
+void UIEECoreEngine::pollConfigFile() {
+    // 监控线程每个周期调用一次；首次调用时开始监听
+    std::string path;
+    {
+        std::lock_guard<std::mutex> lock(config_mutex_);
+        path = config_path_;
+    }
+    if (path.empty()) {
+        return;
+    }
+    if (config_watcher_.path() != path) {
+        if (!config_watcher_.watch(path)) {
+            logWarning("无法监听配置文件: " + path + "，修改后需重启引擎");
+            return;
+        }
+        logInfo(std::string("已监听配置文件变更") + (config_watcher_.isEventDriven() ? "（inotify）" : "（轮询）") +
+                ": " + path);
+        return;
+    }
+    if (config_watcher_.poll()) {
+        reloadConfig();
+    }
 }
 
 void UIEECoreEngine::saveConfig(const std::string& configPath) {
-    std::lock_guard<std::mutex> lock(config_mutex_);
+    // 复制一份当前配置，写文件期间不阻塞写者
+    const Config config = config_.load();
     
     std::ofstream configFile(configPath);
     if (!configFile.is_open()) {
@@ -163,40 +639,129 @@ void UIEECoreEngine::saveConfig(const std::string& configPath) {
         return;
     }
     
+    auto flag = [](bool value) { return value ? "true" : "false"; };
+    
     configFile << "# UIEE智能调度引擎配置\n";
     configFile << "# 3.0版本配置\n\n";
     
     configFile << "[system]\n";
-    configFile << "enable_engine=" << (config_.enable_engine ? "true" : "false") << "\n";
-    configFile << "scheduling_interval=" << config_.scheduling_interval << "\n";
-    configFile << "optimization_enabled=" << (config_.optimization_enabled ? "true" : "false") << "\n\n";
+    configFile << "enable_engine=" << flag(config.enable_engine) << "\n";
+    configFile << "scheduling_interval=" << config.scheduling_interval << "\n";
+    configFile << "optimization_enabled=" << flag(config.optimization_enabled) << "\n\n";
     
     configFile << "[ces_calculator]\n";
-    configFile << "responsiveness_weight=" << config_.responsiveness_weight << "\n";
-    configFile << "fluency_weight=" << config_.fluency_weight << "\n";
-    configFile << "efficiency_weight=" << config_.efficiency_weight << "\n";
-    configFile << "thermal_weight=" << config_.thermal_weight << "\n\n";
+    configFile << "responsiveness_weight=" << config.responsiveness_weight << "\n";
+    configFile << "fluency_weight=" << config.fluency_weight << "\n";
+    configFile << "efficiency_weight=" << config.efficiency_weight << "\n";
+    configFile << "thermal_weight=" << config.thermal_weight << "\n\n";
+    
+    configFile << "[scheduling]\n";
+    configFile << "user_manual_priority=" << config.scene_source_priority[SCENE_SOURCE_USER_MANUAL] << "\n";
+    configFile << "preset_mode_priority=" << config.scene_source_priority[SCENE_SOURCE_PRESET_MODE] << "\n";
+    configFile << "whitelist_rule_priority=" << config.scene_source_priority[SCENE_SOURCE_WHITELIST_RULE] << "\n";
+    configFile << "auto_smart_priority=" << config.scene_source_priority[SCENE_SOURCE_AUTO_SMART] << "\n\n";
     
     configFile << "[scene_perception]\n";
-    configFile << "current_scene=" << static_cast<int>(config_.current_scene) << "\n\n";
+    if (config.preset_scene != SCENE_UNKNOWN) {
+        configFile << "current_scene=" << static_cast<int>(config.preset_scene) << "\n";
+    }
+    configFile << "enable_scene_detection=" << flag(config.enable_scene_detection) << "\n";
+    configFile << "enable_frame_timing=" << flag(config.enable_frame_timing) << "\n";
+    if (!config.scene_table.empty()) {
+        configFile << "scene_table=" << config.scene_table << "\n";
+    }
+    for (int i = 0; i < SCENE_UNKNOWN; ++i) {
+        configFile << appTypeName(static_cast<SceneType>(i)) << "_fps_target=" << config.fps_target[i] << "\n";
+    }
+    configFile << "\n";
+    
+    configFile << "[cto_config]\n";
+    configFile << "enable_task_binding=" << flag(config.cto_config.enable_task_binding) << "\n";
+    configFile << "enable_io_scheduling=" << flag(config.cto_config.enable_io_scheduling) << "\n";
+    configFile << "enable_cpu_affinity=" << flag(config.cto_config.enable_cpu_affinity) << "\n";
+    configFile << "enable_thread_scheduling=" << flag(config.cto_config.enable_thread_scheduling) << "\n";
+    configFile << "max_bound_cores=" << config.cto_config.max_bound_cores << "\n";
+    configFile << "game_io_idle=" << flag(config.cto_config.game_io_idle) << "\n\n";
+    
+    configFile << "[logging]\n";
+    configFile << "log_level=" << config.log_level << "\n";
+    configFile << "max_log_size=" << config.max_log_size << "\n";
+    configFile << "enable_performance_log=" << flag(config.enable_performance_log) << "\n";
+    configFile << "enable_error_log=" << flag(config.enable_error_log) << "\n";
+    configFile << "enable_trace_marker=" << flag(config.enable_trace_marker) << "\n\n";
+    
+    configFile << "[web_ui]\n";
+    configFile << "enable_web_ui=" << flag(config.enable_web_ui) << "\n";
+    configFile << "web_ui_port=" << config.web_ui_port << "\n";
+    configFile << "bind_address=" << config.web_ui_bind_address << "\n";
+    configFile << "require_token=" << flag(config.web_ui_require_token) << "\n";
+    if (!config.web_root.empty()) {
+        configFile << "web_root=" << config.web_root << "\n";
+    }
+    configFile << "\n";
+    
+    configFile << "[device_discovery]\n";
+    configFile << "enable_auto_discovery=" << flag(config.enable_auto_discovery) << "\n";
+    configFile << "cache_device_info=" << flag(config.cache_device_info) << "\n";
+    configFile << "performance_profiling=" << flag(config.performance_profiling) << "\n";
     
     configFile.close();
     logInfo("配置文件保存完成: " + configPath);
 }
 
 UIEECoreEngine::PerformanceMetrics UIEECoreEngine::getCurrentMetrics() {
+    UIEE_TRACE_SCOPE(PHASE_METRICS_SAMPLE);
     PerformanceMetrics metrics = {};
     
-    // 获取系统指标
-    metrics.cpu_usage = getCPUUsage();
+    // 获取系统指标（一次 /proc/stat 读取同时得到全局与每核心增量）
+    auto cpu_sample = system_sampler_.sampleCPU();
+    metrics.cpu_usage = cpu_sample.total_usage;
+    fillCoreTelemetry(metrics, cpu_sample);
     metrics.memory_usage = getMemoryUsage();
-    metrics.thermal_state = getThermalState();
-    metrics.battery_level = 100.0; // TODO: 从系统获取实际电池电量
+    auto pressure = pressure_monitor_.sample();
+    metrics.cpu_pressure = pressure.resource[UIEEPressureMonitor::RESOURCE_CPU].some_avg10;
+    metrics.memory_pressure = pressure.resource[UIEEPressureMonitor::RESOURCE_MEMORY].some_avg10;
+    metrics.io_pressure = pressure.resource[UIEEPressureMonitor::RESOURCE_IO].some_avg10;
+    auto thermal = currentThermal();
+    metrics.thermal_state = thermal.state;
+    metrics.thermal_predicted = thermal.predicted_state;
+    for (int i = 0; i < UIEEThermalModel::CATEGORY_COUNT; ++i) {
+        metrics.zone_temp_c[i] = thermal.present[i] ? static_cast<float>(thermal.temp_c[i]) : 0.0f;
+    }
+    fillPowerTelemetry(metrics);
+    
+    // 前台应用帧时序，按当前场景的目标帧率评分（未知场景按刷新率）
+    const SceneType scene = current_scene_;
+    double fps_target = 0.0;
+    bool frame_timing;
+    {
+        auto config = config_.read();
+        frame_timing = config->enable_frame_timing;
+        fps_target = scene < SCENE_UNKNOWN ? config->fps_target[scene] : 0.0;
+    }
+    UIEEFrameTimingCollector::FrameStats frames{};
+    if (frame_timing) {
+        frames = frame_timing_.stats(fps_target);
+    }
+    if (fps_target <= 0.0) {
+        fps_target = frames.refresh_period_ms > 0.0 ? 1000.0 / frames.refresh_period_ms : 60.0;
+    }
+    metrics.fps_target = fps_target;
     
     // 计算各维度分数
-    metrics.responsiveness_score = 100.0 - metrics.cpu_usage; // 响应性分数
-    metrics.fluency_score = 100.0 - metrics.thermal_state; // 流畅性分数
+    if (frames.valid) {
+        // 流畅性：帧率达成度扣除卡顿帧占比；响应性：p99 帧时间相对目标帧周期（长帧直接推迟输入的反馈）
+        metrics.fps = frames.fps;
+        metrics.frame_time_p99_ms = frames.frame_time_p99_ms;
+        metrics.jank_rate = frames.jank_rate;
+        metrics.fluency_score = 100.0 * std::min(1.0, frames.fps / fps_target) * (1.0 - frames.jank_rate);
+        metrics.responsiveness_score = 100.0 * std::min(1.0, 1000.0 / fps_target / frames.frame_time_p99_ms);
+    } else {
+        metrics.responsiveness_score = 100.0 - metrics.cpu_usage; // 没有帧数据时以CPU余量近似
+        metrics.fluency_score = 100.0 - metrics.thermal_state;    // 以温度余量近似
+    }
     metrics.efficiency_score = 100.0 - metrics.memory_usage; // 效率分数
+    metrics.energy_per_frame_mj = metrics.fps > 0.0 ? metrics.power_mw / metrics.fps : 0.0;
     
     // 计算CES综合体验分数
     metrics.ces_score = calculateCES(metrics);
@@ -204,15 +769,31 @@ UIEECoreEngine::PerformanceMetrics UIEECoreEngine::getCurrentMetrics() {
     return metrics;
 }
 
+UIEECoreEngine::MetricsWindow UIEECoreEngine::getMetricsWindow(double PerformanceMetrics::* field, size_t window) {
+    std::lock_guard<std::mutex> lock(history_mutex_);
+    
+    auto projection = [field](const PerformanceMetrics& metrics) { return metrics.*field; };
+    auto stats = performance_history_.windowStats(window, projection);
+    
+    MetricsWindow result{};
+    result.samples = stats.count;
+    result.min = stats.min;
+    result.max = stats.max;
+    result.mean = stats.mean;
+    result.ema = performance_history_.ema(window, 0.3, projection);
+    return result;
+}
+
 void UIEECoreEngine::addTask(const TaskInfo& task) {
     std::lock_guard<std::mutex> lock(tasks_mutex_);
     
-    // 检查任务是否已存在
-    auto it = std::find_if(active_tasks_.begin(), active_tasks_.end(),
-                          [&task](const TaskInfo& t) { return t.pid == task.pid; });
+    // 已存在时 insert 不做修改
+    bool inserted = false;
+    task_table_.insert(task.pid, task.name, static_cast<uint8_t>(parseAppType(task.app_type)),
+                       task.priority, task.is_foreground, static_cast<float>(task.cpu_affinity),
+                       task.start_time, &inserted);
     
-    if (it == active_tasks_.end()) {
-        active_tasks_.push_back(task);
+    if (inserted) {
         logInfo("添加任务: " + task.name + " (PID: " + std::to_string(task.pid) + ")");
     }
 }
@@ -220,18 +801,131 @@ void UIEECoreEngine::addTask(const TaskInfo& task) {
 void UIEECoreEngine::removeTask(int pid) {
     std::lock_guard<std::mutex> lock(tasks_mutex_);
     
-    auto it = std::find_if(active_tasks_.begin(), active_tasks_.end(),
-                          [pid](const TaskInfo& task) { return task.pid == pid; });
-    
-    if (it != active_tasks_.end()) {
-        logInfo("移除任务: " + it->name + " (PID: " + std::to_string(pid) + ")");
-        active_tasks_.erase(it);
+    int index = task_table_.indexOf(pid);
+    if (index >= 0) {
+        logInfo("移除任务: " + task_table_.name(index) + " (PID: " + std::to_string(pid) + ")");
+        task_table_.erase(pid);
+        placement_.forget(pid);
+        thread_roles_.forget(pid);
     }
 }
 
 std::vector<UIEECoreEngine::TaskInfo> UIEECoreEngine::getActiveTasks() {
     std::lock_guard<std::mutex> lock(tasks_mutex_);
-    return active_tasks_;
+    
+    std::vector<TaskInfo> tasks;
+    tasks.reserve(task_table_.size());
+    for (size_t i = 0; i < task_table_.size(); ++i) {
+        const auto& record = task_table_.record(i);
+        TaskInfo task;
+        task.name = task_table_.name(i);
+        task.pid = record.pid;
+        task.priority = record.priority;
+        task.app_type = appTypeName(static_cast<SceneType>(record.app_type));
+        task.cpu_affinity = record.cpu_affinity;
+        task.is_foreground = record.isForeground();
+        task.start_time = task_table_.startTime(i);
+        tasks.push_back(std::move(task));
+    }
+    return tasks;
+}
+
+size_t UIEECoreEngine::getActiveTaskCount() {
+    std::lock_guard<std::mutex> lock(tasks_mutex_);
+    return task_table_.size();
+}
+
+UIEECoreEngine::SceneType UIEECoreEngine::parseAppType(const std::string& app_type) {
+    if (app_type == "game") {
+        return SCENE_GAME;
+    } else if (app_type == "social") {
+        return SCENE_SOCIAL;
+    } else if (app_type == "media") {
+        return SCENE_MEDIA;
+    } else if (app_type == "productivity") {
+        return SCENE_PRODUCTIVITY;
+    }
+    return SCENE_UNKNOWN;
+}
+
+uint8_t UIEECoreEngine::classifyProcess(const std::string& name) const {
+    uint8_t scene = scene_detector_.classify(name);
+    return scene >= UIEESceneDetector::SCENE_IGNORE ? static_cast<uint8_t>(SCENE_UNKNOWN) : scene;
+}
+
+void UIEECoreEngine::loadSceneTable(const std::string& config_path, const std::string& scene_table) {
+    // 调用方持有 config_mutex_；未显式配置时依次尝试配置文件所在目录和 $MODPATH/conf
+    std::vector<std::string> candidates;
+    if (!scene_table.empty()) {
+        candidates.push_back(scene_table);
+    } else {
+        size_t slash = config_path.find_last_of('/');
+        std::string dir = slash == std::string::npos ? "." : config_path.substr(0, slash);
+        candidates.push_back(dir + "/scene_packages.conf");
+        const char* modpath = getenv("MODPATH");
+        if (modpath != nullptr) {
+            candidates.push_back(std::string(modpath) + "/conf/scene_packages.conf");
+        }
+    }
+    
+    auto parser = [](const std::string& name) {
+        SceneType scene = parseAppType(name);
+        return scene == SCENE_UNKNOWN ? -1 : static_cast<int>(scene);
+    };
+    
+    for (const auto& path : candidates) {
+        int count = scene_detector_.loadPackageTable(path, parser);
+        if (count >= 0) {
+            logInfo("包名场景表加载完成: " + path + " (" + std::to_string(count) + " 条)");
+            // 已有任务的场景由监控循环在任务锁下重新查表
+            scene_table_reloaded_ = true;
+            scheduler_.wake(monitor_timer_, UIEEEventScheduler::TRIGGER_RESYNC);
+            return;
+        }
+    }
+    logWarning("未找到包名场景表，前台场景只能通过接口设置");
+}
+
+void UIEECoreEngine::reclassifyTasks() {
+    std::lock_guard<std::mutex> lock(tasks_mutex_);
+    for (size_t i = 0; i < task_table_.size(); ++i) {
+        task_table_.record(i).app_type = classifyProcess(task_table_.name(i));
+    }
+}
+
+void UIEECoreEngine::handleForegroundChange(const UIEESceneDetector::ForegroundApp& app) {
+    SceneType scene = app.scene < UIEESceneDetector::SCENE_IGNORE ? static_cast<SceneType>(app.scene) : SCENE_UNKNOWN;
+    
+    if (app.pid >= 0) {
+        std::lock_guard<std::mutex> lock(tasks_mutex_);
+        for (auto& task : task_table_) {
+            task.setForeground(false);
+        }
+        int index = task_table_.insert(app.pid, app.package, static_cast<uint8_t>(scene), 0, true, 0.0f,
+                                       std::chrono::steady_clock::now());
+        if (index >= 0) {
+            auto& record = task_table_.record(index);
+            record.setForeground(true);
+            record.app_type = static_cast<uint8_t>(scene);
+        }
+    }
+    
+    // 命中场景表的前台应用作为白名单规则参与仲裁，未命中时该来源放弃
+    claimScene(SCENE_SOURCE_WHITELIST_RULE, scene);
+    frame_timing_.setTarget(app.package);
+    scheduler_.notify(UIEEEventScheduler::TRIGGER_FOREGROUND_CHANGE);
+    logInfo("前台应用切换: " + (app.package.empty() ? std::string("unknown") : app.package) +
+            " (PID: " + std::to_string(app.pid) + ", 场景: " + appTypeName(scene) + ")");
+}
+
+const char* UIEECoreEngine::appTypeName(SceneType app_type) {
+    switch (app_type) {
+        case SCENE_GAME: return "game";
+        case SCENE_SOCIAL: return "social";
+        case SCENE_MEDIA: return "media";
+        case SCENE_PRODUCTIVITY: return "productivity";
+        default: return "unknown";
+    }
 }
 
 UIEECoreEngine::SceneType UIEECoreEngine::detectCurrentScene() {
@@ -240,18 +934,10 @@ UIEECoreEngine::SceneType UIEECoreEngine::detectCurrentScene() {
     
     std::lock_guard<std::mutex> lock(tasks_mutex_);
     
-    for (const auto& task : active_tasks_) {
-        if (task.is_foreground) {
-            // 根据应用包名判断场景
-            if (task.app_type == "game") {
-                return SCENE_GAME;
-            } else if (task.app_type == "social") {
-                return SCENE_SOCIAL;
-            } else if (task.app_type == "media") {
-                return SCENE_MEDIA;
-            } else if (task.app_type == "productivity") {
-                return SCENE_PRODUCTIVITY;
-            }
+    for (const auto& task : task_table_) {
+        // app_type 已经是 SceneType，无需逐个比较字符串
+        if (task.isForeground() && task.app_type != SCENE_UNKNOWN) {
+            return static_cast<SceneType>(task.app_type);
         }
     }
     
@@ -259,189 +945,212 @@ UIEECoreEngine::SceneType UIEECoreEngine::detectCurrentScene() {
 }
 
 void UIEECoreEngine::setScenePreference(SceneType scene) {
+    claimScene(SCENE_SOURCE_USER_MANUAL, scene);
+    scheduler_.notify(UIEEEventScheduler::TRIGGER_FOREGROUND_CHANGE);
+    logInfo("场景偏好设置为: " + std::to_string(static_cast<int>(scene)) +
+            " (当前场景: " + appTypeName(current_scene_) + ")");
+}
+
+void UIEECoreEngine::claimScene(SceneSource source, SceneType scene) {
     std::lock_guard<std::mutex> lock(config_mutex_);
-    config_.current_scene = scene;
-    logInfo("场景偏好设置为: " + std::to_string(static_cast<int>(scene)));
+    scene_claims_[source] = scene;
+    current_scene_ = arbitrateScene(config_.current());
+}
+
+UIEECoreEngine::SceneType UIEECoreEngine::arbitrateScene(const Config& config) const {
+    // 调用方持有 config_mutex_；优先级相同时按来源枚举顺序
+    SceneType scene = SCENE_UNKNOWN;
+    int best_priority = 0;
+    for (int i = 0; i < SCENE_SOURCE_COUNT; ++i) {
+        if (scene_claims_[i] != SCENE_UNKNOWN &&
+            (scene == SCENE_UNKNOWN || config.scene_source_priority[i] < best_priority)) {
+            scene = scene_claims_[i];
+            best_priority = config.scene_source_priority[i];
+        }
+    }
+    return scene;
 }
 
 std::vector<UIEECoreEngine::ParetoPoint> UIEECoreEngine::calculateParetoFrontier(const std::vector<ParetoPoint>& points) {
-    std::vector<ParetoPoint> pareto_frontier;
+    // 支配条件：其他点在所有目标上都不劣于当前点，且至少在一个目标上优于当前点。
+    // 性能取负后三个目标都按越小越好，用 Kung 排序扫描代替两两比较
+    using Frontier = UIEEParetoFrontier<size_t>;
+    std::vector<std::array<double, Frontier::OBJECTIVES>> objectives(points.size());
+    for (size_t i = 0; i < points.size(); ++i) {
+        objectives[i] = {-points[i].performance, points[i].power_consumption, points[i].thermal_impact};
+    }
     
-    for (const auto& point : points) {
-        bool is_dominated = false;
-        
-        for (const auto& other : points) {
-            if (&point == &other) continue;
-            
-            // 检查是否被其他点支配
-            // 支配条件：其他点在所有目标上都不劣于当前点，且至少在一个目标上优于当前点
-            if (other.performance >= point.performance &&
-                other.power_consumption <= point.power_consumption &&
-                other.thermal_impact <= point.thermal_impact &&
-                (other.performance > point.performance ||
-                 other.power_consumption < point.power_consumption ||
-                 other.thermal_impact < point.thermal_impact)) {
-                is_dominated = true;
-                break;
-            }
-        }
-        
-        if (!is_dominated) {
-            pareto_frontier.push_back(point);
-        }
+    auto indices = Frontier::nonDominated(points.size(), [&objectives](size_t i) { return objectives[i].data(); });
+    
+    std::vector<ParetoPoint> pareto_frontier;
+    pareto_frontier.reserve(indices.size());
+    for (size_t index : indices) {
+        pareto_frontier.push_back(points[index]);
     }
     
     return pareto_frontier;
 }
 
+UIEECoreEngine::SceneWeights UIEECoreEngine::getSceneWeights(SceneType scene) {
+    switch (scene) {
+        case SCENE_GAME:
+            return {0.6, 0.2, 0.2};
+        case SCENE_SOCIAL:
+            return {0.3, 0.4, 0.3};
+        case SCENE_MEDIA:
+            return {0.4, 0.3, 0.3};
+        case SCENE_PRODUCTIVITY:
+            return {0.5, 0.3, 0.2};
+        default:
+            return {0.4, 0.3, 0.3};
+    }
+}
+
 UIEECoreEngine::ParetoPoint UIEECoreEngine::findOptimalPoint(const std::vector<ParetoPoint>& frontier) {
     if (frontier.empty()) {
         return ParetoPoint{};
     }
     
-    // 基于当前场景的权重选择最优解
-    double best_score = -1.0;
-    ParetoPoint optimal;
+    // 基于当前场景的权重选择最优解（权重在循环外取一次）
+    SceneWeights weights = getSceneWeights(current_scene_);
+    
+    // 预测热状态超过 50 后逐步把性能权重转给温度（最多 0.3），在内核降频之前先让出性能
+    const double predicted = thermal_model_.latest().predicted_state;
+    const double pressure = std::max(0.0, std::min(1.0, (predicted - 50.0) / 40.0));
+    const double shift = std::max(0.0, std::min(0.3 * pressure, weights.performance - 0.1));
+    weights.performance -= shift;
+    weights.thermal += shift;
     
+    const ParetoPoint* optimal = &frontier.front();
+    double best_score = std::numeric_limits<double>::lowest();
     for (const auto& point : frontier) {
-        // 根据场景调整权重
-        double performance_weight = 0.4;
-        double power_weight = 0.3;
-        double thermal_weight = 0.3;
-        
-        switch (config_.current_scene) {
-            case SCENE_GAME:
-                performance_weight = 0.6;
-                power_weight = 0.2;
-                thermal_weight = 0.2;
-                break;
-            case SCENE_SOCIAL:
-                performance_weight = 0.3;
-                power_weight = 0.4;
-                thermal_weight = 0.3;
-                break;
-            case SCENE_MEDIA:
-                performance_weight = 0.4;
-                power_weight = 0.3;
-                thermal_weight = 0.3;
-                break;
-            case SCENE_PRODUCTIVITY:
-                performance_weight = 0.5;
-                power_weight = 0.3;
-                thermal_weight = 0.2;
-                break;
-            default:
-                break;
-        }
-        
-        double score = performance_weight * point.performance -
-                      power_weight * point.power_consumption -
-                      thermal_weight * point.thermal_impact;
+        double score = weights.performance * point.performance -
+                      weights.power * point.power_consumption -
+                      weights.thermal * point.thermal_impact;
         
         if (score > best_score) {
             best_score = score;
-            optimal = point;
+            optimal = &point;
         }
     }
     
-    return optimal;
+    return *optimal;
 }
 
 UIEECoreEngine::NashEquilibrium UIEECoreEngine::calculateNashEquilibrium(const std::vector<std::vector<double>>& payoff_matrix) {
-    NashEquilibrium equilibrium;
-    
-    // 简化的纳什均衡计算
-    // 实际实现中需要更复杂的算法
-    
-    size_t num_strategies = payoff_matrix.size();
-    if (num_strategies == 0) {
+    UIEEPayoffMatrix row_payoff = UIEEPayoffMatrix::fromRows(payoff_matrix);
+    if (row_payoff.rows() != row_payoff.cols()) {
+        logWarning("纳什均衡求解失败: 对称博弈的收益矩阵必须是方阵（" + std::to_string(row_payoff.rows()) + "×" +
+                   std::to_string(row_payoff.cols()) + "）");
+        NashEquilibrium equilibrium;
+        equilibrium.utility_value = 0.0;
+        equilibrium.exploitability = 0.0;
+        equilibrium.iterations = 0;
         return equilibrium;
     }
-    
-    // 初始化策略向量
-    equilibrium.strategies.resize(num_strategies, 1.0 / num_strategies);
-    
-    // 迭代优化（简化版）
-    const int max_iterations = 100;
-    const double convergence_threshold = 1e-6;
-    
-    for (int iter = 0; iter < max_iterations; ++iter) {
-        std::vector<double> new_strategies = equilibrium.strategies;
-        bool converged = true;
-        
-        for (size_t i = 0; i < num_strategies; ++i) {
-            double expected_payoff = 0.0;
-            for (size_t j = 0; j < num_strategies; ++j) {
-                expected_payoff += equilibrium.strategies[j] * payoff_matrix[i][j];
-            }
-            
-            // 更新策略（简化版）
-            new_strategies[i] = std::max(0.0, expected_payoff);
-        }
-        
-        // 归一化
-        double sum = 0.0;
-        for (auto& strategy : new_strategies) {
-            sum += strategy;
-        }
-        
-        if (sum > 0) {
-            for (auto& strategy : new_strategies) {
-                strategy /= sum;
-            }
-        }
-        
-        // 检查收敛
-        for (size_t i = 0; i < num_strategies; ++i) {
-            if (std::abs(new_strategies[i] - equilibrium.strategies[i]) > convergence_threshold) {
-                converged = false;
-                break;
-            }
-        }
-        
-        equilibrium.strategies = new_strategies;
-        
-        if (converged) {
-            break;
-        }
-    }
-    
-    // 计算均衡效用值
+    return calculateNashEquilibrium(row_payoff, row_payoff.transposed());
+}
+
+UIEECoreEngine::NashEquilibrium UIEECoreEngine::calculateNashEquilibrium(const UIEEPayoffMatrix& row_payoff,
+                                                                         const UIEEPayoffMatrix& col_payoff) {
+    NashEquilibrium equilibrium;
     equilibrium.utility_value = 0.0;
-    for (size_t i = 0; i < num_strategies; ++i) {
-        for (size_t j = 0; j < num_strategies; ++j) {
-            equilibrium.utility_value += equilibrium.strategies[i] * 
-                                       equilibrium.strategies[j] * payoff_matrix[i][j];
+    equilibrium.exploitability = 0.0;
+    equilibrium.iterations = 0;
+    
+    UIEENashSolver::Result result;
+    {
+        std::lock_guard<std::mutex> lock(nash_mutex_);
+        if (!nash_solver_.solve(row_payoff, col_payoff, result)) {
+            if (!row_payoff.empty()) {
+                logWarning("纳什均衡求解失败: 收益矩阵维度不一致");
+            }
+            return equilibrium;
         }
     }
     
+    equilibrium.strategies = std::move(result.row_strategy);
+    equilibrium.opponent_strategies = std::move(result.col_strategy);
+    equilibrium.utility_value = result.row_value;
+    equilibrium.exploitability = result.exploitability;
+    equilibrium.iterations = result.iterations;
     return equilibrium;
 }
 
 void UIEECoreEngine::applyCTOConfig(const CTOConfig& config) {
-    std::lock_guard<std::mutex> lock(config_mutex_);
-    config_.cto_config = config;
+    {
+        std::lock_guard<std::mutex> lock(config_mutex_);
+        config_.update([&config](Config& next) { next.cto_config = config; });
+    }
+    scheduler_.notify(UIEEEventScheduler::TRIGGER_CONFIG_CHANGE);
     
     logInfo("CTO配置已应用");
 }
 
 void UIEECoreEngine::bindTaskToCore(int pid, int core_id) {
-    if (!config_.cto_config.enable_cpu_affinity) {
+    int max_bound_cores;
+    {
+        auto config = config_.read();
+        if (!config->cto_config.enable_cpu_affinity) {
+            return;
+        }
+        max_bound_cores = config->cto_config.max_bound_cores;
+    }
+    
+    int cluster_index = cpu_topology_.clusterOfCore(core_id);
+    if (cluster_index < 0) {
+        logError("任务 " + std::to_string(pid) + " 绑定核心 " + std::to_string(core_id) + " 失败: 核心不存在");
         return;
     }
     
-    std::vector<int> cores = {core_id};
-    if (setCPUAffinity(pid, cores)) {
-        logInfo("任务 " + std::to_string(pid) + " 已绑定到核心 " + std::to_string(core_id));
+    // 按核心所在簇选择档位，而不是钉死在单个核心上
+    UIEEPlacementEngine::Tier tier = UIEEPlacementEngine::TIER_INTERACTIVE;
+    switch (cpu_topology_.cluster(cluster_index).type) {
+        case UIEECpuTopology::CLUSTER_PRIME: tier = UIEEPlacementEngine::TIER_PERFORMANCE; break;
+        case UIEECpuTopology::CLUSTER_LITTLE: tier = UIEEPlacementEngine::TIER_BACKGROUND; break;
+        default: break;
+    }
+    
+    auto cpu_sample = system_sampler_.lastCPUSample();
+    UIEEPlacementEngine::Stats stats;
+    bool applied;
+    uint32_t mask;
+    {
+        std::lock_guard<std::mutex> lock(tasks_mutex_);
+        placement_.setMaxBoundCores(max_bound_cores);
+        int index = task_table_.indexOf(pid);
+        uint32_t current = index >= 0 ? task_table_.record(index).applied_mask : 0;
+        auto placement = placement_.decide(tier, cpu_sample, current);
+        mask = placement.cpu_mask;
+        applied = placement_.apply(pid, placement, stats);
+        if (applied && index >= 0) {
+            task_table_.record(index).applied_mask = placement.cpu_mask;
+            task_table_.record(index).placement_tier = tier;
+        }
+    }
+    
+    int failures = stats.permission_denied + stats.other_failures;
+    if (applied && failures == 0) {
+        char mask_text[16];
+        snprintf(mask_text, sizeof(mask_text), "0x%x", mask);
+        logInfo("任务 " + std::to_string(pid) + " 已放置到 " + UIEEPlacementEngine::tierName(tier) +
+                " 档 (掩码 " + mask_text + ", " + std::to_string(stats.threads) + " 个线程)");
     } else {
-        logError("任务 " + std::to_string(pid) + " 绑定核心 " + std::to_string(core_id) + " 失败");
+        logError("任务 " + std::to_string(pid) + " 绑定核心 " + std::to_string(core_id) + " 失败: " +
+                 std::strerror(applied ? (stats.permission_denied > 0 ? EPERM : stats.other_errno) : errno));
     }
 }
 
-void UIEECoreEngine::performScheduling() {
-    if (!config_.optimization_enabled) {
+void UIEECoreEngine::performScheduling(bool periodic) {
+    if (!config_.read()->optimization_enabled) {
         return;
     }
+    UIEE_TRACE_SCOPE(PHASE_SCHEDULING);
+    
+    // 推进博弈，按合作倾向调整后台任务的CPU份额；回合数只随时间推进，不随事件频率变化
+    if (periodic) {
+        simulateGameRound();
+    }
     
     // 更新任务优先级
     updateTaskPriorities();
@@ -449,112 +1158,463 @@ void UIEECoreEngine::performScheduling() {
     // 应用调度策略
     applySchedulingPolicies();
     
-    logInfo("调度执行完成");
+    if (periodic) {
+        logInfo("调度执行完成");
+    }
 }
 
 std::string UIEECoreEngine::getWebUIStatus() {
-    std::ostringstream status;
+    // 只序列化已发布的快照，不做采样
+    std::string status;
+    writeStatusJson(snapshot_.load(), status);
+    return status;
+}
+
+// 以 printf 格式追加到 out 末尾；out 的容量跨调用保留，稳定后不再分配
+static void appendFormat(std::string& out, const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    size_t offset = out.size();
+    size_t room = std::max<size_t>(out.capacity() - offset, 128);
+    out.resize(offset + room);
+    va_list retry;
+    va_copy(retry, args);
+    int n = vsnprintf(&out[offset], room, format, args);
+    if (n >= 0 && static_cast<size_t>(n) >= room) {
+        out.resize(offset + static_cast<size_t>(n) + 1);
+        vsnprintf(&out[offset], static_cast<size_t>(n) + 1, format, retry);
+    }
+    va_end(retry);
+    va_end(args);
+    out.resize(n > 0 ? offset + static_cast<size_t>(n) : offset);
+}
+
+void UIEECoreEngine::writeStatusJson(const EngineSnapshot& snapshot, std::string& out) const {
+    // 单行JSON，可直接作为SSE事件的data
+    char timestamp[26] = "";
+    time_t wall_time = static_cast<time_t>(snapshot.wall_time);
+    struct tm local_time;
+    if (snapshot.sequence != 0 && localtime_r(&wall_time, &local_time) != nullptr) {
+        strftime(timestamp, sizeof(timestamp), "%Y-%m-%d %H:%M:%S", &local_time);
+    }
+    
+    const PerformanceMetrics& metrics = snapshot.metrics;
+    const MetricsWindow& ces = snapshot.ces_window;
+    out.clear();
+    appendFormat(out,
+                 "{\"engine_status\": \"%s\", \"optimization_enabled\": %s, \"current_scene\": %d, \"fps_target\": %d, "
+                 "\"fps\": %.1f, \"frame_time_p99_ms\": %.1f, \"jank_rate\": %.3f, "
+                 "\"gpu_usage\": %.1f, \"gpu_freq_mhz\": %u, \"battery_level\": %.0f, \"power_mw\": %.0f, "
+                 "\"energy_per_frame_mj\": %.2f, "
+                 "\"cpu_pressure\": %.2f, \"memory_pressure\": %.2f, \"io_pressure\": %.2f, "
+                 "\"active_tasks\": %u, \"foreground_tasks\": %u, \"placed_tasks\": %u, "
+                 "\"ces_score\": %g, \"cpu_usage\": %g, \"memory_usage\": %g, \"thermal_state\": %g, "
+                 "\"thermal_predicted\": %.1f, \"zone_temp_c\": {\"cpu\": %.1f, \"gpu\": %.1f, \"skin\": %.1f, "
+                 "\"battery\": %.1f}, "
+                 "\"ces_window\": {\"samples\": %zu, \"min\": %g, \"max\": %g, \"mean\": %g, \"ema\": %g}, "
+                 "\"web_subscribers\": %zu, \"sequence\": %llu, \"timestamp\": \"%s\"}",
+                 running_ ? "running" : "stopped", snapshot.optimization_enabled ? "true" : "false",
+                 snapshot.current_scene, snapshot.fps_target, metrics.fps, metrics.frame_time_p99_ms, metrics.jank_rate,
+                 metrics.gpu_usage, metrics.gpu_freq_mhz, metrics.battery_level, metrics.power_mw,
+                 metrics.energy_per_frame_mj,
+                 metrics.cpu_pressure, metrics.memory_pressure, metrics.io_pressure,
+                 snapshot.active_tasks, snapshot.foreground_tasks, snapshot.placed_tasks,
+                 metrics.ces_score, metrics.cpu_usage, metrics.memory_usage, metrics.thermal_state,
+                 metrics.thermal_predicted, metrics.zone_temp_c[UIEEThermalModel::CATEGORY_CPU],
+                 metrics.zone_temp_c[UIEEThermalModel::CATEGORY_GPU], metrics.zone_temp_c[UIEEThermalModel::CATEGORY_SKIN],
+                 metrics.zone_temp_c[UIEEThermalModel::CATEGORY_BATTERY],
+                 ces.samples, ces.min, ces.max, ces.mean, ces.ema,
+                 web_server_.getSubscriberCount(), static_cast<unsigned long long>(snapshot.sequence), timestamp);
+#ifdef UIEE_ENABLE_TRACING
+    // 去掉结尾的 '}'，追加分阶段耗时
+    out.pop_back();
+    out += ", \"trace\": {";
+    UIEETracer::instance().appendJson(out);
+    out += "}}";
+#endif
+}
+
+void UIEECoreEngine::publishSnapshot(const PerformanceMetrics& metrics) {
+    // 仅主循环线程调用（顺序锁只允许一个写者）；各部分分别加锁，不嵌套
+    EngineSnapshot snapshot{};
+    snapshot.sequence = snapshot_.version() + 1;
+    snapshot.wall_time = static_cast<int64_t>(time(nullptr));
+    snapshot.metrics = metrics;
+    snapshot.ces_window = getMetricsWindow(&PerformanceMetrics::ces_score, 12);
+    snapshot.current_scene = static_cast<int32_t>(current_scene_.load());
+    {
+        auto config = config_.read();
+        snapshot.optimization_enabled = config->optimization_enabled;
+        snapshot.fps_target = snapshot.current_scene < SCENE_UNKNOWN ? config->fps_target[snapshot.current_scene] : 0;
+    }
+    {
+        std::lock_guard<std::mutex> lock(tasks_mutex_);
+        snapshot.active_tasks = static_cast<uint32_t>(task_table_.size());
+        for (const auto& task : task_table_) {
+            snapshot.foreground_tasks += task.isForeground() ? 1 : 0;
+            snapshot.placed_tasks += task.placement_tier != UIEEPlacementEngine::TIER_DEFAULT ? 1 : 0;
+        }
+    }
+    snapshot.evolution_active = evolution_active_;
+    if (snapshot.evolution_active) {
+        std::lock_guard<std::mutex> lock(evolution_mutex_);
+        if (!evolution_history_.empty()) {
+            const EvolutionHistory& current = evolution_history_.back();
+            snapshot.generation = current.generation;
+            snapshot.best_fitness = current.best_fitness;
+            snapshot.average_fitness = current.average_fitness;
+            snapshot.diversity_score = current.diversity_score;
+        }
+    }
+    snapshot_.store(snapshot);
+    
+    // Web UI：进化详情（含变长的参数与博弈者列表）整体换指针，状态JSON由快照直接生成
+    writeEvolutionJson(snapshot, evolution_json_buffer_);
+    std::atomic_store(&web_evolution_json_, std::make_shared<const std::string>(evolution_json_buffer_));
+    if (web_server_.isRunning()) {
+        writeStatusJson(snapshot, status_json_buffer_);
+        web_server_.publish("status", status_json_buffer_);
+        web_server_.publish("evolution", evolution_json_buffer_);
+    }
+}
+
+UIEECoreEngine::PerformanceMetrics UIEECoreEngine::latestMetrics() {
+    EngineSnapshot snapshot = snapshot_.load();
+    if (snapshot.sequence != 0) {
+        return snapshot.metrics;
+    }
+    // 主循环尚未发布（引擎未启动）时才现场采样
+    return getCurrentMetrics();
+}
+
+bool UIEECoreEngine::takeMonitorSample(EngineSnapshot& snapshot) {
+    // 每份快照只送入性能监控器一次，监控与自适应采样共用
+    snapshot = snapshot_.load();
+    if (snapshot.sequence == 0 || snapshot.sequence == monitor_seen_sequence_) {
+        return false;
+    }
+    monitor_seen_sequence_ = snapshot.sequence;
+    performance_monitor_->addSample(snapshot.metrics.cpu_usage, snapshot.metrics.memory_usage);
+    return true;
+}
+
+// 在扁平JSON对象中查找 "key": value，返回去掉引号的原始值（不支持嵌套与转义）
+static bool findJsonValue(const std::string& json, const char* key, std::string& value) {
+    std::string pattern = std::string("\"") + key + "\"";
+    size_t pos = json.find(pattern);
+    if (pos == std::string::npos) {
+        return false;
+    }
+    pos = json.find_first_not_of(" \t\r\n", pos + pattern.size());
+    if (pos == std::string::npos || json[pos] != ':') {
+        return false;
+    }
+    pos = json.find_first_not_of(" \t\r\n", pos + 1);
+    if (pos == std::string::npos) {
+        return false;
+    }
+    if (json[pos] == '"') {
+        size_t close = json.find('"', pos + 1);
+        if (close == std::string::npos) {
+            return false;
+        }
+        value = json.substr(pos + 1, close - pos - 1);
+        return true;
+    }
+    size_t end = json.find_first_of(",} \t\r\n", pos);
+    value = json.substr(pos, end == std::string::npos ? std::string::npos : end - pos);
+    return !value.empty();
+}
+
+bool UIEECoreEngine::updateWebUIConfig(const std::string& json_config) {
+    // 只接受已知的开关和调度间隔，任一字段非法时整体不生效
+    static const struct {
+        const char* key;
+        bool CTOConfig::* field;
+        const char* file_key;                               // 配置文件中的 "节.键"
+    } kCtoSwitches[] = {
+        {"enable_task_binding", &CTOConfig::enable_task_binding, "cto_config.enable_task_binding"},
+        {"enable_cto", &CTOConfig::enable_task_binding, "cto_config.enable_task_binding"},   // Web UI 中的“CTO优化”开关
+        {"enable_io_scheduling", &CTOConfig::enable_io_scheduling, "cto_config.enable_io_scheduling"},
+        {"enable_cpu_affinity", &CTOConfig::enable_cpu_affinity, "cto_config.enable_cpu_affinity"},
+        {"enable_thread_scheduling", &CTOConfig::enable_thread_scheduling, "cto_config.enable_thread_scheduling"},
+    };
+    
+    auto parseBool = [](const std::string& text, bool& out) {
+        if (text == "true" || text == "1") {
+            out = true;
+        } else if (text == "false" || text == "0") {
+            out = false;
+        } else {
+            return false;
+        }
+        return true;
+    };
+    
+    std::string value;
+    int interval = -1;
+    if (findJsonValue(json_config, "scheduling_interval", value)) {
+        char* end = nullptr;
+        long parsed = strtol(value.c_str(), &end, 10);
+        if (end == value.c_str() || *end != '\0' || parsed < 1 || parsed > 3600) {
+            logWarning("Web UI配置无效: scheduling_interval=" + value);
+            return false;
+        }
+        interval = static_cast<int>(parsed);
+    }
     
-    status << "{\n";
-    status << "  \"engine_status\": \"" << (running_ ? "running" : "stopped") << "\",\n";
-    status << "  \"current_scene\": " << static_cast<int>(config_.current_scene) << ",\n";
-    status << "  \"active_tasks\": " << active_tasks_.size() << ",\n";
+    int optimization = -1;
+    if (findJsonValue(json_config, "optimization_enabled", value)) {
+        bool enabled;
+        if (!parseBool(value, enabled)) {
+            logWarning("Web UI配置无效: optimization_enabled=" + value);
+            return false;
+        }
+        optimization = enabled ? 1 : 0;
+    }
+    
+    int switches[sizeof(kCtoSwitches) / sizeof(kCtoSwitches[0])];
+    bool any = interval > 0 || optimization >= 0;
+    for (size_t i = 0; i < sizeof(kCtoSwitches) / sizeof(kCtoSwitches[0]); ++i) {
+        switches[i] = -1;
+        if (findJsonValue(json_config, kCtoSwitches[i].key, value)) {
+            bool enabled;
+            if (!parseBool(value, enabled)) {
+                logWarning(std::string("Web UI配置无效: ") + kCtoSwitches[i].key + "=" + value);
+                return false;
+            }
+            switches[i] = enabled ? 1 : 0;
+            any = true;
+        }
+    }
+    if (!any) {
+        logWarning("Web UI配置中没有可识别的字段");
+        return false;
+    }
     
-    auto metrics = getCurrentMetrics();
-    status << "  \"ces_score\": " << metrics.ces_score << ",\n";
-    status << "  \"cpu_usage\": " << metrics.cpu_usage << ",\n";
-    status << "  \"memory_usage\": " << metrics.memory_usage << ",\n";
-    status << "  \"timestamp\": \"" << getCurrentTimestamp() << "\"\n";
-    status << "}\n";
+    {
+        std::lock_guard<std::mutex> lock(config_mutex_);
+        config_.update([&](Config& next) {
+            if (interval > 0) {
+                next.scheduling_interval = interval;
+            }
+            if (optimization >= 0) {
+                next.optimization_enabled = optimization == 1;
+            }
+            for (size_t i = 0; i < sizeof(kCtoSwitches) / sizeof(kCtoSwitches[0]); ++i) {
+                if (switches[i] >= 0) {
+                    next.cto_config.*kCtoSwitches[i].field = switches[i] == 1;
+                }
+            }
+        });
+        scheduler_.setPeriod(main_timer_, std::chrono::seconds(config_.current().scheduling_interval));
+    }
+    scheduler_.notify(UIEEEventScheduler::TRIGGER_CONFIG_CHANGE);
     
-    return status.str();
+    // 写回配置文件，之后的重新加载（含监控线程对这次写入的响应）不会丢掉 Web UI 的修改
+    std::vector<std::pair<std::string, std::string>> persisted;
+    if (interval > 0) {
+        persisted.emplace_back("system.scheduling_interval", std::to_string(interval));
+    }
+    if (optimization >= 0) {
+        persisted.emplace_back("system.optimization_enabled", optimization == 1 ? "true" : "false");
+    }
+    for (size_t i = 0; i < sizeof(kCtoSwitches) / sizeof(kCtoSwitches[0]); ++i) {
+        if (switches[i] >= 0) {
+            persisted.emplace_back(kCtoSwitches[i].file_key, switches[i] == 1 ? "true" : "false");
+        }
+    }
+    std::string summary;
+    for (const auto& entry : persisted) {
+        summary += " " + entry.first + "=" + entry.second;
+    }
+    logInfo("Web UI配置更新:" + summary);
+    if (!persistConfigValues(persisted)) {
+        logWarning("Web UI配置未能写入配置文件，重新加载配置或重启后失效");
+    }
+    return true;
 }
 
-void UIEECoreEngine::updateWebUIConfig(const std::string& json_config) {
-    // 简单的JSON配置更新
-    // 实际实现中应该使用JSON解析库
-    
-    logInfo("Web UI配置更新: " + json_config);
+std::string UIEECoreEngine::resolveWebRoot() const {
+    std::string web_root = config_.read()->web_root;
+    if (!web_root.empty()) {
+        return web_root;
+    }
+    const char* modpath = getenv("MODPATH");
+    if (modpath) {
+        return std::string(modpath) + "/webroot";
+    }
+    return "webroot";
 }
 
-void UIEECoreEngine::logInfo(const std::string& message) {
-    std::string log_message = "[" + getCurrentTimestamp() + "] [INFO] " + message;
-    std::cout << log_message << std::endl;
+void UIEECoreEngine::registerWebRoutes() {
+    using Request = UIEEHttpServer::Request;
+    using Response = UIEEHttpServer::Response;
     
-    // 动态确定日志路径
-    std::string log_dir = "/data/adb/modules/uiee_smart_engine/logs";
-    if (getenv("MODPATH")) {
-        log_dir = std::string(getenv("MODPATH")) + "/logs";
+    web_server_.setDocumentRoot(resolveWebRoot());
+    web_server_.setEventStreamPath("/api/events");
+    
+    // 接口在Web服务线程中执行，只读取快照或投递配置变更，不做采样
+    web_server_.addRoute("GET", "/api/status", [this](const Request&) {
+        Response response;
+        writeStatusJson(snapshot_.load(), response.body);
+        return response;
+    });
+    web_server_.addRoute("GET", "/api/evolution", [this](const Request&) {
+        Response response;
+        auto json = std::atomic_load(&web_evolution_json_);
+        if (json) {
+            response.body = *json;
+        } else {
+            // 主循环尚未完成第一次发布
+            response.status = 503;
+            response.body = "{\"error\": \"snapshot not ready\"}";
+        }
+        return response;
+    });
+    web_server_.addRoute("POST", "/api/config", [this](const Request& request) {
+        Response response;
+        if (updateWebUIConfig(request.body)) {
+            response.body = "{\"result\": \"ok\"}";
+        } else {
+            response.status = 400;
+            response.body = "{\"error\": \"invalid config\"}";
+        }
+        return response;
+    });
+    web_server_.addRoute("POST", "/api/scene", [this](const Request& request) {
+        Response response;
+        std::string value;
+        char* end = nullptr;
+        long scene = findJsonValue(request.body, "scene", value) ? strtol(value.c_str(), &end, 10) : -1;
+        if (end == nullptr || end == value.c_str() || *end != '\0' || scene < SCENE_GAME || scene > SCENE_UNKNOWN) {
+            response.status = 400;
+            response.body = "{\"error\": \"invalid scene\"}";
+            return response;
+        }
+        setScenePreference(static_cast<SceneType>(scene));
+        response.body = "{\"result\": \"ok\"}";
+        return response;
+    });
+}
+
+bool UIEECoreEngine::createWebToken(std::string& token) {
+    // 每次启动重新生成，只有 root（以及能执行 root 命令的模块管理器）能读取
+    unsigned char random[16];
+    int fd = open("/dev/urandom", O_RDONLY | O_CLOEXEC);
+    bool ok = fd >= 0 && read(fd, random, sizeof(random)) == static_cast<ssize_t>(sizeof(random));
+    if (fd >= 0) {
+        close(fd);
+    }
+    if (!ok) {
+        return false;
+    }
+    static const char kHex[] = "0123456789abcdef";
+    token.clear();
+    for (unsigned char byte : random) {
+        token.push_back(kHex[byte >> 4]);
+        token.push_back(kHex[byte & 0x0f]);
     }
     
-    // 写入日志文件
-    std::string log_file_path = log_dir + "/engine.log";
-    std::ofstream log_file(log_file_path, std::ios::app);
-    if (log_file.is_open()) {
-        log_file << log_message << std::endl;
-        log_file.close();
+    std::string path = resolveDataDirectory() + "/web_ui.token";
+    unlink(path.c_str());
+    fd = open(path.c_str(), O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, 0600);
+    if (fd < 0) {
+        return false;
     }
+    ok = write(fd, token.data(), token.size()) == static_cast<ssize_t>(token.size());
+    close(fd);
+    return ok;
 }
 
-void UIEECoreEngine::logError(const std::string& message) {
-    std::string log_message = "[" + getCurrentTimestamp() + "] [ERROR] " + message;
-    std::cerr << log_message << std::endl;
+bool UIEECoreEngine::startWebServer() {
+    auto config = config_.read();
+    int port = config->web_ui_port;
+    if (port <= 0 || port > 65535) {
+        logError("Web UI端口无效: " + std::to_string(port));
+        return false;
+    }
     
-    // 动态确定日志路径
-    std::string log_dir = "/data/adb/modules/uiee_smart_engine/logs";
-    if (getenv("MODPATH")) {
-        log_dir = std::string(getenv("MODPATH")) + "/logs";
+    if (config->web_ui_require_token) {
+        std::string token;
+        if (!createWebToken(token)) {
+            // 拿不到令牌时不启动服务，写接口不能在无保护的情况下开放
+            logError("无法生成 Web UI 访问令牌: " + resolveDataDirectory() + "/web_ui.token");
+            return false;
+        }
+        web_server_.setAccessToken(token);
     }
     
-    // 写入错误日志文件
-    std::string log_file_path = log_dir + "/error.log";
-    std::ofstream log_file(log_file_path, std::ios::app);
-    if (log_file.is_open()) {
-        log_file << log_message << std::endl;
-        log_file.close();
+    registerWebRoutes();
+    if (!web_server_.start(static_cast<uint16_t>(port), config->web_ui_bind_address)) {
+        logError("Web UI服务启动失败，" + config->web_ui_bind_address + ":" + std::to_string(port) +
+                 ": " + std::string(strerror(errno)));
+        return false;
     }
+    logInfo("Web UI服务已启动: " + config->web_ui_bind_address + ":" + std::to_string(web_server_.port()));
+    return true;
+}
+
+void UIEECoreEngine::logInfo(const std::string& message) {
+    // 只入队，格式化时间戳与写文件由日志线程完成
+    logger_.log(UIEELogger::LEVEL_INFO, message);
+}
+
+void UIEECoreEngine::logError(const std::string& message) {
+    logger_.log(UIEELogger::LEVEL_ERROR, message);
 }
 
 void UIEECoreEngine::logWarning(const std::string& message) {
-    std::string log_message = "[" + getCurrentTimestamp() + "] [WARNING] " + message;
-    std::cerr << log_message << std::endl;
+    logger_.log(UIEELogger::LEVEL_WARNING, message);
+}
 
-    // 动态确定日志路径
-    std::string log_dir = "/data/adb/modules/uiee_smart_engine/logs";
-    if (getenv("MODPATH")) {
-        log_dir = std::string(getenv("MODPATH")) + "/logs";
+void UIEECoreEngine::logPerformance(const PerformanceMetrics& metrics) {
+    if (!logger_.isEnabled(UIEELogger::LEVEL_PERF)) {
+        return;
+    }
+    
+    char buffer[96];
+    int n = std::snprintf(buffer, sizeof(buffer), "CES:%f CPU:%f MEM:%f",
+                          metrics.ces_score, metrics.cpu_usage, metrics.memory_usage);
+    if (n > 0) {
+        size_t length = std::min(static_cast<size_t>(n), sizeof(buffer) - 1);
+        logger_.log(UIEELogger::LEVEL_PERF, std::string_view(buffer, length));
     }
+}
 
-    // 写入警告到 service.log（或 error.log 也可）
-    std::string log_file_path = log_dir + "/service.log";
-    std::ofstream log_file(log_file_path, std::ios::app);
-    if (log_file.is_open()) {
-        log_file << log_message << std::endl;
-        log_file.close();
+std::string UIEECoreEngine::resolveDataDirectory() {
+    const char* modpath = getenv("MODPATH");
+    if (modpath) {
+        return std::string(modpath) + "/data";
     }
+    return "/data/adb/modules/uiee_smart_engine/data";
 }
 
-void UIEECoreEngine::logPerformance(const PerformanceMetrics& metrics) {
-    std::string log_message = "[" + getCurrentTimestamp() + "] [PERF] CES:" + 
-                            std::to_string(metrics.ces_score) + 
-                            " CPU:" + std::to_string(metrics.cpu_usage) +
-                            " MEM:" + std::to_string(metrics.memory_usage);
-    
-    std::cout << log_message << std::endl;
-    
-    // 动态确定日志路径
-    std::string log_dir = "/data/adb/modules/uiee_smart_engine/logs";
-    if (getenv("MODPATH")) {
-        log_dir = std::string(getenv("MODPATH")) + "/logs";
+std::string UIEECoreEngine::resolveLogDirectory() {
+    // 启动时确定一次日志目录
+    const char* modpath = getenv("MODPATH");
+    if (modpath) {
+        return std::string(modpath) + "/logs";
     }
-    
-    // 写入性能日志文件
-    std::string log_file_path = log_dir + "/performance.log";
-    std::ofstream log_file(log_file_path, std::ios::app);
-    if (log_file.is_open()) {
-        log_file << log_message << std::endl;
-        log_file.close();
+    return "/data/adb/modules/uiee_smart_engine/logs";
+}
+
+void UIEECoreEngine::applyLoggingConfig(const Config& config) {
+    UIEELogger::Level level;
+    if (UIEELogger::parseLevel(config.log_level, level)) {
+        logger_.setMinLevel(level);
+    } else {
+        logWarning("未知的日志级别: " + config.log_level + "，保持当前级别");
+    }
+    logger_.setMaxFileSize(config.max_log_size > 0 ?
+                           static_cast<size_t>(config.max_log_size) * 1024 * 1024 : 0);
+    logger_.setPerformanceLogEnabled(config.enable_performance_log);
+    logger_.setErrorLogEnabled(config.enable_error_log);
+#ifdef UIEE_ENABLE_TRACING
+    if (!UIEETracer::instance().setMarkerEnabled(config.enable_trace_marker)) {
+        logWarning("无法打开 trace_marker（需要 root 且内核启用 ftrace），阶段事件不会写入 Perfetto 轨迹");
     }
+#endif
 }
 
 // 私有方法实现
@@ -562,36 +1622,47 @@ void UIEECoreEngine::logPerformance(const PerformanceMetrics& metrics) {
 void UIEECoreEngine::mainLoop() {
     logInfo("主循环启动");
     
+    // 周期截止按毫秒累加，循环体耗时从等待时间中扣除；
+    // 前台变化、温度越档、新进程、PSI 压力触发会立即唤醒，只重新执行调度，性能采样仍按固定周期
+    const uint32_t wake_triggers = UIEEEventScheduler::TRIGGER_FOREGROUND_CHANGE |
+                                   UIEEEventScheduler::TRIGGER_THERMAL |
+                                   UIEEEventScheduler::TRIGGER_NEW_TASK |
+                                   UIEEEventScheduler::TRIGGER_CONFIG_CHANGE |
+                                   UIEEEventScheduler::TRIGGER_PRESSURE;
+    uint32_t reason = UIEEEventScheduler::TRIGGER_TIMER;
+    
     while (running_) {
-        auto start_time = std::chrono::steady_clock::now();
-        
         try {
-            // 执行调度
-            performScheduling();
+            if (reason & UIEEEventScheduler::TRIGGER_TIMER) {
+                // 按任务表推断场景，优先级最低，手动/预设/场景表都放弃时才生效
+                claimScene(SCENE_SOURCE_AUTO_SMART, detectCurrentScene());
+            }
             
-            // 记录性能指标
-            auto metrics = getCurrentMetrics();
-            logPerformance(metrics);
+            // 执行调度（事件唤醒不推进博弈）
+            performScheduling((reason & UIEEEventScheduler::TRIGGER_TIMER) != 0);
             
-            // 添加到历史数据
-            if (performance_history_.size() >= MAX_HISTORY_SIZE) {
-                performance_history_.erase(performance_history_.begin());
+            if (reason & UIEEEventScheduler::TRIGGER_TIMER) {
+                // 记录性能指标
+                auto metrics = getCurrentMetrics();
+                logPerformance(metrics);
+                
+                // 添加到历史数据（写满后覆盖最旧记录）
+                {
+                    std::lock_guard<std::mutex> lock(history_mutex_);
+                    performance_history_.push(metrics);
+                }
+                publishSnapshot(metrics);
+            } else {
+                // 事件唤醒时场景/配置已变，复用最近一次采样的指标重新发布
+                publishSnapshot(snapshot_.load().metrics);
             }
-            performance_history_.push_back(metrics);
             
         } catch (const std::exception& e) {
             logError("主循环异常: " + std::string(e.what()));
         }
         
-        // 等待下次调度
-        auto end_time = std::chrono::steady_clock::now();
-        auto elapsed = std::chrono::duration_cast<std::chrono::seconds>(end_time - start_time);
-        auto sleep_time = std::chrono::seconds(config_.scheduling_interval) - elapsed;
-        
-        if (sleep_time.count() > 0) {
-            std::unique_lock<std::mutex> lock(tasks_mutex_);
-            cv_.wait_for(lock, sleep_time, [this] { return !running_; });
-        }
+        // 等待下次调度或触发事件
+        reason = scheduler_.waitFor(main_timer_, wake_triggers);
     }
     
     logInfo("主循环结束");
@@ -600,62 +1671,222 @@ void UIEECoreEngine::mainLoop() {
 void UIEECoreEngine::monitoringLoop() {
     logInfo("监控循环启动");
     
+    // 优先使用 netlink 进程事件，任务表随 fork/exec/exit 实时增量更新
+    bool event_driven = proc_events_.start(
+        [this](const UIEEProcEventListener::Event* events, size_t count) {
+            handleProcEvents(events, count);
+        });
+    
+    if (event_driven) {
+        logInfo("已启用netlink进程事件监听");
+    } else {
+        logWarning("netlink进程连接器不可用，回退到 /proc 差量扫描");
+    }
+    
+    // 帧时序依赖 dumpsys，非 Android 环境下整体关闭；dumpsys 可能阻塞数秒，由采集器自己的线程执行
+    if (!frame_timing_.start() && config_.read()->enable_frame_timing) {
+        logWarning("未找到 dumpsys，帧时序不可用，响应/流畅分数按负载与温度近似");
+    }
+    
+    // 事件驱动模式下只做低频校正扫描（约每分钟），兜底可能丢失的事件；否则约每5秒扫描
+    const int resync_every = event_driven ? 60 : 5;
+    int tick = 0;
+    
     while (running_) {
         try {
-            // 检测任务变化
-            auto current_pids = getRunningPIDs();
-            
-            // 清理已结束的任务
-            std::lock_guard<std::mutex> lock(tasks_mutex_);
-            active_tasks_.erase(
-                std::remove_if(active_tasks_.begin(), active_tasks_.end(),
-                              [&current_pids](const TaskInfo& task) {
-                                  return std::find(current_pids.begin(), current_pids.end(), task.pid) == current_pids.end();
-                              }),
-                active_tasks_.end()
-            );
-            
-            // 检测新任务
-            for (int pid : current_pids) {
-                bool exists = std::any_of(active_tasks_.begin(), active_tasks_.end(),
-                                         [pid](const TaskInfo& task) { return task.pid == pid; });
-                
-                if (!exists) {
-                    TaskInfo new_task;
-                    new_task.pid = pid;
-                    new_task.name = getProcessName(pid);
-                    new_task.priority = 0;
-                    new_task.app_type = "unknown";
-                    new_task.is_foreground = false;
-                    new_task.start_time = std::chrono::steady_clock::now();
-                    
-                    active_tasks_.push_back(new_task);
-                    logInfo("检测到新任务: " + new_task.name + " (PID: " + std::to_string(pid) + ")");
+            if (tick % resync_every == 0 || proc_resync_requested_.exchange(false)) {
+                resyncTasks();
+                if (config_.read()->enable_auto_discovery) {
+                    std::lock_guard<std::mutex> lock(tasks_mutex_);
+                    // 开机早期 cpuset 可能尚未挂载，找到分组后不再重复扫描
+                    if (!placement_.hasCpusetGroups() && placement_.discover()) {
+                        logInfo("已找到 cpuset 分组，任务放置改为写入分组");
+                    }
                 }
             }
-            
+            pollConfigFile();
+            if (scene_table_reloaded_.exchange(false)) {
+                reclassifyTasks();
+            }
+            checkThermalThreshold();
         } catch (const std::exception& e) {
             logError("监控循环异常: " + std::string(e.what()));
         }
         
-        std::this_thread::sleep_for(std::chrono::seconds(5));
+        tick++;
+        scheduler_.waitFor(monitor_timer_, UIEEEventScheduler::TRIGGER_RESYNC);
     }
     
+    proc_events_.stop();
+    frame_timing_.stop();
     logInfo("监控循环结束");
 }
 
+void UIEECoreEngine::handleProcEvents(const UIEEProcEventListener::Event* events, size_t count) {
+    // 进程名在加锁前读取，持锁期间只做表更新
+    std::vector<std::string> names(count);
+    for (size_t i = 0; i < count; ++i) {
+        switch (events[i].type) {
+            case UIEEProcEventListener::EVENT_FORK:
+            case UIEEProcEventListener::EVENT_EXEC:
+            case UIEEProcEventListener::EVENT_COMM:
+                names[i] = getProcessName(events[i].pid);
+                break;
+            case UIEEProcEventListener::EVENT_OVERFLOW:
+                // 事件已丢失，交给监控循环做一次全量校正
+                proc_resync_requested_ = true;
+                scheduler_.wake(monitor_timer_, UIEEEventScheduler::TRIGGER_RESYNC);
+                break;
+            default:
+                break;
+        }
+    }
+    
+    auto now = std::chrono::steady_clock::now();
+    bool launched = false;
+    {
+        std::lock_guard<std::mutex> lock(tasks_mutex_);
+        
+        for (size_t i = 0; i < count; ++i) {
+            const auto& event = events[i];
+            if (event.type == UIEEProcEventListener::EVENT_OVERFLOW) {
+                continue;
+            }
+            
+            if (event.type == UIEEProcEventListener::EVENT_EXIT) {
+                task_table_.erase(event.pid);
+                placement_.forget(event.pid);
+                thread_roles_.forget(event.pid);
+                continue;
+            }
+            
+            bool inserted = false;
+            uint8_t app_type = classifyProcess(names[i]);
+            int index = task_table_.insert(event.pid, names[i], app_type, 0, false, 0.0f, now, &inserted);
+            if (!inserted && index >= 0) {
+                // exec/改名后更新进程名，应用进程由 zygote fork 后才改写为包名
+                task_table_.rename(index, names[i]);
+                auto& record = task_table_.record(index);
+                record.app_type = app_type;
+                record.flags &= ~UIEETaskTable::FLAG_UID_CHECKED;
+            }
+            // exec 代表新程序启动，fork 出的子进程在 exec 前不值得立即调度
+            launched |= event.type == UIEEProcEventListener::EVENT_EXEC;
+        }
+    }
+    
+    if (launched) {
+        scheduler_.notify(UIEEEventScheduler::TRIGGER_NEW_TASK);
+    }
+}
+
+void UIEECoreEngine::checkThermalThreshold() {
+    // 热状态分数（0-100）按档位划分，越档时立即唤醒调度；回落需低于阈值 kThermalHysteresis 才降档。
+    // 档位取当前与预测热状态中较高者，升温趋势明确时提前进入高档位
+    static const double kThermalLevels[] = {50.0, 70.0, 85.0};
+    constexpr double kThermalHysteresis = 3.0;
+    // 预测热状态达到 kPrimeAvoidOn 时性能档移出超大核，回落到 kPrimeAvoidOff 以下再放开
+    constexpr double kPrimeAvoidOn = 80.0;
+    constexpr double kPrimeAvoidOff = 65.0;
+    
+    // 热模型的输入功率取主循环最近一次发布的采样
+    auto estimate = thermal_model_.update(snapshot_.load().metrics.power_mw / 1000.0);
+    double thermal = estimate.valid ? std::max(estimate.state, estimate.predicted_state) : getThermalState();
+    int level = 0;
+    for (double threshold : kThermalLevels) {
+        bool above = thermal >= threshold ||
+                     (level < thermal_level_ && thermal >= threshold - kThermalHysteresis);
+        if (!above) {
+            break;
+        }
+        level++;
+    }
+    
+    if (level != thermal_level_) {
+        logInfo("热状态档位变化: " + std::to_string(thermal_level_) + " -> " + std::to_string(level) +
+                " (热状态 " + std::to_string(thermal) + ")");
+        thermal_level_ = level;
+        scheduler_.notify(UIEEEventScheduler::TRIGGER_THERMAL);
+    }
+    
+    bool avoid_prime = estimate.valid &&
+                       (estimate.predicted_state >= kPrimeAvoidOn ||
+                        (thermal_avoid_prime_ && estimate.predicted_state >= kPrimeAvoidOff));
+    if (avoid_prime != thermal_avoid_prime_) {
+        thermal_avoid_prime_ = avoid_prime;
+        {
+            std::lock_guard<std::mutex> lock(tasks_mutex_);
+            placement_.setPrimeAvoidance(avoid_prime);
+        }
+        if (avoid_prime) {
+            logInfo("预测 " + std::to_string(UIEEThermalModel::PREDICTION_HORIZON_S) + " 秒后热状态 " +
+                    std::to_string(estimate.predicted_state) + "，性能档移出超大核");
+        } else {
+            logInfo("预测热状态回落，性能档恢复使用超大核");
+        }
+        scheduler_.notify(UIEEEventScheduler::TRIGGER_THERMAL);
+    }
+}
+
+void UIEECoreEngine::resyncTasks() {
+    UIEE_TRACE_SCOPE(PHASE_MONITOR_SCAN);
+    // 当前 /proc PID 集合（已排序）
+    const std::vector<int>& current_pids = pid_rescanner_.rescan();
+    UIEE_TRACE_COUNT(COUNTER_TASKS_SCANNED, current_pids.size());
+    
+    // 任务表PID快照（排序后做有序集合差）
+    std::vector<int> known_pids;
+    {
+        std::lock_guard<std::mutex> lock(tasks_mutex_);
+        task_table_.collectPids(known_pids);
+    }
+    std::sort(known_pids.begin(), known_pids.end());
+    
+    std::vector<int> added, removed;
+    UIEEPidRescanner::diff(known_pids, current_pids, added, removed);
+    
+    if (added.empty() && removed.empty()) {
+        return;
+    }
+    
+    // 只为新增进程读取进程名，且不持有任务锁
+    std::vector<std::string> names;
+    names.reserve(added.size());
+    for (int pid : added) {
+        names.push_back(getProcessName(pid));
+    }
+    
+    auto now = std::chrono::steady_clock::now();
+    std::lock_guard<std::mutex> lock(tasks_mutex_);
+    
+    // 清理已结束的任务
+    for (int pid : removed) {
+        task_table_.erase(pid);
+        placement_.forget(pid);
+        thread_roles_.forget(pid);
+    }
+    
+    // 加入新任务（netlink 可能已在此期间加入同一PID，insert 会忽略）
+    for (size_t i = 0; i < added.size(); ++i) {
+        task_table_.insert(added[i], names[i], classifyProcess(names[i]), 0, false, 0.0f, now);
+    }
+    
+    logInfo("任务表校正: 新增 " + std::to_string(added.size()) +
+            " 个, 移除 " + std::to_string(removed.size()) + " 个");
+}
+
 void UIEECoreEngine::initializeDeviceInfo() {
     // 初始化设备信息
     device_info_.cpu_cores = std::thread::hardware_concurrency();
     
-    // 读取CPU信息
+    // 读取CPU信息：x86 内核输出 "model name"，ARM 内核输出 "Hardware"
     std::ifstream cpuinfo("/proc/cpuinfo");
     if (cpuinfo.is_open()) {
         std::string line;
         while (std::getline(cpuinfo, line)) {
-            if (line.find("model name") != std::string::npos) {
+            if (line.find("model name") == 0 || line.find("Hardware") == 0) {
                 size_t pos = line.find(':');
-                if (pos != std::string::npos) {
+                if (pos != std::string::npos && pos + 2 <= line.size()) {
                     device_info_.soc_model = line.substr(pos + 2);
                     break;
                 }
@@ -663,76 +1894,364 @@ void UIEECoreEngine::initializeDeviceInfo() {
         }
         cpuinfo.close();
     }
+    if (device_info_.soc_model.empty()) {
+        std::ifstream soc_machine("/sys/devices/soc0/machine");
+        if (soc_machine.is_open()) {
+            std::getline(soc_machine, device_info_.soc_model);
+        }
+    }
+    
+    // 扫描cpufreq拓扑，构建小核/大核/超大核簇
+    if (!cpu_topology_.discover(device_info_.cpu_cores)) {
+        logWarning("未能读取cpufreq拓扑，所有核心按同构处理");
+    }
+    if (cpu_topology_.coreCount() > 0) {
+        device_info_.cpu_cores = cpu_topology_.coreCount();
+    }
+    {
+        std::lock_guard<std::mutex> lock(tasks_mutex_);
+        if (placement_.discover()) {
+            logInfo(std::string("已找到 cpuset 分组") + (placement_.hasCpuctlGroups() ? "和 cpuctl 分组" : "") +
+                    "，任务放置优先写入分组");
+        } else {
+            logInfo("cpuset 分组不可用，任务放置按线程设置CPU掩码");
+        }
+    }
+    
+    device_info_.core_frequencies.assign(device_info_.cpu_cores, 0.0);
+    for (int cpu = 0; cpu < device_info_.cpu_cores; ++cpu) {
+        device_info_.core_frequencies[cpu] = cpu_topology_.coreMaxFrequency(cpu) / 1000.0;
+    }
+    device_info_.base_frequency = cpu_topology_.clusterCount() > 0 ?
+        cpu_topology_.cluster(0).max_freq_khz / 1000.0 : 0.0;
+    
+    std::string cluster_info;
+    for (int i = 0; i < cpu_topology_.clusterCount(); ++i) {
+        const auto& cluster = cpu_topology_.cluster(i);
+        cluster_info += std::string(" ") + UIEECpuTopology::clusterTypeName(cluster.type) +
+                        "x" + std::to_string(cluster.core_count) +
+                        "@" + std::to_string(cluster.max_freq_khz / 1000) + "MHz";
+    }
+    
+    logInfo("设备信息初始化完成: " + std::to_string(device_info_.cpu_cores) + " 核心," + cluster_info);
+}
+
+void UIEECoreEngine::fillCoreTelemetry(PerformanceMetrics& metrics, const UIEESystemSampler::CpuSample& sample) {
+    auto& cores = metrics.cores;
+    cores.core_count = std::min(sample.core_count, static_cast<int>(PerformanceMetrics::MAX_CORES));
+    for (int cpu = 0; cpu < cores.core_count; ++cpu) {
+        cores.load[cpu] = static_cast<float>(sample.core_usage[cpu]);
+    }
+    cpu_topology_.sampleFrequencies(cores.freq_khz, PerformanceMetrics::MAX_CORES);
+    
+    // 按簇聚合
+    auto& clusters = metrics.clusters;
+    clusters.cluster_count = std::min(cpu_topology_.clusterCount(), static_cast<int>(PerformanceMetrics::MAX_CLUSTERS));
+    for (int i = 0; i < clusters.cluster_count; ++i) {
+        const auto& cluster = cpu_topology_.cluster(i);
+        double load_sum = 0.0;
+        int online = 0;
+        for (int cpu = 0; cpu < cores.core_count; ++cpu) {
+            if ((cluster.cpu_mask & (1u << cpu)) && sample.core_online[cpu]) {
+                load_sum += cores.load[cpu];
+                online++;
+            }
+        }
+        clusters.load[i] = online > 0 ? static_cast<float>(load_sum / online) : 0.0f;
+        clusters.freq_khz[i] = cores.freq_khz[cluster.first_cpu];
+        clusters.freq_ratio[i] = cluster.max_freq_khz > 0 ?
+            static_cast<float>(clusters.freq_khz[i]) / cluster.max_freq_khz : 0.0f;
+        
+        // 簇功耗：在线核心各自按利用率计入，单核满频功耗按容量平方折算
+        double capacity = cluster.capacity > 0 ? cluster.capacity / 1024.0 : 1.0;
+        double core_max_mw = kPrimeCoreMaxPowerMw * capacity * capacity;
+        clusters.power_mw[i] = static_cast<float>(
+            modelPowerMw(online > 0 ? load_sum / online / 100.0 : 0.0, clusters.freq_ratio[i], core_max_mw) * online);
+    }
+}
+
+double UIEECoreEngine::modelPowerMw(double utilization, double freq_ratio, double max_power_mw) {
+    // 动态功耗 ∝ C·V²·f；高频段电压近似随频率线性上升，低频段电压有下限
+    double ratio = std::max(0.0, std::min(1.0, freq_ratio));
+    double busy = std::max(0.0, std::min(1.0, utilization));
+    return max_power_mw * busy * ratio * (0.3 + 0.7 * ratio * ratio);
+}
+
+void UIEECoreEngine::fillPowerTelemetry(PerformanceMetrics& metrics) {
+    auto gpu = system_sampler_.sampleGPU();
+    auto battery = system_sampler_.sampleBattery();
+    
+    metrics.gpu_usage = gpu.busy;
+    metrics.gpu_freq_mhz = gpu.freq_mhz;
+    metrics.battery_level = battery.level;
+    metrics.battery_power_mw = battery.power_mw;
+    
+    metrics.cpu_power_mw = 0.0;
+    for (int i = 0; i < metrics.clusters.cluster_count; ++i) {
+        metrics.cpu_power_mw += metrics.clusters.power_mw[i];
+    }
+    metrics.gpu_power_mw = gpu.available && gpu.max_freq_mhz > 0 ?
+        modelPowerMw(gpu.busy / 100.0, static_cast<double>(gpu.freq_mhz) / gpu.max_freq_mhz, kGpuMaxPowerMw) : 0.0;
     
-    logInfo("设备信息初始化完成: " + std::to_string(device_info_.cpu_cores) + " 核心");
+    // 实测值包含屏幕与基带，比模型更接近续航；充电时电流反映的是充电而不是负载，只能用模型
+    metrics.power_mw = battery.power_mw > 0.0 ? battery.power_mw : metrics.cpu_power_mw + metrics.gpu_power_mw;
 }
 
 double UIEECoreEngine::calculateCES(const PerformanceMetrics& metrics) {
     // 计算CES综合体验分数
+    auto config = config_.read();
     double ces_score = 
-        config_.responsiveness_weight * metrics.responsiveness_score +
-        config_.fluency_weight * metrics.fluency_score +
-        config_.efficiency_weight * metrics.efficiency_score -
-        config_.thermal_weight * metrics.thermal_state;
+        config->responsiveness_weight * metrics.responsiveness_score +
+        config->fluency_weight * metrics.fluency_score +
+        config->efficiency_weight * metrics.efficiency_score -
+        config->thermal_weight * metrics.thermal_state;
     
     return std::max(0.0, std::min(100.0, ces_score));
 }
 
 void UIEECoreEngine::updateTaskPriorities() {
+    // 根据场景和任务类型更新优先级：场景 -> {匹配该场景的任务, 其他任务}
+    static const int32_t kScenePriority[SCENE_UNKNOWN + 1][2] = {
+        {10, 5},  // SCENE_GAME
+        {8, 3},   // SCENE_SOCIAL
+        {7, 4},   // SCENE_MEDIA
+        {9, 6},   // SCENE_PRODUCTIVITY
+        {5, 5}    // SCENE_UNKNOWN
+    };
+    
+    SceneType scene = current_scene_;
+    const int32_t matched = kScenePriority[scene][0];
+    const int32_t other = kScenePriority[scene][1];
+    
     std::lock_guard<std::mutex> lock(tasks_mutex_);
     
-    for (auto& task : active_tasks_) {
-        // 根据场景和任务类型更新优先级
-        switch (config_.current_scene) {
-            case SCENE_GAME:
-                if (task.app_type == "game") {
-                    task.priority = 10; // 高优先级
-                } else {
-                    task.priority = 5; // 普通优先级
+    for (auto& task : task_table_) {
+        task.priority = (scene != SCENE_UNKNOWN && task.app_type == scene) ? matched : other;
+        // 博弈中倾向合作的后台任务让出一级
+        if (task.game_yield && !task.isForeground()) {
+            task.priority = std::max(0, task.priority - 1);
+        }
+    }
+}
+
+void UIEECoreEngine::applySchedulingPolicies() {
+    UIEE_TRACE_SCOPE(PHASE_POLICY_APPLY);
+    // 使用最近一次采样的每核心负载，不额外触发读取
+    auto cpu_sample = system_sampler_.lastCPUSample();
+    
+    // 策略差量下发：只对目标值变化的任务发起系统调用，失败按tick汇总后记录一次
+    struct PolicyApplyStats {
+        int syscalls = 0;
+        int skipped = 0;
+        int permission_denied = 0;   // EPERM/EACCES（如 system_server）
+        int no_such_process = 0;     // ESRCH（进程已退出）
+        int other_failures = 0;
+        int other_errno = 0;
+    } stats;
+    
+    auto recordFailure = [&stats](int err) {
+        if (err == EPERM || err == EACCES) {
+            stats.permission_denied++;
+        } else if (err == ESRCH) {
+            stats.no_such_process++;
+        } else {
+            stats.other_failures++;
+            stats.other_errno = err;
+        }
+    };
+    
+    // 配置字段在持锁调度前一次取出，本轮调度使用同一版本
+    bool binding_enabled;
+    bool thread_scheduling;
+    bool io_scheduling;
+    bool game_io_idle;
+    int max_bound_cores;
+    {
+        auto config = config_.read();
+        binding_enabled = config->cto_config.enable_task_binding && config->cto_config.enable_cpu_affinity;
+        thread_scheduling = binding_enabled && config->cto_config.enable_thread_scheduling;
+        io_scheduling = config->cto_config.enable_io_scheduling;
+        game_io_idle = config->cto_config.game_io_idle;
+        max_bound_cores = config->cto_config.max_bound_cores;
+    }
+    const SceneType scene = current_scene_;
+    
+    // 最近10秒内收到过 PSI 触发，或 I/O/内存 avg10 超过阈值，视为存在 I/O 与回收压力
+    constexpr double kIoPressureThreshold = 10.0;
+    constexpr double kMemoryPressureThreshold = 10.0;
+    auto pressure = pressure_monitor_.latest();
+    const bool under_pressure =
+        pressure_monitor_.triggeredWithin(std::chrono::seconds(10)) ||
+        pressure.resource[UIEEPressureMonitor::RESOURCE_IO].some_avg10 >= kIoPressureThreshold ||
+        pressure.resource[UIEEPressureMonitor::RESOURCE_MEMORY].some_avg10 >= kMemoryPressureThreshold;
+    UIEEPlacementEngine::Stats placement_stats;
+    std::vector<int> dead_pids;
+    
+    {
+        std::lock_guard<std::mutex> lock(tasks_mutex_);
+        placement_.setMaxBoundCores(max_bound_cores);
+        bool foreground_active = false;
+        int64_t foreground_uid = -1;
+        for (auto& task : task_table_) {
+            if (task.isForeground()) {
+                foreground_active = true;
+                if (io_scheduling && foreground_uid < 0 && isAppTask(task)) {
+                    foreground_uid = task.uid;
                 }
-                break;
-            case SCENE_SOCIAL:
-                if (task.app_type == "social") {
-                    task.priority = 8;
-                } else {
-                    task.priority = 3;
+            }
+        }
+        
+        for (auto& task : task_table_) {
+            auto tier = binding_enabled ? placementTier(task, scene) : UIEEPlacementEngine::TIER_DEFAULT;
+            // 前台进程按线程调度，主线程的 nice 也由线程级调度决定
+            const bool thread_level = thread_scheduling &&
+                                      (tier == UIEEPlacementEngine::TIER_INTERACTIVE ||
+                                       tier == UIEEPlacementEngine::TIER_PERFORMANCE);
+            if (!thread_level && thread_roles_.tracks(task.pid)) {
+                // 离开前台时先撤销线程级调整，随后重新下发进程级 nice
+                thread_roles_.restore(task.pid, task.applied_mask, placement_stats);
+                task.applied_nice = UIEETaskTable::NICE_UNSET;
+            }
+            
+            // 下发失败同样记为已尝试：权限不足时每tick重试只会得到同样的结果
+            int nice_value = priorityToNice(task.priority);
+            if (!thread_level && task.applied_nice != nice_value) {
+                stats.syscalls++;
+                task.applied_nice = static_cast<int8_t>(nice_value);
+                if (!setProcessPriority(task.pid, nice_value)) {
+                    recordFailure(errno);
+                    if (errno == ESRCH) {
+                        dead_pids.push_back(task.pid);
+                        continue;
+                    }
                 }
-                break;
-            case SCENE_MEDIA:
-                if (task.app_type == "media") {
-                    task.priority = 7;
-                } else {
-                    task.priority = 4;
+            } else {
+                stats.skipped++;
+            }
+            
+            // I/O 优先级只在档位变化时下发，关闭 I/O 调度后恢复为内核默认
+            auto io_class = io_scheduling ? ioClassFor(task, scene, foreground_active, foreground_uid,
+                                                       under_pressure, game_io_idle)
+                                          : UIEEPlacementEngine::IO_DEFAULT;
+            if (task.io_class != io_class) {
+                task.io_class = io_class;
+                if (!placement_.setIoClass(task.pid, io_class, placement_stats) && errno == ESRCH) {
+                    dead_pids.push_back(task.pid);
+                    continue;
                 }
-                break;
-            case SCENE_PRODUCTIVITY:
-                if (task.app_type == "productivity") {
-                    task.priority = 9;
-                } else {
-                    task.priority = 6;
+            }
+            
+            // 应用CTO策略：按档位把进程的全部线程放到对应簇/分组上，不再需要时恢复
+            if (tier == UIEEPlacementEngine::TIER_DEFAULT && task.placement_tier == UIEEPlacementEngine::TIER_DEFAULT) {
+                continue;
+            }
+            auto placement = placement_.decide(tier, cpu_sample, task.applied_mask);
+            if (tier == task.placement_tier && placement.cpu_mask == task.applied_mask) {
+                stats.skipped++;
+            } else {
+                task.placement_tier = tier;
+                task.applied_mask = placement.cpu_mask;
+                if (!placement_.apply(task.pid, placement, placement_stats) && errno == ESRCH) {
+                    dead_pids.push_back(task.pid);
+                    continue;
                 }
-                break;
-            default:
-                task.priority = 5;
-                break;
+                // 进程级放置覆盖了各线程的掩码与 uclamp
+                thread_roles_.invalidate(task.pid);
+            }
+            
+            // 关键线程提升、后台线程降级；每tick刷新线程列表，系统调用只在目标变化时发生
+            if (thread_level && !thread_roles_.apply(task.pid, placement, placement_stats) && errno == ESRCH) {
+                dead_pids.push_back(task.pid);
+            }
+        }
+        
+        // 已退出的进程直接移出任务表，不等下一次差量扫描
+        for (int pid : dead_pids) {
+            task_table_.erase(pid);
+            placement_.forget(pid);
+            thread_roles_.forget(pid);
         }
     }
-}
-
-void UIEECoreEngine::applySchedulingPolicies() {
-    std::lock_guard<std::mutex> lock(tasks_mutex_);
     
-    for (const auto& task : active_tasks_) {
-        if (setProcessPriority(task.pid, task.priority)) {
-            // 成功设置优先级
+    stats.syscalls += placement_stats.syscalls;
+    stats.permission_denied += placement_stats.permission_denied;
+    stats.other_failures += placement_stats.other_failures;
+    if (placement_stats.other_failures > 0) {
+        stats.other_errno = placement_stats.other_errno;
+    }
+    
+    int failures = stats.permission_denied + stats.no_such_process + stats.other_failures;
+    UIEE_TRACE_COUNT(COUNTER_POLICY_SYSCALLS, stats.syscalls);
+    UIEE_TRACE_COUNT(COUNTER_POLICY_FAILURES, failures);
+    UIEE_TRACE_COUNT(COUNTER_POLICY_SKIPPED, stats.skipped);
+    if (failures > 0) {
+        std::string message = "调度策略下发 " + std::to_string(stats.syscalls) + " 次，失败 " +
+                              std::to_string(failures) + " 次 (EPERM=" + std::to_string(stats.permission_denied) +
+                              " ESRCH=" + std::to_string(stats.no_such_process) +
+                              " 其他=" + std::to_string(stats.other_failures);
+        if (stats.other_failures > 0) {
+            message += std::string(": ") + std::strerror(stats.other_errno);
         }
-        
-        // 应用CTO策略
-        if (config_.cto_config.enable_task_binding && task.is_foreground) {
-            int core_id = task.priority % device_info_.cpu_cores;
-            bindTaskToCore(task.pid, core_id);
+        message += ")，跳过未变化 " + std::to_string(stats.skipped) + " 项";
+        logWarning(message);
+    }
+}
+
+int UIEECoreEngine::priorityToNice(int priority) {
+    // 将内部优先级（0..19）映射为 nice 值，数值越小优先级越高
+    int clamped = std::max(0, std::min(priority, 19));
+    return 20 - clamped;
+}
+
+UIEEPlacementEngine::IoClass UIEECoreEngine::ioClassFor(UIEETaskTable::TaskRecord& task, SceneType scene,
+                                                       bool foreground_active, int64_t foreground_uid,
+                                                       bool under_pressure, bool game_io_idle) {
+    // 前台应用的 I/O 最先得到服务；有前台应用时后台应用进程降为 best-effort 最低级，仍按比例得到服务。
+    // 空闲类在设备持续繁忙时可能完全得不到服务，持有锁或正在为前台读数据的进程会反过来拖住前台，
+    // 因此只在已出现 I/O/回收压力时使用（game_io_idle 打开时游戏场景也使用）。
+    // 系统进程、与前台应用同 UID 的进程（:remote 服务、下载进程等）与没有前台应用时不干预
+    if (task.isForeground()) {
+        return UIEEPlacementEngine::IO_FOREGROUND;
+    }
+    if (!foreground_active || !isAppTask(task)) {
+        return UIEEPlacementEngine::IO_DEFAULT;
+    }
+    if (foreground_uid >= 0 && task.uid == static_cast<uint64_t>(foreground_uid)) {
+        return UIEEPlacementEngine::IO_DEFAULT;
+    }
+    if (under_pressure || (game_io_idle && scene == SCENE_GAME)) {
+        return UIEEPlacementEngine::IO_IDLE;
+    }
+    return UIEEPlacementEngine::IO_BACKGROUND;
+}
+
+bool UIEECoreEngine::isAppTask(UIEETaskTable::TaskRecord& task) {
+    // /proc/<pid> 的属主即进程的有效 UID；应用 UID 为 用户号×100000 + 应用号（>= 10000），结果缓存到标志位
+    if (!(task.flags & UIEETaskTable::FLAG_UID_CHECKED)) {
+        char path[32];
+        snprintf(path, sizeof(path), "/proc/%d", task.pid);
+        struct stat st;
+        bool app = stat(path, &st) == 0 && st.st_uid % 100000 >= 10000;
+        task.flags |= UIEETaskTable::FLAG_UID_CHECKED;
+        task.uid = app ? static_cast<uint32_t>(st.st_uid) : 0;
+        task.flags = app ? (task.flags | UIEETaskTable::FLAG_APP_UID) : (task.flags & ~UIEETaskTable::FLAG_APP_UID);
+    }
+    return (task.flags & UIEETaskTable::FLAG_APP_UID) != 0;
+}
+
+UIEEPlacementEngine::Tier UIEECoreEngine::placementTier(const UIEETaskTable::TaskRecord& task, SceneType scene) {
+    // 游戏与高优先级前台任务放超大核+大核，其余前台任务放大核；
+    // 游戏场景下博弈中让出CPU的后台任务压到小核，其余任务交给系统调度
+    if (task.isForeground()) {
+        if (task.app_type == SCENE_GAME || task.priority >= 9) {
+            return UIEEPlacementEngine::TIER_PERFORMANCE;
         }
+        return UIEEPlacementEngine::TIER_INTERACTIVE;
+    }
+    if (scene == SCENE_GAME && task.game_yield) {
+        return UIEEPlacementEngine::TIER_BACKGROUND;
     }
+    return UIEEPlacementEngine::TIER_DEFAULT;
 }
 
 std::string UIEECoreEngine::getCurrentTimestamp() {
@@ -748,74 +2267,22 @@ std::string UIEECoreEngine::getCurrentTimestamp() {
 // 系统调用封装
 
 double UIEECoreEngine::getCPUUsage() {
-    // 简化的CPU使用率获取
-    std::ifstream stat("/proc/stat");
-    if (!stat.is_open()) {
-        return 0.0;
-    }
-    
-    std::string line;
-    std::getline(stat, line);
-    stat.close();
-    
-    // 解析CPU使用率（简化版）
-    std::istringstream iss(line);
-    std::string cpu;
-    long user, nice, system, idle;
-    iss >> cpu >> user >> nice >> system >> idle;
-    
-    long total = user + nice + system + idle;
-    long used = total - idle;
-    
-    return total > 0 ? (double)used / total * 100.0 : 0.0;
+    // 距上次采样的增量利用率（常驻fd + pread）
+    return system_sampler_.readCPUUsage();
 }
 
 double UIEECoreEngine::getMemoryUsage() {
-    std::ifstream meminfo("/proc/meminfo");
-    if (!meminfo.is_open()) {
-        return 0.0;
-    }
-    
-    long total_mem = 0, available_mem = 0;
-    std::string line;
-    
-    while (std::getline(meminfo, line)) {
-        if (line.find("MemTotal:") == 0) {
-            std::istringstream iss(line);
-            std::string key;
-            iss >> key >> total_mem;
-        } else if (line.find("MemAvailable:") == 0) {
-            std::istringstream iss(line);
-            std::string key;
-            iss >> key >> available_mem;
-        }
-    }
-    
-    meminfo.close();
-    
-    if (total_mem > 0) {
-        return (double)(total_mem - available_mem) / total_mem * 100.0;
-    }
-    
-    return 0.0;
+    return system_sampler_.readMemoryUsage();
 }
 
 double UIEECoreEngine::getThermalState() {
-    // 读取thermal状态
-    std::ifstream thermal("/sys/class/thermal/thermal_zone0/temp");
-    if (!thermal.is_open()) {
-        return 0.0;
-    }
-    
-    long temp;
-    thermal >> temp;
-    thermal.close();
-    
-    // 转换为摄氏度
-    double temp_celsius = temp / 1000.0;
-    
-    // 转换为0-100的热状态分数
-    return std::max(0.0, std::min(100.0, (temp_celsius - 30.0) / 50.0 * 100.0));
+    auto thermal = currentThermal();
+    return thermal.valid ? thermal.state : system_sampler_.readThermalState();
+}
+
+UIEEThermalModel::Estimate UIEECoreEngine::currentThermal() {
+    // 监控线程每秒更新一次估计；监控循环启动前直接读取当前温度
+    return thermal_model_.hasEstimate() ? thermal_model_.latest() : thermal_model_.sample();
 }
 
 std::vector<int> UIEECoreEngine::getRunningPIDs() {
@@ -869,54 +2336,26 @@ std::string UIEECoreEngine::getProcessName(int pid) {
     return cmdline_content.empty() ? "unknown" : cmdline_content;
 }
 
-bool UIEECoreEngine::setProcessPriority(int pid, int priority) {
-    // 设置进程优先级（尝试使用 setpriority ）
+bool UIEECoreEngine::setProcessPriority(int pid, int nice_value) {
+    // 失败时保留 errno，由调用方汇总记录
 #ifdef __linux__
-    // 将内部优先级映射为 nice 值（-20 .. 19）
-    int clamped = std::max(0, std::min(priority, 19));
-    int nice_val = 20 - clamped; // 映射为较小值表示较高优先级
-
-    if (setpriority(PRIO_PROCESS, pid, nice_val) == 0) {
-        return true;
-    } else {
-        logError(std::string("setpriority 失败: ") + std::strerror(errno));
-        return false;
-    }
+    return setpriority(PRIO_PROCESS, pid, nice_value) == 0;
 #else
-    (void)pid; (void)priority;
+    (void)pid; (void)nice_value;
     // 非Linux平台暂不支持，保持不变
     return false;
 #endif
 }
 
-bool UIEECoreEngine::setCPUAffinity(int pid, const std::vector<int>& cores) {
-#ifdef __linux__
-    cpu_set_t mask;
-    CPU_ZERO(&mask);
-    for (int c : cores) {
-        if (c >= 0 && c < CPU_SETSIZE) CPU_SET(c, &mask);
-    }
-
-    if (sched_setaffinity(pid, sizeof(mask), &mask) == 0) {
-        return true;
-    } else {
-        logError(std::string("sched_setaffinity 失败: ") + std::strerror(errno));
-        return false;
-    }
-#else
-    (void)pid; (void)cores;
-    return false;
-#endif
-}
-
 // ========== Hamilton理论具体实现 ==========
 
 void UIEECoreEngine::initializeHamiltonComponents() {
     // 初始化Hamilton理论组件
     hamilton_fitness_ = std::make_shared<HamiltonFitnessFunction>();
+    syncFitnessCacheTTL();
     population_manager_ = std::make_shared<PopulationEvolutionManager>(evolution_config_.population_size);
-    game_manager_ = std::make_shared<RepeatedPrisonersDilemma>();
-    evolution_manager_ = std::make_shared<LongTermEvolutionManager>();
+    population_manager_->setMemoryResource(evolutionMemoryResource());
+    game_manager_ = std::make_shared<RepeatedPrisonersDilemma>(evolutionMemoryResource());
     
     // 设置适应度函数
     population_manager_->setFitnessFunction(hamilton_fitness_);
@@ -924,14 +2363,8 @@ void UIEECoreEngine::initializeHamiltonComponents() {
     // 初始化种群
     population_manager_->initializePopulation();
     
-    // 添加博弈参与者
-    GamePlayer player1(1);
-    GamePlayer player2(2);
-    GamePlayer player3(3);
-    
-    game_manager_->addPlayer(player1);
-    game_manager_->addPlayer(player2);
-    game_manager_->addPlayer(player3);
+    // 博弈参与者在博弈启动后按任务表同步
+    game_task_version_ = 0;
     
     logInfo("Hamilton理论组件初始化完成");
 }
@@ -939,9 +2372,9 @@ void UIEECoreEngine::initializeHamiltonComponents() {
 void UIEECoreEngine::updateFitnessParameters() {
     // 更新适应度参数
     if (hamilton_fitness_) {
-        hamilton_fitness_->alpha_ = evolution_config_.alpha_weight;
-        hamilton_fitness_->beta_ = evolution_config_.beta_weight;
-        hamilton_fitness_->gamma_ = evolution_config_.gamma_weight;
+        hamilton_fitness_->setWeights(evolution_config_.alpha_weight,
+                                      evolution_config_.beta_weight,
+                                      evolution_config_.gamma_weight);
     }
 }
 
@@ -950,13 +2383,21 @@ double UIEECoreEngine::evaluateIndividualFitness(FitnessIndividual& individual)
         return 0.0;
     }
     
-    PerformanceMetrics metrics = getCurrentMetrics();
+    return evaluateIndividualFitness(individual, latestMetrics());
+}
+
+double UIEECoreEngine::evaluateIndividualFitness(FitnessIndividual& individual, const PerformanceMetrics& metrics) {
+    if (!hamilton_fitness_ || individual.parameters.empty()) {
+        return 0.0;
+    }
+    
     double fitness = hamilton_fitness_->calculateFitness(metrics, individual.parameters);
+    auto components = hamilton_fitness_->calculateComponents(metrics);
     
     individual.fitness_score = fitness;
-    individual.performance_score = hamilton_fitness_->calculatePerformanceComponent(metrics);
-    individual.efficiency_score = hamilton_fitness_->calculateEfficiencyComponent(metrics);
-    individual.energy_cost = hamilton_fitness_->calculateEnergyCost(metrics);
+    individual.performance_score = components.performance;
+    individual.efficiency_score = components.efficiency;
+    individual.energy_cost = components.energy_cost;
     
     return fitness;
 }
@@ -966,12 +2407,15 @@ void UIEECoreEngine::performGeneticOperations() {
         return;
     }
     
-    // 评估种群中所有个体的适应度
-    auto population = population_manager_->getCurrentPopulation();
-    for (auto& individual : population) {
-        if (individual.is_valid) {
-            evaluateIndividualFitness(individual);
-        }
+    // 直接在当前代上评估（不拷贝种群），整代共用一份指标快照，结果写回后再换代
+    auto population = population_manager_->view();
+    PerformanceMetrics metrics = latestMetrics();
+    auto scores = evaluatePopulationFitnessBatch(population, metrics);
+    
+    if (hamilton_fitness_) {
+        auto components = hamilton_fitness_->calculateComponents(metrics);
+        population_manager_->applyFitnessScores(scores, components.performance,
+                                                components.efficiency, components.energy_cost);
     }
     
     // 执行遗传算法操作
@@ -985,40 +2429,42 @@ void UIEECoreEngine::updatePopulationDiversity() {
         return;
     }
     
-    auto population = population_manager_->getCurrentPopulation();
-    double diversity = calculatePopulationDiversity(population);
+    double diversity = calculatePopulationDiversity(population_manager_->view());
     
     logInfo("种群多样性: " + std::to_string(diversity));
 }
 
-double UIEECoreEngine::calculatePopulationDiversity(const std::vector<FitnessIndividual>& population) {
-    if (population.empty()) {
+double UIEECoreEngine::calculatePopulationDiversity(const PopulationEvolutionManager::PopulationView& population) {
+    if (population.empty() || population.dims == 0) {
         return 0.0;
     }
     
-    // 计算参数多样性
-    double total_variance = 0.0;
-    int valid_count = 0;
-    
-    for (size_t param_idx = 0; param_idx < 5; ++param_idx) {
-        double param_sum = 0.0;
-        double param_squared_sum = 0.0;
-        int count = 0;
-        
-        for (const auto& individual : population) {
-            if (individual.is_valid && param_idx < individual.parameters.size()) {
-                double param = individual.parameters[param_idx];
-                param_sum += param;
-                param_squared_sum += param * param;
-                count++;
-            }
-        }
-        
-        if (count > 1) {
-            double mean = param_sum / count;
-            double variance = (param_squared_sum / count) - (mean * mean);
-            total_variance += variance;
+    // 计算参数多样性：按行累加各维的和与平方和，内层是连续的 dims 个元素，可向量化
+    constexpr size_t MAX_DIMS = PopulationEvolutionManager::PARAMETER_COUNT;
+    size_t dims = std::min(population.dims, MAX_DIMS);
+    double param_sum[MAX_DIMS] = {};
+    double param_squared_sum[MAX_DIMS] = {};
+    size_t count = 0;
+    
+    for (size_t i = 0; i < population.size; ++i) {
+        const double* row = population.row(i);
+        double mask = population.valid[i] ? 1.0 : 0.0;
+        for (size_t d = 0; d < dims; ++d) {
+            double param = row[d] * mask;
+            param_sum[d] += param;
+            param_squared_sum[d] += param * param;
         }
+        count += population.valid[i] ? 1 : 0;
+    }
+    
+    if (count <= 1) {
+        return 0.0;
+    }
+    
+    double total_variance = 0.0;
+    for (size_t d = 0; d < dims; ++d) {
+        double mean = param_sum[d] / count;
+        total_variance += (param_squared_sum[d] / count) - (mean * mean);
     }
     
     return total_variance / 5.0; // 平均方差
@@ -1029,33 +2475,74 @@ void UIEECoreEngine::initializeGameComponents() {
         return;
     }
     
-    // 重置博弈
+    // 重置博弈，参与者在下一个调度周期按任务表重新同步
     game_manager_->resetGame();
-    
-    // 重新添加参与者
-    GamePlayer player1(1);
-    GamePlayer player2(2);
-    GamePlayer player3(3);
-    
-    game_manager_->addPlayer(player1);
-    game_manager_->addPlayer(player2);
-    game_manager_->addPlayer(player3);
+    game_task_version_ = 0;
+    syncGamePlayers();
     
     logInfo("博弈组件初始化完成");
 }
 
+void UIEECoreEngine::syncGamePlayers() {
+    // 任务表成员未变化时不重新同步
+    std::vector<int> player_ids;
+    {
+        std::lock_guard<std::mutex> lock(tasks_mutex_);
+        uint64_t version = task_table_.version();
+        if (version == game_task_version_) {
+            return;
+        }
+        game_task_version_ = version;
+        
+        // 参与者上限内优先选择前台任务，其次是优先级高的任务
+        std::vector<std::pair<int, int>> candidates;
+        candidates.reserve(task_table_.size());
+        for (const auto& task : task_table_) {
+            int rank = task.priority + (task.isForeground() ? 100 : 0);
+            candidates.emplace_back(rank, task.pid);
+        }
+        size_t count = std::min(candidates.size(), RepeatedPrisonersDilemma::MAX_PLAYERS);
+        std::partial_sort(candidates.begin(), candidates.begin() + count, candidates.end(),
+                          [](const std::pair<int, int>& a, const std::pair<int, int>& b) { return a.first > b.first; });
+        player_ids.reserve(count);
+        for (size_t i = 0; i < count; ++i) {
+            player_ids.push_back(candidates[i].second);
+        }
+    }
+    
+    game_manager_->syncPlayers(player_ids.data(), player_ids.size());
+}
+
 void UIEECoreEngine::simulateGameRound() {
     if (!game_manager_ || !game_running_) {
         return;
     }
+    UIEE_TRACE_SCOPE(PHASE_GAME_ROUND);
     
-    // 执行一轮博弈
-    game_manager_->simulateRound();
-    
-    // 更新策略
+    // 每个调度周期批量模拟多回合并更新策略
+    syncGamePlayers();
+    game_manager_->simulateRounds(GAME_ROUNDS_PER_TICK);
     game_manager_->updateStrategies();
     
-    logInfo("博弈轮次完成");
+    // 合作的参与者在下一次优先级计算中让出一级CPU份额；
+    // 先在博弈锁内取出合作者的 PID（参与者数有上限，放在栈上），再单独加任务表锁
+    int yielding[RepeatedPrisonersDilemma::MAX_PLAYERS];
+    size_t yield_count = 0;
+    game_manager_->forEachPlayer([&yielding, &yield_count](const GamePlayer& player) {
+        if (player.cooperation_rate >= 0.5 && yield_count < RepeatedPrisonersDilemma::MAX_PLAYERS) {
+            yielding[yield_count++] = player.player_id;
+        }
+    });
+    std::lock_guard<std::mutex> lock(tasks_mutex_);
+    for (auto& task : task_table_) {
+        task.game_yield = 0;
+    }
+    for (size_t i = 0; i < yield_count; ++i) {
+        int index = task_table_.indexOf(yielding[i]);
+        if (index >= 0) {
+            task_table_.record(index).game_yield = 1;
+        }
+    }
 }
 
 void UIEECoreEngine::updatePlayerStrategies() {
@@ -1063,18 +2550,9 @@ void UIEECoreEngine::updatePlayerStrategies() {
         return;
     }
     
-    // 获取所有玩家
-    auto players = game_manager_->getPlayers();
-    
     // 分析合作动态
-    double total_cooperation = 0.0;
-    for (const auto& player : players) {
-        total_cooperation += player.cooperation_rate;
-    }
-    
-    double avg_cooperation = players.empty() ? 0.0 : total_cooperation / players.size();
-    
-    logInfo("平均合作率: " + std::to_string(avg_cooperation));
+    auto summary = game_manager_->getSummary();
+    logInfo("平均合作率: " + std::to_string(summary.average_cooperation));
 }
 
 double UIEECoreEngine::calculatePayoffMatrix() {
@@ -1083,14 +2561,7 @@ double UIEECoreEngine::calculatePayoffMatrix() {
     }
     
     // 简化的收益矩阵计算
-    auto players = game_manager_->getPlayers();
-    double total_payoff = 0.0;
-    
-    for (const auto& player : players) {
-        total_payoff += player.cumulative_payoff;
-    }
-    
-    return players.empty() ? 0.0 : total_payoff / players.size();
+    return game_manager_->getSummary().average_payoff;
 }
 
 void UIEECoreEngine::analyzeCooperationDynamics() {
@@ -1098,17 +2569,14 @@ void UIEECoreEngine::analyzeCooperationDynamics() {
         return;
     }
     
-    auto players = game_manager_->getPlayers();
-    
     // 分析合作模式
-    std::map<GameStrategy, int> strategy_counts;
-    for (const auto& player : players) {
-        strategy_counts[player.current_strategy]++;
-    }
+    auto summary = game_manager_->getSummary();
     
     std::string strategy_info = "策略分布: ";
-    for (const auto& [strategy, count] : strategy_counts) {
-        strategy_info += std::to_string(static_cast<int>(strategy)) + ":" + std::to_string(count) + " ";
+    for (int strategy = STRATEGY_COOPERATE; strategy <= STRATEGY_ADAPTIVE; ++strategy) {
+        if (summary.strategy_counts[strategy] > 0) {
+            strategy_info += std::to_string(strategy) + ":" + std::to_string(summary.strategy_counts[strategy]) + " ";
+        }
     }
     
     logInfo(strategy_info);
@@ -1117,7 +2585,7 @@ void UIEECoreEngine::analyzeCooperationDynamics() {
 void UIEECoreEngine::evolutionMainLoop() {
     logInfo("进化主循环启动");
     
-    while (evolution_active_ && current_generation_ < evolution_config_.max_generations_) {
+    while (evolution_active_ && current_generation_ < evolution_config_.max_generations) {
         try {
             // 执行一代进化
             performGeneticOperations();
@@ -1125,20 +2593,19 @@ void UIEECoreEngine::evolutionMainLoop() {
             
             // 更新进化状态
             updateEvolutionState();
-            
-            // 执行博弈
-            simulateGameRound();
+            if (current_generation_ % CHECKPOINT_EVERY_GENERATIONS == 0) {
+                saveEvolutionSnapshot();
+            }
             
             // 检查收敛
             checkEvolutionConvergence();
             
-            // 等待下一轮
-            std::this_thread::sleep_for(std::chrono::seconds(30));
-            
         } catch (const std::exception& e) {
             logError("进化循环异常: " + std::string(e.what()));
-            std::this_thread::sleep_for(std::chrono::seconds(5));
         }
+        
+        // 等待下一轮，stopLongTermEvolution 会立即唤醒
+        scheduler_.waitFor(evolution_timer_, UIEEEventScheduler::TRIGGER_NONE);
     }
     
     logInfo("进化主循环结束");
@@ -1153,7 +2620,7 @@ void UIEECoreEngine::checkEvolutionConvergence() {
     double recent_best = evolution_history_.back().best_fitness;
     double previous_best = evolution_history_[evolution_history_.size() - 10].best_fitness;
     
-    if (std::abs(recent_best - previous_best) < evolution_config_.convergence_threshold_) {
+    if (std::abs(recent_best - previous_best) < evolution_config_.convergence_threshold) {
         logInfo("进化收敛检测到，停止进化过程");
         evolution_active_ = false;
     }
@@ -1171,19 +2638,23 @@ void UIEECoreEngine::updateEvolutionMetrics() {
             ", 最佳适应度: " + std::to_string(best_individual.fitness_score));
 }
 
+std::string UIEECoreEngine::evolutionCheckpointPath() {
+    return resolveDataDirectory() + "/evolution/checkpoint.bin";
+}
+
 void UIEECoreEngine::saveEvolutionSnapshot() {
-    // 保存当前进化状态的快照
-    std::string snapshot_path = "/data/adb/modules/uiee_smart_engine/data/evolution_snapshot_" + 
-                               std::to_string(current_generation_) + ".dat";
-    
-    logInfo("进化快照已保存: " + snapshot_path);
+    // 保存当前进化状态，覆盖上一份检查点
+    saveEvolutionData(evolutionCheckpointPath());
 }
 
 void UIEECoreEngine::loadEvolutionCheckpoint() {
-    // 加载进化检查点
-    std::string checkpoint_path = "/data/adb/modules/uiee_smart_engine/data/evolution_checkpoint.dat";
-    
-    logInfo("进化检查点已加载: " + checkpoint_path);
+    // 启动时热恢复：没有检查点时从第0代开始
+    std::string checkpoint_path = evolutionCheckpointPath();
+    if (access(checkpoint_path.c_str(), F_OK) != 0) {
+        logInfo("没有进化检查点，进化从第0代开始");
+        return;
+    }
+    checkpoint_restored_ = loadEvolutionData(checkpoint_path);
 }
 
 void UIEECoreEngine::combineTraditionalAndEvolutionary() {
@@ -1197,9 +2668,13 @@ void UIEECoreEngine::combineTraditionalAndEvolutionary() {
     
     // 将进化参数应用到传统算法
     if (best_individual.parameters.size() >= 3) {
-        config_.responsiveness_weight = best_individual.parameters[0];
-        config_.fluency_weight = best_individual.parameters[1];
-        config_.efficiency_weight = best_individual.parameters[2];
+        std::lock_guard<std::mutex> lock(config_mutex_);
+        config_.update([&best_individual](Config& next) {
+            next.responsiveness_weight = best_individual.parameters[0];
+            next.fluency_weight = best_individual.parameters[1];
+            next.efficiency_weight = best_individual.parameters[2];
+        });
+        evolved_weights_active_ = true;
     }
     
     logInfo("传统算法与进化算法结合完成");
@@ -1215,25 +2690,41 @@ void UIEECoreEngine::applyEvolutionaryParameters() {
     
     // 更新配置参数
     if (best_individual.parameters.size() >= 5) {
-        config_.responsiveness_weight = best_individual.parameters[0];
-        config_.fluency_weight = best_individual.parameters[1];
-        config_.efficiency_weight = best_individual.parameters[2];
-        config_.thermal_weight = best_individual.parameters[3];
-        // 场景权重等其他参数
+        std::lock_guard<std::mutex> lock(config_mutex_);
+        config_.update([&best_individual](Config& next) {
+            overlayEvolvedWeights(next, best_individual.parameters);
+        });
+        evolved_weights_active_ = true;
     }
     
     logInfo("进化参数应用完成");
 }
 
+bool UIEECoreEngine::overlayEvolvedWeights(Config& config, const std::vector<double>& parameters) {
+    // 把最佳个体的 CES 权重写入 config；参数不全时不修改
+    if (parameters.size() < 5) {
+        return false;
+    }
+    config.responsiveness_weight = parameters[0];
+    config.fluency_weight = parameters[1];
+    config.efficiency_weight = parameters[2];
+    config.thermal_weight = parameters[3];
+    // 场景权重等其他参数
+    return true;
+}
+
 void UIEECoreEngine::validateSchedulingResult() {
-    // 验证调度结果
-    auto metrics = getCurrentMetrics();
+    // 验证调度结果（读取最近发布的快照）
+    EngineSnapshot snapshot = snapshot_.load();
+    if (snapshot.sequence == 0) {
+        return;
+    }
     
     // 检查CES分数是否改善
-    if (metrics.ces_score < 50.0) {
-        logWarning("调度结果不佳，CES分数: " + std::to_string(metrics.ces_score));
+    if (snapshot.metrics.ces_score < 50.0) {
+        logWarning("调度结果不佳，CES分数: " + std::to_string(snapshot.metrics.ces_score));
     } else {
-        logInfo("调度结果良好，CES分数: " + std::to_string(metrics.ces_score));
+        logInfo("调度结果良好，CES分数: " + std::to_string(snapshot.metrics.ces_score));
     }
 }
 
@@ -1243,20 +2734,10 @@ void UIEECoreEngine::updateEvolutionaryPerformance() {
         return;
     }
     
-    auto population = population_manager_->getCurrentPopulation();
-    double avg_fitness = 0.0;
-    int valid_count = 0;
-    
-    for (const auto& individual : population) {
-        if (individual.is_valid) {
-            avg_fitness += individual.fitness_score;
-            valid_count++;
-        }
-    }
-    
-    if (valid_count > 0) {
-        avg_fitness /= valid_count;
-        logInfo("种群平均适应度: " + std::to_string(avg_fitness));
+    // 调度线程调用，只取加锁汇总，不接触种群缓冲
+    auto summary = population_manager_->getFitnessSummary();
+    if (summary.valid_count > 0) {
+        logInfo("种群平均适应度: " + std::to_string(summary.mean_fitness));
     }
 }
 
@@ -1278,6 +2759,7 @@ void UIEECoreEngine::initializeEvolutionPopulation(size_t population_size) {
     
     evolution_config_.population_size = population_size;
     population_manager_ = std::make_shared<PopulationEvolutionManager>(population_size);
+    population_manager_->setMemoryResource(evolutionMemoryResource());
     population_manager_->setFitnessFunction(hamilton_fitness_);
     population_manager_->initializePopulation();
     
@@ -1353,11 +2835,9 @@ double UIEECoreEngine::getGamePayoff(int player_id) {
         return 0.0;
     }
     
-    auto players = game_manager_->getPlayers();
-    for (const auto& player : players) {
-        if (player.player_id == player_id) {
-            return player.cumulative_payoff;
-        }
+    GamePlayer player;
+    if (game_manager_->getPlayer(player_id, player)) {
+        return player.cumulative_payoff;
     }
     
     return 0.0;
@@ -1368,17 +2848,7 @@ double UIEECoreEngine::getCooperationRate() {
         return 0.0;
     }
     
-    auto players = game_manager_->getPlayers();
-    if (players.empty()) {
-        return 0.0;
-    }
-    
-    double total_cooperation = 0.0;
-    for (const auto& player : players) {
-        total_cooperation += player.cooperation_rate;
-    }
-    
-    return total_cooperation / players.size();
+    return game_manager_->getSummary().average_cooperation;
 }
 
 void UIEECoreEngine::startLongTermEvolution() {
@@ -1387,8 +2857,9 @@ void UIEECoreEngine::startLongTermEvolution() {
         return;
     }
     
+    // 代数从检查点恢复的位置继续
     evolution_active_ = true;
-    current_generation_ = 0;
+    scheduler_.setPeriod(evolution_timer_, kEvolutionPeriod);
     
     // 启动进化线程
     std::thread evolution_thread(&UIEECoreEngine::evolutionMainLoop, this);
@@ -1398,7 +2869,11 @@ void UIEECoreEngine::startLongTermEvolution() {
 }
 
 void UIEECoreEngine::stopLongTermEvolution() {
-    evolution_active_ = false;
+    bool was_active = evolution_active_.exchange(false);
+    scheduler_.wake(evolution_timer_, UIEEEventScheduler::TRIGGER_SHUTDOWN);
+    if (was_active) {
+        saveEvolutionSnapshot();
+    }
     
     logInfo("长期进化过程停止");
 }
@@ -1415,32 +2890,17 @@ void UIEECoreEngine::updateEvolutionState() {
     // 获取当前最佳个体
     auto best_individual = population_manager_->getBestIndividual();
     history.best_fitness = best_individual.fitness_score;
-    history.best_parameters = best_individual.parameters;
+    history.best_parameters.assign(best_individual.parameters.begin(), best_individual.parameters.end());
     
     // 计算平均适应度
-    auto population = population_manager_->getCurrentPopulation();
-    double total_fitness = 0.0;
-    int valid_count = 0;
-    
-    for (const auto& individual : population) {
-        if (individual.is_valid) {
-            total_fitness += individual.fitness_score;
-            valid_count++;
-        }
-    }
-    
-    history.average_fitness = valid_count > 0 ? total_fitness / valid_count : 0.0;
-    history.diversity_score = calculatePopulationDiversity(population);
+    auto summary = population_manager_->getFitnessSummary();
+    history.average_fitness = summary.mean_fitness;
+    history.diversity_score = calculatePopulationDiversity(population_manager_->view());
     history.timestamp = std::chrono::steady_clock::now();
     
     // 添加到历史记录
     std::lock_guard<std::mutex> lock(evolution_mutex_);
-    evolution_history_.push_back(history);
-    
-    // 限制历史记录大小
-    if (evolution_history_.size() > 100) {
-        evolution_history_.erase(evolution_history_.begin());
-    }
+    evolution_history_.push(std::move(history));
 }
 
 std::string UIEECoreEngine::getEvolutionStatus() {
@@ -1448,7 +2908,13 @@ std::string UIEECoreEngine::getEvolutionStatus() {
         return "{\"status\": \"inactive\", \"generation\": 0}";
     }
     
-    auto current_state = getCurrentState();
+    EvolutionHistory current_state{};
+    {
+        std::lock_guard<std::mutex> lock(evolution_mutex_);
+        if (!evolution_history_.empty()) {
+            current_state = evolution_history_.back();
+        }
+    }
     
     std::stringstream ss;
     ss << "{\"status\": \"active\", \"generation\": " << current_state.generation 
@@ -1459,54 +2925,170 @@ std::string UIEECoreEngine::getEvolutionStatus() {
     return ss.str();
 }
 
-void UIEECoreEngine::saveEvolutionData(const std::string& filepath) {
-    std::ofstream file(filepath);
-    if (!file.is_open()) {
-        logError("无法保存进化数据到文件: " + filepath);
-        return;
+// 进化检查点格式（段内记录布局变化时提升版本号）
+static constexpr uint32_t kEvolutionCheckpointVersion = 1;
+static constexpr uint32_t kSectionMeta = uieeCheckpointTag('M', 'E', 'T', 'A');
+static constexpr uint32_t kSectionParameters = uieeCheckpointTag('P', 'P', 'A', 'R');
+static constexpr uint32_t kSectionFitness = uieeCheckpointTag('P', 'F', 'I', 'T');
+static constexpr uint32_t kSectionValid = uieeCheckpointTag('P', 'V', 'A', 'L');
+static constexpr uint32_t kSectionPlayers = uieeCheckpointTag('G', 'P', 'L', 'Y');
+static constexpr uint32_t kSectionHistory = uieeCheckpointTag('H', 'I', 'S', 'T');
+
+struct EvolutionCheckpointMeta {
+    int32_t engine_generation;        // current_generation_
+    int32_t population_generation;
+    uint32_t population_size;
+    uint32_t parameter_count;
+    uint32_t player_record_size;      // sizeof(GamePlayer)，与当前编译结果不一致时不恢复博弈者
+    int32_t game_round;
+    double alpha_weight;
+    double beta_weight;
+    double gamma_weight;
+};
+
+struct EvolutionCheckpointHistory {
+    int32_t generation;
+    uint32_t parameter_count;
+    double best_fitness;
+    double average_fitness;
+    double diversity_score;
+    double age_seconds;               // 保存时距该记录的时间，恢复时换算回 steady_clock
+    double best_parameters[UIEECoreEngine::PopulationEvolutionManager::PARAMETER_COUNT];
+};
+
+bool UIEECoreEngine::saveEvolutionData(const std::string& filepath) {
+    // 多个线程可能同时触发保存（进化线程周期保存、停止时保存），临时文件只能有一个写者
+    std::lock_guard<std::mutex> checkpoint_lock(checkpoint_mutex_);
+    
+    std::vector<double> parameters;
+    std::vector<double> fitness;
+    std::vector<uint8_t> valid;
+    EvolutionCheckpointMeta meta{};
+    meta.engine_generation = current_generation_;
+    meta.parameter_count = PopulationEvolutionManager::PARAMETER_COUNT;
+    meta.player_record_size = sizeof(GamePlayer);
+    meta.alpha_weight = evolution_config_.alpha_weight;
+    meta.beta_weight = evolution_config_.beta_weight;
+    meta.gamma_weight = evolution_config_.gamma_weight;
+    if (population_manager_) {
+        meta.population_generation = population_manager_->copyPopulation(parameters, fitness, valid);
+        meta.population_size = static_cast<uint32_t>(valid.size());
+    }
+    
+    std::vector<GamePlayer> players;
+    if (game_manager_) {
+        players = game_manager_->getPlayers();
+        meta.game_round = game_manager_->getSummary().current_round;
+    }
+    
+    std::vector<EvolutionCheckpointHistory> history;
+    {
+        std::lock_guard<std::mutex> lock(evolution_mutex_);
+        auto now = std::chrono::steady_clock::now();
+        history.reserve(evolution_history_.size());
+        for (const auto& entry : evolution_history_) {
+            EvolutionCheckpointHistory record{};
+            record.generation = entry.generation;
+            record.best_fitness = entry.best_fitness;
+            record.average_fitness = entry.average_fitness;
+            record.diversity_score = entry.diversity_score;
+            record.age_seconds = std::chrono::duration<double>(now - entry.timestamp).count();
+            record.parameter_count = static_cast<uint32_t>(
+                std::min(entry.best_parameters.size(), PopulationEvolutionManager::PARAMETER_COUNT));
+            std::copy(entry.best_parameters.begin(), entry.best_parameters.begin() + record.parameter_count,
+                      record.best_parameters);
+            history.push_back(record);
+        }
     }
     
-    std::lock_guard<std::mutex> lock(evolution_mutex_);
-    
-    file << "generation,best_fitness,average_fitness,diversity_score,timestamp\n";
-    for (const auto& history : evolution_history_) {
-        auto time_t = std::chrono::system_clock::to_time_t(history.timestamp);
-        file << history.generation << "," 
-             << history.best_fitness << "," 
-             << history.average_fitness << "," 
-             << history.diversity_score << "," 
-             << std::ctime(&time_t);
+    UIEECheckpointWriter writer(kEvolutionCheckpointVersion);
+    writer.addArray(kSectionMeta, &meta, 1);
+    writer.addArray(kSectionParameters, parameters.data(), parameters.size());
+    writer.addArray(kSectionFitness, fitness.data(), fitness.size());
+    writer.addArray(kSectionValid, valid.data(), valid.size());
+    writer.addArray(kSectionPlayers, players.data(), players.size());
+    writer.addArray(kSectionHistory, history.data(), history.size());
+    if (!writer.commit(filepath)) {
+        logError("无法保存进化检查点到文件: " + filepath + ": " + std::string(strerror(errno)));
+        return false;
     }
     
-    file.close();
-    logInfo("进化数据已保存到: " + filepath);
+    logInfo("进化检查点已保存到: " + filepath + " (代数 " + std::to_string(meta.engine_generation) +
+            "，个体 " + std::to_string(meta.population_size) + "，博弈者 " + std::to_string(players.size()) + ")");
+    return true;
 }
 
-void UIEECoreEngine::loadEvolutionData(const std::string& filepath) {
-    std::ifstream file(filepath);
-    if (!file.is_open()) {
-        logError("无法加载进化数据文件: " + filepath);
-        return;
+bool UIEECoreEngine::loadEvolutionData(const std::string& filepath) {
+    auto begin = std::chrono::steady_clock::now();
+    UIEECheckpointReader reader;
+    if (!reader.open(filepath, kEvolutionCheckpointVersion)) {
+        logWarning("进化检查点不可用: " + filepath + " (" + reader.failureReason() + ")，进化从第0代开始");
+        return false;
     }
     
-    std::string line;
-    std::getline(file, line); // 跳过标题行
-    
-    std::lock_guard<std::mutex> lock(evolution_mutex_);
-    evolution_history_.clear();
+    size_t count = 0;
+    const EvolutionCheckpointMeta* meta = reader.array<EvolutionCheckpointMeta>(kSectionMeta, count);
+    if (meta == nullptr || count != 1 || meta->parameter_count != PopulationEvolutionManager::PARAMETER_COUNT) {
+        logWarning("进化检查点元数据无效: " + filepath);
+        return false;
+    }
     
-    while (std::getline(file, line)) {
-        std::stringstream ss(line);
-        EvolutionHistory history;
-        
-        ss >> history.generation >> history.best_fitness >> history.average_fitness >> history.diversity_score;
-        history.timestamp = std::chrono::steady_clock::now();
-        
-        evolution_history_.push_back(history);
+    // 种群：三段长度必须与元数据一致
+    size_t parameter_count = 0;
+    size_t fitness_count = 0;
+    size_t valid_count = 0;
+    const double* parameters = reader.array<double>(kSectionParameters, parameter_count);
+    const double* fitness = reader.array<double>(kSectionFitness, fitness_count);
+    const uint8_t* valid = reader.array<uint8_t>(kSectionValid, valid_count);
+    bool population_ok = population_manager_ && meta->population_size > 0 &&
+                         fitness_count == meta->population_size && valid_count == meta->population_size &&
+                         parameter_count == static_cast<size_t>(meta->population_size) * meta->parameter_count &&
+                         population_manager_->restorePopulation(parameters, fitness, valid, meta->population_size,
+                                                                meta->parameter_count, meta->population_generation);
+    if (!population_ok) {
+        logWarning("进化检查点中的种群无效，保留新初始化的种群");
+    }
+    
+    size_t player_count = 0;
+    const GamePlayer* players = reader.array<GamePlayer>(kSectionPlayers, player_count);
+    if (game_manager_ && players != nullptr && meta->player_record_size == sizeof(GamePlayer)) {
+        game_manager_->restorePlayers(players, player_count, meta->game_round);
+    }
+    
+    size_t history_count = 0;
+    const EvolutionCheckpointHistory* history = reader.array<EvolutionCheckpointHistory>(kSectionHistory, history_count);
+    {
+        std::lock_guard<std::mutex> lock(evolution_mutex_);
+        evolution_history_.clear();
+        // 记录时间按检查点保存时刻与本次启动的间隔整体前移
+        auto saved_at = std::chrono::steady_clock::now() -
+                        std::chrono::seconds(std::max<int64_t>(0, static_cast<int64_t>(time(nullptr)) - reader.createdAt()));
+        for (size_t i = 0; i < history_count; ++i) {
+            const EvolutionCheckpointHistory& record = history[i];
+            EvolutionHistory entry;
+            entry.generation = record.generation;
+            entry.best_fitness = record.best_fitness;
+            entry.average_fitness = record.average_fitness;
+            entry.diversity_score = record.diversity_score;
+            entry.timestamp = saved_at - std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                std::chrono::duration<double>(std::max(0.0, record.age_seconds)));
+            size_t dims = std::min<size_t>(record.parameter_count, PopulationEvolutionManager::PARAMETER_COUNT);
+            entry.best_parameters.assign(record.best_parameters, record.best_parameters + dims);
+            evolution_history_.push(std::move(entry));
+        }
     }
     
-    file.close();
-    logInfo("进化数据已从文件加载: " + filepath);
+    current_generation_ = meta->engine_generation;
+    evolution_config_.alpha_weight = meta->alpha_weight;
+    evolution_config_.beta_weight = meta->beta_weight;
+    evolution_config_.gamma_weight = meta->gamma_weight;
+    updateFitnessParameters();
+    
+    auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - begin);
+    logInfo("进化检查点已从文件加载: " + filepath + " (代数 " + std::to_string(current_generation_) +
+            "，历史 " + std::to_string(history_count) + " 条，博弈者 " + std::to_string(player_count) +
+            "，耗时 " + std::to_string(elapsed.count()) + "us)");
+    return population_ok;
 }
 
 void UIEECoreEngine::performIntegratedScheduling() {
@@ -1539,37 +3121,59 @@ UIEECoreEngine::ParetoPoint UIEECoreEngine::findEvolutionaryOptimalPoint() {
     // 获取最佳进化个体
     auto best_individual = population_manager_->getBestIndividual();
     
-    // 转换为帕累托点
+    double thermal_impact = best_individual.energy_cost * 0.5; // 简化计算
+    double objectives[] = {-best_individual.performance_score, best_individual.energy_cost, thermal_impact};
+    
+    SceneWeights scene_weights = getSceneWeights(current_scene_);
+    double weights[] = {scene_weights.performance, scene_weights.power, scene_weights.thermal};
+    
+    // 工况档位：场景 × 预测热状态（<50 / 50-80 / >=80，与选点加权及超大核回避的阈值一致）× 是否放电
+    EngineSnapshot snapshot = snapshot_.load();
+    const PerformanceMetrics& metrics = snapshot.metrics;
+    int thermal_bucket = metrics.thermal_predicted >= 80.0 ? 2 : (metrics.thermal_predicted >= 50.0 ? 1 : 0);
+    int regime = (static_cast<int>(current_scene_.load()) * 3 + thermal_bucket) * 2 + (metrics.battery_power_mw > 0.0 ? 1 : 0);
+    int generation = best_individual.generation;
+    
+    // 当代最佳个体增量并入近期前沿，再按场景权重从前沿中选点
     ParetoPoint point;
-    point.performance = best_individual.performance_score;
-    point.power_consumption = best_individual.energy_cost;
-    point.thermal_impact = best_individual.energy_cost * 0.5; // 简化计算
-    point.parameters = best_individual.parameters;
+    std::lock_guard<std::mutex> lock(frontier_mutex_);
+    if (regime != frontier_regime_ || generation < frontier_generation_) {
+        evolution_frontier_.clear();
+        frontier_regime_ = regime;
+    }
+    frontier_generation_ = generation;
+    evolution_frontier_.evictOlderThan(generation > FRONTIER_MAX_AGE_GENERATIONS ?
+                                       static_cast<uint64_t>(generation - FRONTIER_MAX_AGE_GENERATIONS) : 0);
+    evolution_frontier_.insert(objectives, best_individual.parameters, static_cast<uint64_t>(generation));
+    const auto* selected = evolution_frontier_.selectWeighted(weights);
+    if (selected) {
+        point.performance = -selected->objectives[0];
+        point.power_consumption = selected->objectives[1];
+        point.thermal_impact = selected->objectives[2];
+        point.parameters = selected->payload;
+    }
     
     return point;
 }
 
 UIEECoreEngine::NashEquilibrium UIEECoreEngine::calculateEvolutionaryNashEquilibrium() {
     NashEquilibrium equilibrium;
+    equilibrium.utility_value = 0.0;
+    equilibrium.exploitability = 0.0;
+    equilibrium.iterations = 0;
     
     if (!game_manager_) {
         return equilibrium;
     }
     
     // 基于博弈结果计算纳什均衡
-    auto players = game_manager_->getPlayers();
-    
-    equilibrium.strategies.resize(players.size());
-    for (size_t i = 0; i < players.size(); ++i) {
-        equilibrium.strategies[i] = players[i].cooperation_rate;
-    }
+    equilibrium.strategies.reserve(RepeatedPrisonersDilemma::MAX_PLAYERS);
+    game_manager_->forEachPlayer([&equilibrium](const GamePlayer& player) {
+        equilibrium.strategies.push_back(player.cooperation_rate);
+    });
     
     // 计算效用值
-    double total_payoff = 0.0;
-    for (const auto& player : players) {
-        total_payoff += player.cumulative_payoff;
-    }
-    equilibrium.utility_value = players.empty() ? 0.0 : total_payoff / players.size();
+    equilibrium.utility_value = game_manager_->getSummary().average_payoff;
     
     return equilibrium;
 }
@@ -1584,39 +3188,44 @@ void UIEECoreEngine::logEvolutionaryData(const EvolutionHistory& history) {
 }
 
 std::string UIEECoreEngine::getEvolutionaryWebUIStatus() {
-    auto status = getEvolutionStatus();
+    auto json = std::atomic_load(&web_evolution_json_);
+    if (json) {
+        return *json;
+    }
+    std::string status;
+    writeEvolutionJson(snapshot_.load(), status);
+    return status;
+}
+
+void UIEECoreEngine::writeEvolutionJson(const EngineSnapshot& snapshot, std::string& out) {
     auto best_individual = getBestEvolutionaryStrategy();
-    auto game_players = game_manager_ ? game_manager_->getPlayers() : std::vector<GamePlayer>();
     
-    std::stringstream ss;
-    ss << "{\n";
-    ss << "  \"evolution_status\": " << status << ",\n";
-    ss << "  \"best_individual\": {\n";
-    ss << "    \"fitness_score\": " << best_individual.fitness_score << ",\n";
-    ss << "    \"generation\": " << best_individual.generation << ",\n";
-    ss << "    \"parameters\": [";
-    for (size_t i = 0; i < best_individual.parameters.size(); ++i) {
-        ss << best_individual.parameters[i];
-        if (i < best_individual.parameters.size() - 1) ss << ", ";
-    }
-    ss << "]\n";
-    ss << "  },\n";
-    ss << "  \"game_players\": [\n";
-    for (size_t i = 0; i < game_players.size(); ++i) {
-        ss << "    {\n";
-        ss << "      \"player_id\": " << game_players[i].player_id << ",\n";
-        ss << "      \"strategy\": " << static_cast<int>(game_players[i].current_strategy) << ",\n";
-        ss << "      \"cooperation_rate\": " << game_players[i].cooperation_rate << ",\n";
-        ss << "      \"cumulative_payoff\": " << game_players[i].cumulative_payoff << "\n";
-        ss << "    }";
-        if (i < game_players.size() - 1) ss << ",";
-        ss << "\n";
-    }
-    ss << "  ],\n";
-    ss << "  \"hamilton_theory_enabled\": true\n";
-    ss << "}\n";
+    out.clear();
+    if (snapshot.evolution_active) {
+        appendFormat(out,
+                     "{\"evolution_status\": {\"status\": \"active\", \"generation\": %d, \"best_fitness\": %g, "
+                     "\"average_fitness\": %g, \"diversity_score\": %g}",
+                     snapshot.generation, snapshot.best_fitness, snapshot.average_fitness, snapshot.diversity_score);
+    } else {
+        out += "{\"evolution_status\": {\"status\": \"inactive\", \"generation\": 0}";
+    }
     
-    return ss.str();
+    appendFormat(out, ", \"best_individual\": {\"fitness_score\": %g, \"generation\": %d, \"parameters\": [",
+                 best_individual.fitness_score, best_individual.generation);
+    for (size_t i = 0; i < best_individual.parameters.size(); ++i) {
+        appendFormat(out, i == 0 ? "%g" : ", %g", best_individual.parameters[i]);
+    }
+    out += "]}, \"game_players\": [";
+    if (game_manager_) {
+        bool first = true;
+        game_manager_->forEachPlayer([&out, &first](const GamePlayer& player) {
+            appendFormat(out, "%s{\"player_id\": %d, \"strategy\": %d, \"cooperation_rate\": %g, \"cumulative_payoff\": %g}",
+                         first ? "" : ", ", player.player_id, static_cast<int>(player.current_strategy),
+                         player.cooperation_rate, player.cumulative_payoff);
+            first = false;
+        });
+    }
+    out += "], \"hamilton_theory_enabled\": true}";
 }
 
 // ========== 性能优化实现 ==========
@@ -1626,12 +3235,16 @@ void UIEECoreEngine::initializePerformanceOptimization() {
     performance_monitor_ = std::make_unique<PerformanceMonitor>();
     
     // 初始化线程池
+    // 进化计算是后台工作，工作线程放在小核上，不与前台任务争抢大核
+    thread_pool_.reset();
     if (optimization_config_.enable_thread_pool) {
-        thread_pool_ = std::make_unique<ThreadPoolManager>(optimization_config_.thread_pool_size);
+        uint32_t worker_mask = cpu_topology_.clusterCount() > 1 ?
+            cpu_topology_.clusterMask(UIEECpuTopology::CLUSTER_LITTLE) : 0;
+        thread_pool_ = std::make_unique<ThreadPoolManager>(optimization_config_.thread_pool_size, worker_mask);
     }
     
-    // 初始化内存池
-    if (optimization_config_.enable_memory_pool) {
+    // 初始化内存池（已有内存池保持不变：种群与博弈组件的容器正从中分配）
+    if (optimization_config_.enable_memory_pool && !memory_pool_) {
         memory_pool_ = std::make_unique<MemoryPoolManager>(optimization_config_.memory_pool_block_size);
     }
     
@@ -1643,9 +3256,9 @@ void UIEECoreEngine::updateAdaptiveSampling() {
         return;
     }
     
-    // 获取当前性能指标
-    PerformanceMetrics metrics = getCurrentMetrics();
-    performance_monitor_->addSample(metrics.cpu_usage, metrics.memory_usage);
+    // 监控未启用时由这里把快照送入监控器
+    EngineSnapshot snapshot;
+    takeMonitorSample(snapshot);
     
     // 根据系统负载调整采样频率
     if (performance_monitor_->shouldReduceSampling()) {
@@ -1662,6 +3275,7 @@ void UIEECoreEngine::updateAdaptiveSampling() {
         );
     }
     
+    syncFitnessCacheTTL();
     logInfo("自适应采样间隔调整: " + std::to_string(adaptive_config_.base_sampling_interval) + "秒");
 }
 
@@ -1673,22 +3287,44 @@ void UIEECoreEngine::optimizeMemoryUsage() {
     // 检查内存使用情况
     size_t current_usage = memory_pool_->getTotalAllocated();
     size_t peak_usage = memory_pool_->getPeakUsage();
-    
-    if (current_usage > peak_usage * 0.8) {
-        // 内存使用超过峰值80%，触发清理
-        logInfo("内存使用率较高，执行优化清理");
-        // 这里可以添加具体的内存清理逻辑
+    size_t cached = memory_pool_->getCachedBytes();
+    
+    // 在用量明显回落、池里积压的空闲块超过在用量时，把空闲大块还给系统
+    if (cached > current_usage && current_usage < peak_usage * 0.8) {
+        size_t released = memory_pool_->trim();
+        if (released > 0) {
+            logInfo("内存池释放空闲块 " + std::to_string(released / 1024) + " KB，当前在用 " +
+                    std::to_string(current_usage / 1024) + " KB");
+        }
+        memory_pool_->resetStats();
+    }
+}
+
+std::pmr::memory_resource* UIEECoreEngine::evolutionMemoryResource() {
+    return memory_pool_ ? memory_pool_->resource() : std::pmr::get_default_resource();
+}
+
+void UIEECoreEngine::syncFitnessCacheTTL() {
+    if (!hamilton_fitness_) {
+        return;
     }
+    // 每代间隔一个采样周期，保留3个周期可跨代命中，又不会在条件变化后长期使用旧值
+    auto ttl = std::chrono::duration<double>(getCurrentSamplingInterval() * 3.0);
+    hamilton_fitness_->setCacheTTL(std::chrono::duration_cast<std::chrono::milliseconds>(ttl));
 }
 
 void UIEECoreEngine::monitorPerformance() {
-    if (!optimization_config_.enable_performance_monitoring || !performance_monitor_) {
+    if (!optimization_config_.enable_performance_monitoring || !performance_monitor_ ||
+        !config_.read()->performance_profiling) {
         return;
     }
     
-    // 收集性能数据
-    PerformanceMetrics metrics = getCurrentMetrics();
-    performance_monitor_->addSample(metrics.cpu_usage, metrics.memory_usage);
+    // 读取主循环发布的快照，同一份快照只检测一次
+    EngineSnapshot snapshot;
+    if (!takeMonitorSample(snapshot)) {
+        return;
+    }
+    const PerformanceMetrics& metrics = snapshot.metrics;
     
     // 性能异常检测
     if (metrics.cpu_usage > 90.0 || metrics.memory_usage > 95.0) {
@@ -1735,40 +3371,14 @@ void UIEECoreEngine::performGeneticOperationsOptimized() {
         return;
     }
     
-    // 使用线程池并行处理遗传算法操作
-    auto population = population_manager_->getCurrentPopulation();
-    
-    // 批量评估适应度
-    auto fitness_futures = thread_pool_->submitBatchTasks(
-        [this](const FitnessIndividual& ind) {
-            return evaluateIndividualFitness(const_cast<FitnessIndividual&>(ind));
-        },
-        population
-    );
-    
-    // 等待所有任务完成
-    for (auto& future : fitness_futures) {
-        future.wait();
-    }
-    
-    // 执行进化操作
-    population_manager_->evolveGeneration();
-    
-    logInfo("优化版遗传算法操作完成");
-}
-
-void UIEECoreEngine::simulateGameRoundOptimized() {
-    if (shouldSkipCalculation()) {
-        return; // 跳过计算
-    }
-    
-    simulateGameRound();
+    // 评估经 evaluatePopulationFitnessBatch 分发到线程池，换代在预分配的种群缓冲中完成
+    performGeneticOperations();
 }
 
 void UIEECoreEngine::evolutionMainLoopOptimized() {
     logInfo("优化版进化主循环启动");
     
-    while (evolution_active_ && current_generation_ < evolution_config_.max_generations_) {
+    while (evolution_active_ && current_generation_ < evolution_config_.max_generations) {
         try {
             // 使用优化的方法
             performGeneticOperationsOptimized();
@@ -1776,9 +3386,9 @@ void UIEECoreEngine::evolutionMainLoopOptimized() {
             
             // 更新进化状态
             updateEvolutionState();
-            
-            // 执行博弈（可能跳过）
-            simulateGameRoundOptimized();
+            if (current_generation_ % CHECKPOINT_EVERY_GENERATIONS == 0) {
+                saveEvolutionSnapshot();
+            }
             
             // 性能监控和自适应调整
             monitorPerformance();
@@ -1790,37 +3400,51 @@ void UIEECoreEngine::evolutionMainLoopOptimized() {
             
             // 动态调整等待时间
             double wait_time = getCurrentSamplingInterval();
-            std::this_thread::sleep_for(std::chrono::seconds(static_cast<int>(wait_time)));
+            scheduler_.setPeriod(evolution_timer_,
+                                 std::chrono::milliseconds(static_cast<int64_t>(wait_time * 1000.0)));
             
         } catch (const std::exception& e) {
             logError("优化版进化循环异常: " + std::string(e.what()));
-            std::this_thread::sleep_for(std::chrono::seconds(5));
         }
+        
+        scheduler_.waitFor(evolution_timer_, UIEEEventScheduler::TRIGGER_NONE);
     }
     
     logInfo("优化版进化主循环结束");
 }
 
-std::vector<double> UIEECoreEngine::evaluatePopulationFitnessBatch(const std::vector<FitnessIndividual>& population) {
-    std::vector<double> fitness_scores;
-    fitness_scores.reserve(population.size());
-    
-    if (!optimization_config_.enable_thread_pool || !thread_pool_) {
-        // 串行处理
-        for (const auto& individual : population) {
-            fitness_scores.push_back(evaluateIndividualFitness(const_cast<FitnessIndividual&>(individual)));
-        }
+std::vector<double> UIEECoreEngine::evaluatePopulationFitnessBatch(const PopulationEvolutionManager::PopulationView& population,
+                                                                   const PerformanceMetrics& metrics) {
+    std::vector<double> fitness_scores(population.size, 0.0);
+    if (population.empty() || !hamilton_fitness_) {
+        return fitness_scores;
+    }
+    
+    // 整代共用一份指标快照，参数矩阵连续存放，直接交给批量评估
+    // 按工作线程数均分，块太小时（种群 50 这类）直接串行
+    bool use_pool = optimization_config_.enable_thread_pool && thread_pool_;
+    size_t chunk_size = HamiltonFitnessFunction::parallelChunkSize(
+        population.size, use_pool ? thread_pool_->getThreadCount() : 0);
+    size_t chunks = (population.size + chunk_size - 1) / chunk_size;
+    auto evaluate = [this, &population, &metrics, &fitness_scores, chunk_size](size_t chunk) {
+        size_t begin = chunk * chunk_size;
+        size_t count = std::min(chunk_size, population.size - begin);
+        hamilton_fitness_->calculateFitnessBatch(metrics, population.row(begin), count, population.dims,
+                                                 fitness_scores.data() + begin);
+    };
+    
+    if (chunks > 1 && use_pool) {
+        thread_pool_->parallelFor(0, chunks, evaluate, 1);
     } else {
-        // 并行处理
-        auto futures = thread_pool_->submitBatchTasks(
-            [this](const FitnessIndividual& ind) {
-                return evaluateIndividualFitness(const_cast<FitnessIndividual&>(ind));
-            },
-            population
-        );
-        
-        for (auto& future : futures) {
-            fitness_scores.push_back(future.get());
+        for (size_t chunk = 0; chunk < chunks; ++chunk) {
+            evaluate(chunk);
+        }
+    }
+    
+    // 无效个体不计分
+    for (size_t i = 0; i < population.size; ++i) {
+        if (!population.valid[i]) {
+            fitness_scores[i] = 0.0;
         }
     }
     
@@ -1828,22 +3452,24 @@ std::vector<double> UIEECoreEngine::evaluatePopulationFitnessBatch(const std::ve
 }
 
 void UIEECoreEngine::updatePopulationFitnessBatch(std::vector<FitnessIndividual>& population) {
-    if (population.empty()) {
+    if (population.empty() || !hamilton_fitness_) {
         return;
     }
     
-    auto fitness_scores = evaluatePopulationFitnessBatch(population);
-    
-    for (size_t i = 0; i < population.size() && i < fitness_scores.size(); ++i) {
-        population[i].fitness_score = fitness_scores[i];
-        population[i].update_count++;
-        population[i].last_update_time = std::chrono::steady_clock::now();
+    PerformanceMetrics metrics = latestMetrics();
+    auto now = std::chrono::steady_clock::now();
+    for (auto& individual : population) {
+        if (individual.is_valid && !individual.parameters.empty()) {
+            individual.fitness_score = hamilton_fitness_->calculateFitness(metrics, individual.parameters);
+        }
+        individual.update_count++;
+        individual.last_update_time = now;
     }
 }
 
 void UIEECoreEngine::adaptOptimizationParameters() {
     // 根据设备特性调整优化参数
-    PerformanceMetrics metrics = getCurrentMetrics();
+    PerformanceMetrics metrics = latestMetrics();
     
     // 根据CPU核心数调整线程池大小
     if (optimization_config_.enable_thread_pool && thread_pool_) {
@@ -1866,7 +3492,7 @@ void UIEECoreEngine::adaptOptimizationParameters() {
 
 void UIEECoreEngine::optimizeForDeviceCharacteristics() {
     // 获取设备特性
-    PerformanceMetrics metrics = getCurrentMetrics();
+    PerformanceMetrics metrics = latestMetrics();
     int cpu_cores = std::thread::hardware_concurrency();
     
     // 高性能设备配置
@@ -1937,7 +3563,7 @@ void UIEECoreEngine::disablePerformanceOptimization() {
     logInfo("性能优化已禁用");
 }
 
-PerformanceOptimizationConfig UIEECoreEngine::getOptimizationConfig() const {
+UIEECoreEngine::PerformanceOptimizationConfig UIEECoreEngine::getOptimizationConfig() const {
     return optimization_config_;
 }
 
@@ -1950,6 +3576,10 @@ void UIEECoreEngine::resetPerformanceStats() {
         memory_pool_->resetStats();
     }
     
+#ifdef UIEE_ENABLE_TRACING
+    UIEETracer::instance().reset();
+#endif
+    
     logInfo("性能统计已重置");
 }
 
@@ -1966,10 +3596,18 @@ std::string UIEECoreEngine::getPerformanceReport() const {
     
     if (hamilton_fitness_) {
         auto stats = hamilton_fitness_->getStats();
+        size_t lookups = stats.cache_hits + stats.cache_misses;
         ss << "适应度计算缓存命中率: " << 
-           (stats.total_calculations > 0 ? 
-            std::to_string(100.0 * stats.cache_hits / stats.total_calculations) : "0") << "%\n";
+           (lookups > 0 ? std::to_string(100.0 * stats.cache_hits / lookups) : "0") << "%\n";
+        ss << "适应度缓存 命中/未命中/淘汰: " << stats.cache_hits << "/" << stats.cache_misses
+           << "/" << stats.cache_evictions << "\n";
     }
     
+#ifdef UIEE_ENABLE_TRACING
+    std::string trace;
+    UIEETracer::instance().appendReport(trace);
+    ss << trace;
+#endif
+    
     return ss.str();
 }
\ No newline at end of file
@@ -0,0 +1,98 @@
+#include "uiee_event_scheduler.h"
+#include <algorithm>
+
+int UIEEEventScheduler::addTimer(std::chrono::milliseconds period, std::chrono::milliseconds min_gap) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto now = Clock::now();
+    Timer timer;
+    timer.period = std::max(period, std::chrono::milliseconds(1));
+    timer.min_gap = min_gap;
+    timer.deadline = now + timer.period;
+    timer.last_wake = now - min_gap;
+    timer.pending = TRIGGER_NONE;
+    timers_.push_back(timer);
+    return static_cast<int>(timers_.size() - 1);
+}
+
+void UIEEEventScheduler::setPeriod(int timer_id, std::chrono::milliseconds period) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (timer_id < 0 || static_cast<size_t>(timer_id) >= timers_.size()) {
+            return;
+        }
+        Timer& timer = timers_[timer_id];
+        period = std::max(period, std::chrono::milliseconds(1));
+        if (timer.period == period) {
+            return;
+        }
+        // 以上一次唤醒时刻为基准按新周期重算，缩短周期时可能立即到期
+        timer.deadline = timer.last_wake + period;
+        timer.period = period;
+    }
+    cv_.notify_all();
+}
+
+uint32_t UIEEEventScheduler::waitFor(int timer_id, uint32_t trigger_mask) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (timer_id < 0 || static_cast<size_t>(timer_id) >= timers_.size()) {
+        return TRIGGER_SHUTDOWN;
+    }
+    trigger_mask |= TRIGGER_SHUTDOWN;
+
+    while (true) {
+        // timers_ 只在启动阶段增长，每轮重新取引用
+        Timer& timer = timers_[timer_id];
+        auto now = Clock::now();
+
+        if (timer.pending & TRIGGER_SHUTDOWN) {
+            timer.pending &= ~TRIGGER_SHUTDOWN;
+            return TRIGGER_SHUTDOWN;
+        }
+
+        uint32_t fired = timer.pending & trigger_mask;
+        if (fired != 0 && now >= timer.last_wake + timer.min_gap) {
+            timer.pending &= ~fired;
+            timer.last_wake = now;
+            timer.deadline = now + timer.period;
+            return fired;
+        }
+
+        if (now >= timer.deadline) {
+            // 截止时间按周期累加；落后超过一个周期时从当前时刻重新起算
+            timer.deadline += timer.period;
+            if (timer.deadline <= now) {
+                timer.deadline = now + timer.period;
+            }
+            timer.last_wake = now;
+            return TRIGGER_TIMER;
+        }
+
+        // 有事件但处于合并间隔内时，等到间隔结束
+        auto until = timer.deadline;
+        if (fired != 0) {
+            until = std::min(until, timer.last_wake + timer.min_gap);
+        }
+        cv_.wait_until(lock, until);
+    }
+}
+
+void UIEEEventScheduler::notify(uint32_t triggers) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto& timer : timers_) {
+            timer.pending |= triggers;
+        }
+    }
+    cv_.notify_all();
+}
+
+void UIEEEventScheduler::wake(int timer_id, uint32_t triggers) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (timer_id < 0 || static_cast<size_t>(timer_id) >= timers_.size()) {
+            return;
+        }
+        timers_[timer_id].pending |= triggers;
+    }
+    cv_.notify_all();
+}
@@ -0,0 +1,459 @@
+#include "uiee_frame_timing.h"
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+#ifdef __linux__
+#include <spawn.h>
+extern char** environ;
+#endif
+
+// 前台应用帧时序采集实现
+
+namespace {
+
+const char* const kDumpsys = "/system/bin/dumpsys";
+
+// 两个来源各自保留的历史帧数
+constexpr size_t kSurfaceFlingerHistory = 127;
+constexpr size_t kGfxinfoHistory = 120;
+constexpr size_t kMaxOutputBytes = 1 << 20;
+
+int64_t monotonicNanoseconds() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<int64_t>(ts.tv_sec) * 1000000000LL + ts.tv_nsec;
+}
+
+// 逐行遍历 text，回调收到不含换行的行
+template <typename Callback>
+void forEachLine(const std::string& text, Callback&& callback) {
+    size_t begin = 0;
+    while (begin < text.size()) {
+        size_t end = text.find('\n', begin);
+        if (end == std::string::npos) {
+            end = text.size();
+        }
+        size_t last = end;
+        while (last > begin && (text[last - 1] == '\r' || text[last - 1] == ' ')) {
+            --last;
+        }
+        if (!callback(text.data() + begin, last - begin)) {
+            return;
+        }
+        begin = end + 1;
+    }
+}
+
+bool startsWith(const char* line, size_t length, const char* prefix) {
+    size_t n = strlen(prefix);
+    return length >= n && memcmp(line, prefix, n) == 0;
+}
+
+} // namespace
+
+UIEEFrameTimingCollector::UIEEFrameTimingCollector()
+    : available_(access(kDumpsys, X_OK) == 0), enabled_(true), running_(false), target_changed_(false),
+      layer_index_(0), empty_polls_(0), list_backoff_(0),
+      last_present_ns_(0), refresh_period_ns_(0), source_(SOURCE_NONE) {}
+
+UIEEFrameTimingCollector::~UIEEFrameTimingCollector() {
+    stop();
+}
+
+bool UIEEFrameTimingCollector::start() {
+    if (running_) {
+        return true;
+    }
+    if (!available_) {
+        return false;
+    }
+    running_ = true;
+    thread_ = std::thread(&UIEEFrameTimingCollector::run, this);
+    return true;
+}
+
+void UIEEFrameTimingCollector::stop() {
+    {
+        std::lock_guard<std::mutex> lock(wake_mutex_);
+        if (!running_) {
+            return;
+        }
+        running_ = false;
+    }
+    wake_cv_.notify_all();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+void UIEEFrameTimingCollector::run() {
+    std::unique_lock<std::mutex> lock(wake_mutex_);
+    while (running_) {
+        lock.unlock();
+        if (enabled_) {
+            poll();
+        }
+        lock.lock();
+        wake_cv_.wait_for(lock, std::chrono::milliseconds(POLL_PERIOD_MS), [this] { return !running_; });
+    }
+}
+
+void UIEEFrameTimingCollector::setTarget(const std::string& package) {
+    // 子进程后缀（"com.example:remote"）不影响图层名
+    std::string base = package.substr(0, package.find(':'));
+    std::lock_guard<std::mutex> lock(target_mutex_);
+    if (base != pending_package_) {
+        pending_package_ = base;
+        target_changed_ = true;
+    }
+}
+
+bool UIEEFrameTimingCollector::poll() {
+    {
+        std::lock_guard<std::mutex> lock(target_mutex_);
+        if (target_changed_) {
+            package_ = pending_package_;
+            target_changed_ = false;
+            layers_.clear();
+            layer_index_ = 0;
+            empty_polls_ = 0;
+            list_backoff_ = 0;
+            std::lock_guard<std::mutex> frames_lock(frames_mutex_);
+            presents_.clear();
+            last_present_ns_ = 0;
+            source_ = SOURCE_NONE;
+        }
+    }
+    if (!available_ || package_.empty()) {
+        return false;
+    }
+
+    // 应用没有可见图层（启动中或纯 HWUI 合成到父图层）时隔一段时间再列一次，避免每秒多一次 dumpsys
+    if (layers_.empty() && list_backoff_-- <= 0) {
+        listLayers();
+        list_backoff_ = 10;
+    }
+
+    int64_t refresh_period_ns = 0;
+    if (pollSurfaceFlinger(refresh_period_ns)) {
+        appendBatch(SOURCE_SURFACEFLINGER, kSurfaceFlingerHistory, refresh_period_ns);
+        return true;
+    }
+    Source source;
+    {
+        std::lock_guard<std::mutex> lock(frames_mutex_);
+        source = source_;
+    }
+    // 图层已经出过帧时无帧说明应用静止，不再额外查询 gfxinfo
+    if (source != SOURCE_SURFACEFLINGER && pollGfxinfo()) {
+        appendBatch(SOURCE_GFXINFO, kGfxinfoHistory, refresh_period_ns);
+        return true;
+    }
+    return false;
+}
+
+bool UIEEFrameTimingCollector::runDumpsys(const std::vector<std::string>& args) {
+    output_.clear();
+    // 停止时不再启动新的 dumpsys，一次采集中剩余的查询直接放弃
+    if (!running_) {
+        return false;
+    }
+#ifdef __linux__
+    int pipe_fds[2];
+    if (pipe2(pipe_fds, O_CLOEXEC) != 0) {
+        return false;
+    }
+
+    std::vector<char*> argv;
+    argv.reserve(args.size() + 2);
+    argv.push_back(const_cast<char*>(kDumpsys));
+    for (const auto& arg : args) {
+        argv.push_back(const_cast<char*>(arg.c_str()));
+    }
+    argv.push_back(nullptr);
+
+    // dup2 到标准输出的副本不带 O_CLOEXEC，其余引擎 fd 在 exec 时关闭
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init(&actions);
+    posix_spawn_file_actions_adddup2(&actions, pipe_fds[1], STDOUT_FILENO);
+    posix_spawn_file_actions_addopen(&actions, STDERR_FILENO, "/dev/null", O_WRONLY, 0);
+    pid_t pid;
+    int rc = posix_spawn(&pid, kDumpsys, &actions, nullptr, argv.data(), environ);
+    posix_spawn_file_actions_destroy(&actions);
+    close(pipe_fds[1]);
+    if (rc != 0) {
+        close(pipe_fds[0]);
+        return false;
+    }
+
+    bool timed_out = false;
+    int64_t deadline = monotonicNanoseconds() + COMMAND_TIMEOUT_MS * 1000000LL;
+    char buffer[16384];
+    for (;;) {
+        int remaining_ms = static_cast<int>((deadline - monotonicNanoseconds()) / 1000000LL);
+        if (remaining_ms <= 0) {
+            timed_out = true;
+            break;
+        }
+        struct pollfd pfd = {pipe_fds[0], POLLIN, 0};
+        int ready = ::poll(&pfd, 1, remaining_ms);
+        if (ready < 0 && errno == EINTR) {
+            continue;
+        }
+        if (ready <= 0) {
+            timed_out = ready == 0;
+            break;
+        }
+        ssize_t n = read(pipe_fds[0], buffer, sizeof(buffer));
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            break;
+        }
+        if (output_.size() < kMaxOutputBytes) {
+            output_.append(buffer, static_cast<size_t>(n));
+        }
+    }
+    close(pipe_fds[0]);
+
+    if (timed_out) {
+        kill(pid, SIGKILL);
+    }
+    int status = 0;
+    while (waitpid(pid, &status, 0) < 0 && errno == EINTR) {
+    }
+    return !timed_out && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+#else
+    (void)args;
+    return false;
+#endif
+}
+
+void UIEEFrameTimingCollector::listLayers() {
+    layers_.clear();
+    layer_index_ = 0;
+    empty_polls_ = 0;
+    if (!runDumpsys({"SurfaceFlinger", "--list"})) {
+        return;
+    }
+
+    // SurfaceView（游戏、视频）优先，其次是 Activity 窗口；容器图层（ActivityRecord/Task 等）没有缓冲区
+    std::vector<std::string> windows;
+    forEachLine(output_, [this, &windows](const char* line, size_t length) {
+        std::string_view name(line, length);
+        if (name.find(package_) == std::string_view::npos) {
+            return true;
+        }
+        if (startsWith(line, length, "SurfaceView")) {
+            if (name.find("Background") == std::string_view::npos) {
+                layers_.emplace_back(name);
+            }
+        } else if (name.find(package_ + "/") != std::string_view::npos &&
+                   !startsWith(line, length, "ActivityRecord") && !startsWith(line, length, "Task") &&
+                   !startsWith(line, length, "Splash") && !startsWith(line, length, "Snapshot")) {
+            windows.emplace_back(name);
+        }
+        return true;
+    });
+    layers_.insert(layers_.end(), windows.begin(), windows.end());
+}
+
+bool UIEEFrameTimingCollector::pollSurfaceFlinger(int64_t& refresh_period_ns) {
+    if (layers_.empty()) {
+        return false;
+    }
+
+    // 第一行为刷新周期，其后每行 "期望上屏 实际上屏 就绪" 三个纳秒时间戳；未上屏的帧为 INT64_MAX
+    batch_.clear();
+    if (runDumpsys({"SurfaceFlinger", "--latency", layers_[layer_index_]})) {
+        bool first = true;
+        forEachLine(output_, [this, &first, &refresh_period_ns](const char* line, size_t length) {
+            if (length == 0) {
+                return true;
+            }
+            char* end = nullptr;
+            long long value = strtoll(line, &end, 10);
+            if (first) {
+                refresh_period_ns = value > 0 ? value : 0;
+                first = false;
+                return true;
+            }
+            long long actual = strtoll(end, &end, 10);
+            if (actual > 0 && actual != LLONG_MAX) {
+                batch_.push_back(actual);
+            }
+            return true;
+        });
+    }
+
+    if (!batch_.empty()) {
+        empty_polls_ = 0;
+        return true;
+    }
+
+    // 从未出帧的候选连续几次无帧后换下一个，全部试过后重新列图层
+    Source source;
+    {
+        std::lock_guard<std::mutex> lock(frames_mutex_);
+        source = source_;
+    }
+    if (source != SOURCE_SURFACEFLINGER && ++empty_polls_ >= MAX_EMPTY_POLLS) {
+        empty_polls_ = 0;
+        if (++layer_index_ >= layers_.size()) {
+            layers_.clear();
+            layer_index_ = 0;
+        }
+    }
+    return false;
+}
+
+bool UIEEFrameTimingCollector::pollGfxinfo() {
+    batch_.clear();
+    if (!runDumpsys({"gfxinfo", package_, "framestats"})) {
+        return false;
+    }
+
+    // 每个窗口一段 ---PROFILEDATA--- 包围的 CSV，首行为列名（各版本列不同，按名字定位）
+    bool in_block = false;
+    bool header = false;
+    int flags_column = -1;
+    int completed_column = -1;
+    forEachLine(output_, [&](const char* line, size_t length) {
+        if (startsWith(line, length, "---PROFILEDATA---")) {
+            in_block = !in_block;
+            header = in_block;
+            return true;
+        }
+        if (!in_block || length == 0) {
+            return true;
+        }
+        int column = 0;
+        long long flags = -1;
+        long long completed = 0;
+        const char* p = line;
+        const char* end = line + length;
+        while (p < end) {
+            const char* comma = static_cast<const char*>(memchr(p, ',', static_cast<size_t>(end - p)));
+            const char* field_end = comma ? comma : end;
+            if (header) {
+                std::string_view name(p, static_cast<size_t>(field_end - p));
+                if (name == "Flags") {
+                    flags_column = column;
+                } else if (name == "FrameCompleted") {
+                    completed_column = column;
+                }
+            } else if (column == flags_column) {
+                flags = strtoll(p, nullptr, 10);
+            } else if (column == completed_column) {
+                completed = strtoll(p, nullptr, 10);
+            }
+            ++column;
+            p = field_end + 1;
+        }
+        // Flags 非 0 的是首帧、窗口变化等非常规帧
+        if (!header && flags == 0 && completed > 0) {
+            batch_.push_back(completed);
+        }
+        header = false;
+        return true;
+    });
+    return !batch_.empty();
+}
+
+void UIEEFrameTimingCollector::appendBatch(Source source, size_t source_capacity, int64_t refresh_period_ns) {
+    std::sort(batch_.begin(), batch_.end());
+
+    std::lock_guard<std::mutex> lock(frames_mutex_);
+    if (source != source_) {
+        // 两种来源的时间点含义不同（上屏 / 绘制完成），不混在同一窗口里
+        presents_.clear();
+        last_present_ns_ = 0;
+        source_ = source;
+    }
+    if (refresh_period_ns > 0) {
+        refresh_period_ns_ = refresh_period_ns;
+    }
+
+    auto first_new = std::upper_bound(batch_.begin(), batch_.end(), last_present_ns_);
+    if (first_new == batch_.end()) {
+        return;
+    }
+    // 来源的历史已满且与上次取到的帧没有重叠：中间可能有帧被挤掉
+    if (last_present_ns_ != 0 && first_new == batch_.begin() && batch_.size() >= source_capacity * 9 / 10) {
+        presents_.push(DISCONTINUITY);
+    }
+    for (auto it = first_new; it != batch_.end(); ++it) {
+        presents_.push(*it);
+    }
+    last_present_ns_ = batch_.back();
+}
+
+UIEEFrameTimingCollector::FrameStats UIEEFrameTimingCollector::stats(double target_fps) const {
+    FrameStats result{};
+    int64_t now = monotonicNanoseconds();
+    int64_t window_start = now - WINDOW_MS * 1000000LL;
+
+    std::vector<int64_t> intervals;
+    int64_t busy_ns = 0;
+    int64_t target_ns;
+    {
+        std::lock_guard<std::mutex> lock(frames_mutex_);
+        result.source = source_;
+        result.refresh_period_ms = refresh_period_ns_ / 1e6;
+        target_ns = target_fps > 0 ? static_cast<int64_t>(1e9 / target_fps) :
+                    (refresh_period_ns_ > 0 ? refresh_period_ns_ : 1000000000LL / 60);
+
+        intervals.reserve(presents_.size());
+        int64_t previous = DISCONTINUITY;
+        for (size_t i = 0; i < presents_.size(); ++i) {
+            int64_t present = presents_[i];
+            if (present != DISCONTINUITY && present >= window_start && previous != DISCONTINUITY) {
+                int64_t interval = present - previous;
+                if (interval > 0 && interval <= IDLE_GAP_MS * 1000000LL) {
+                    intervals.push_back(interval);
+                    busy_ns += interval;
+                    // 留半个周期容差，稳定运行在目标帧率整数分之一（如 60 目标下的 30fps）不算卡顿
+                    result.jank_count += interval > 2 * target_ns + target_ns / 2 ? 1 : 0;
+                    result.big_jank_count += interval > 4 * target_ns + target_ns / 2 ? 1 : 0;
+                }
+            }
+            previous = present;
+        }
+    }
+
+    result.frames = static_cast<uint32_t>(intervals.size());
+    result.valid = result.frames >= MIN_FRAMES && busy_ns > 0;
+    if (!result.valid) {
+        return result;
+    }
+    result.fps = result.frames * 1e9 / busy_ns;
+    result.jank_rate = static_cast<double>(result.jank_count) / result.frames;
+
+    std::sort(intervals.begin(), intervals.end());
+    auto percentile = [&intervals](double fraction) {
+        size_t rank = static_cast<size_t>(fraction * intervals.size() + 0.999999);
+        return intervals[std::min(intervals.size(), std::max<size_t>(rank, 1)) - 1] / 1e6;
+    };
+    result.frame_time_p50_ms = percentile(0.50);
+    result.frame_time_p90_ms = percentile(0.90);
+    result.frame_time_p99_ms = percentile(0.99);
+    return result;
+}
+
+const char* UIEEFrameTimingCollector::sourceName(Source source) {
+    switch (source) {
+        case SOURCE_SURFACEFLINGER: return "surfaceflinger";
+        case SOURCE_GFXINFO: return "gfxinfo";
+        default: return "none";
+    }
+}
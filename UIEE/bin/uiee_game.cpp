@@ -0,0 +1,280 @@
+#include "uiee_engine.h"
+
+// 连续囚徒困境实现
+// 参与者数组与批处理缓冲从构造时传入的内存资源分配（通常是引擎内存池）。
+// 每个参与者只保存最近 MAX_HISTORY_ROUNDS 回合的行动位图和收益累计量，
+// 回合记录、合作率计算都是 O(1)，长期运行内存占用不随回合数增长。
+// simulateRounds 在一次加锁内完成多回合：策略在批开始时展开成数组，
+// 每对参与者的行动由查表得到，收益查 2×2 行动收益表，回合内不做日志和动态分派。
+// 自适应策略逐对执行 win-stay lose-shift：上回合双方行动相同（都合作或都背叛）则合作，否则背叛。
+// 单回合期望收益比较在 T > R、P > S 时总是选背叛，不适合连续博弈；按对局结果调整的策略
+// 对合作者维持合作、对背叛者随之背叛，并能从一次误判中恢复互相合作。
+
+namespace {
+
+constexpr uint32_t kGenerousForgiveThreshold = 0xffffffffu / 3;   // 宽容策略以 1/3 概率原谅背叛
+constexpr double kRecentPayoffAlpha = 2.0 / (UIEECoreEngine::GameActionHistory::WINDOW + 1);
+
+// [策略][自己上回合是否合作][对手上回合是否合作] -> 是否合作；宽容策略在此基础上按概率原谅
+constexpr uint8_t kResponse[UIEECoreEngine::RepeatedPrisonersDilemma::STRATEGY_COUNT][2][2] = {
+    {{1, 1}, {1, 1}},   // STRATEGY_COOPERATE
+    {{0, 0}, {0, 0}},   // STRATEGY_DEFECT
+    {{0, 1}, {0, 1}},   // STRATEGY_TIT_FOR_TAT
+    {{0, 1}, {0, 1}},   // STRATEGY_GENEROUS
+    {{1, 0}, {0, 1}}    // STRATEGY_ADAPTIVE：win-stay lose-shift
+};
+
+} // namespace
+
+UIEECoreEngine::RepeatedPrisonersDilemma::RepeatedPrisonersDilemma(std::pmr::memory_resource* resource)
+    : players_(resource ? resource : std::pmr::get_default_resource()),
+      pair_last_(players_.get_allocator()),
+      strategies_(players_.get_allocator()),
+      round_cooperations_(players_.get_allocator()),
+      round_payoffs_(players_.get_allocator()),
+      rng_(std::random_device{}()),
+      current_round_(0),
+      cooperation_reward_(3.0),    // R：双方合作
+      defection_reward_(0.0),      // S：合作却被背叛
+      mutual_punishment_(1.0),     // P：双方背叛
+      temptation_(5.0) {           // T：背叛合作者
+    rebuildPayoffTables();
+}
+
+void UIEECoreEngine::RepeatedPrisonersDilemma::rebuildPayoffTables() {
+    action_payoff_[1][1] = cooperation_reward_;
+    action_payoff_[1][0] = defection_reward_;
+    action_payoff_[0][1] = temptation_;
+    action_payoff_[0][0] = mutual_punishment_;
+
+    // 纯策略对局的单回合收益：合作类策略（合作/以牙还牙/宽容/自适应）首回合都选择合作
+    for (size_t a = 0; a < STRATEGY_COUNT; ++a) {
+        for (size_t b = 0; b < STRATEGY_COUNT; ++b) {
+            bool cooperate1 = a != STRATEGY_DEFECT;
+            bool cooperate2 = b != STRATEGY_DEFECT;
+            strategy_payoff_[a][b] = action_payoff_[cooperate1][cooperate2];
+        }
+    }
+}
+
+void UIEECoreEngine::RepeatedPrisonersDilemma::resetPairState(const std::vector<int>& previous_ids) {
+    // 保留存活参与者之间的上一次行动，新参与者与任何人的初始状态为合作
+    size_t n = players_.size();
+    size_t previous = previous_ids.size();
+    std::vector<int> old_index(n, -1);
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t k = 0; k < previous; ++k) {
+            if (previous_ids[k] == players_[i].player_id) {
+                old_index[i] = static_cast<int>(k);
+                break;
+            }
+        }
+    }
+
+    std::pmr::vector<uint8_t> pair_last(n * n, 1, pair_last_.get_allocator());
+    if (pair_last_.size() == previous * previous) {
+        for (size_t i = 0; i < n; ++i) {
+            for (size_t j = 0; j < n; ++j) {
+                if (old_index[i] >= 0 && old_index[j] >= 0) {
+                    pair_last[i * n + j] = pair_last_[old_index[i] * previous + old_index[j]];
+                }
+            }
+        }
+    }
+    pair_last_ = std::move(pair_last);
+
+    strategies_.resize(n);
+    round_cooperations_.resize(n);
+    round_payoffs_.resize(n);
+}
+
+void UIEECoreEngine::RepeatedPrisonersDilemma::addPlayer(const GamePlayer& player) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<int> previous_ids;
+    previous_ids.reserve(players_.size());
+    for (const auto& existing : players_) {
+        previous_ids.push_back(existing.player_id);
+    }
+    players_.push_back(player);
+    resetPairState(previous_ids);
+}
+
+void UIEECoreEngine::RepeatedPrisonersDilemma::syncPlayers(const int* player_ids, size_t count) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    count = std::min(count, MAX_PLAYERS);
+
+    std::vector<int> previous_ids;
+    previous_ids.reserve(players_.size());
+    for (const auto& player : players_) {
+        previous_ids.push_back(player.player_id);
+    }
+
+    std::pmr::vector<GamePlayer> players(players_.get_allocator());
+    players.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        int id = player_ids[i];
+        auto it = std::find_if(players_.begin(), players_.end(),
+                               [id](const GamePlayer& player) { return player.player_id == id; });
+        if (it != players_.end()) {
+            players.push_back(*it);
+        } else {
+            // 初始策略按 PID 分散，保证策略种群的多样性
+            GamePlayer player(id);
+            player.current_strategy = static_cast<GameStrategy>(static_cast<unsigned>(id) % STRATEGY_COUNT);
+            players.push_back(player);
+        }
+    }
+    players_ = std::move(players);
+    resetPairState(previous_ids);
+}
+
+double UIEECoreEngine::RepeatedPrisonersDilemma::getPayoff(GameStrategy strategy1, GameStrategy strategy2) {
+    return strategy_payoff_[strategy1][strategy2];
+}
+
+void UIEECoreEngine::RepeatedPrisonersDilemma::recordRound(GamePlayer& player, bool cooperated,
+                                                           double payoff, size_t games) {
+    player.action_history.push(cooperated);
+    player.cooperation_rate = static_cast<double>(player.action_history.cooperations()) /
+                              player.action_history.size();
+
+    // 本回合与所有对手的平均收益计入滑动平均，累计收益按对局总和
+    double mean = games > 0 ? payoff / games : 0.0;
+    player.recent_payoff = player.total_rounds == 0 ? mean :
+                           player.recent_payoff + kRecentPayoffAlpha * (mean - player.recent_payoff);
+    player.last_payoff = mean;
+    player.cumulative_payoff += payoff;
+    player.total_rounds++;
+}
+
+void UIEECoreEngine::RepeatedPrisonersDilemma::simulateRound() {
+    simulateRounds(1);
+}
+
+void UIEECoreEngine::RepeatedPrisonersDilemma::simulateRounds(size_t rounds) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    size_t n = players_.size();
+    if (n < 2 || rounds == 0) {
+        return;
+    }
+
+    // 批开始时展开策略
+    for (size_t i = 0; i < n; ++i) {
+        strategies_[i] = static_cast<uint8_t>(players_[i].current_strategy);
+    }
+
+    // 行动：按这一对的上回合行动查响应表，宽容策略对背叛按概率原谅
+    auto decide = [this](uint8_t strategy, uint8_t own_last, uint8_t opponent_last) -> uint8_t {
+        if (strategy == STRATEGY_GENEROUS && !opponent_last) {
+            return rng_() < kGenerousForgiveThreshold ? 1 : 0;
+        }
+        return kResponse[strategy][own_last][opponent_last];
+    };
+
+    for (size_t round = 0; round < rounds; ++round) {
+        std::fill(round_cooperations_.begin(), round_cooperations_.end(), 0);
+        std::fill(round_payoffs_.begin(), round_payoffs_.end(), 0.0);
+
+        // 每对参与者只读写自己的两项上一次行动，原地更新不影响同回合其他对局
+        for (size_t i = 0; i < n; ++i) {
+            uint8_t* last_i = pair_last_.data() + i * n;
+            for (size_t j = i + 1; j < n; ++j) {
+                uint8_t* last_j = pair_last_.data() + j * n;
+                uint8_t action_i = decide(strategies_[i], last_i[j], last_j[i]);
+                uint8_t action_j = decide(strategies_[j], last_j[i], last_i[j]);
+                last_i[j] = action_i;
+                last_j[i] = action_j;
+
+                round_payoffs_[i] += action_payoff_[action_i][action_j];
+                round_payoffs_[j] += action_payoff_[action_j][action_i];
+                round_cooperations_[i] += action_i;
+                round_cooperations_[j] += action_j;
+            }
+        }
+
+        // 每个参与者每回合记一位：与半数以上对手合作即视为合作
+        size_t games = n - 1;
+        for (size_t i = 0; i < n; ++i) {
+            recordRound(players_[i], round_cooperations_[i] * 2u >= games, round_payoffs_[i], games);
+        }
+        current_round_++;
+    }
+}
+
+void UIEECoreEngine::RepeatedPrisonersDilemma::updateStrategies() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (players_.empty()) {
+        return;
+    }
+
+    // 收益低于平均值的参与者模仿当前收益最高者的策略；自适应策略已逐对调整，保持不变
+    double total = 0.0;
+    size_t best = 0;
+    for (size_t i = 0; i < players_.size(); ++i) {
+        total += players_[i].cumulative_payoff;
+        if (players_[i].cumulative_payoff > players_[best].cumulative_payoff) {
+            best = i;
+        }
+    }
+    double mean = total / players_.size();
+    GameStrategy best_strategy = players_[best].current_strategy;
+
+    for (auto& player : players_) {
+        if (player.current_strategy != STRATEGY_ADAPTIVE && player.cumulative_payoff < mean) {
+            player.current_strategy = best_strategy;
+        }
+    }
+}
+
+std::vector<UIEECoreEngine::GamePlayer> UIEECoreEngine::RepeatedPrisonersDilemma::getPlayers() {
+    // 拷贝到默认堆，调用方持有期间不受博弈内存池影响
+    std::lock_guard<std::mutex> lock(mutex_);
+    return std::vector<GamePlayer>(players_.begin(), players_.end());
+}
+
+UIEECoreEngine::GameSummary UIEECoreEngine::RepeatedPrisonersDilemma::getSummary() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    GameSummary summary{};
+    summary.player_count = players_.size();
+    summary.current_round = current_round_;
+    for (const auto& player : players_) {
+        summary.average_cooperation += player.cooperation_rate;
+        summary.total_payoff += player.cumulative_payoff;
+        summary.strategy_counts[player.current_strategy]++;
+    }
+    if (!players_.empty()) {
+        summary.average_cooperation /= players_.size();
+        summary.average_payoff = summary.total_payoff / players_.size();
+    }
+    return summary;
+}
+
+bool UIEECoreEngine::RepeatedPrisonersDilemma::getPlayer(int player_id, GamePlayer& player) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto& candidate : players_) {
+        if (candidate.player_id == player_id) {
+            player = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+void UIEECoreEngine::RepeatedPrisonersDilemma::resetGame() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    players_.clear();
+    resetPairState({});
+    current_round_ = 0;
+}
+
+void UIEECoreEngine::RepeatedPrisonersDilemma::restorePlayers(const GamePlayer* players, size_t count,
+                                                             int current_round) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    count = std::min(count, MAX_PLAYERS);
+    players_.assign(players, players + count);
+    // 成对的上回合行动不入检查点，按新参与者处理
+    pair_last_.clear();
+    resetPairState({});
+    current_round_ = current_round;
+}
+
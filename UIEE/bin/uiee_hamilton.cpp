@@ -0,0 +1,430 @@
+#include "uiee_engine.h"
+#include "uiee_trace.h"
+#include <cstring>
+
+#if defined(__AVX__) || defined(__SSE2__)
+#include <immintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+// Hamilton 适应度函数实现
+// f = α·性能·g(w, s) + β·效率·h(w, s) − γ·代价·c(s)
+// 其中 w 为个体的4个调度权重，s 为调度强度：
+//   吻合度 a = 1 − ½·Σ|w/Σw − d|（d 为当前指标下的归一化需求，a ∈ [0,1]）
+//   g = (½ + ½a)(½ + ½s)，h = (½ + ½a)(1 − ½s)，c = ½ + ½s
+// 指标相关的部分每批只算一次，逐个体只剩 4 维权重的吻合度与几次乘加。
+// 结果按（指标桶, 权重, 量化参数）缓存：指标按 2 分一档、参数按 1/256 量化，
+// 采样抖动不会打散键，种群收敛后同一代内与相邻代之间大多命中。
+
+namespace {
+
+constexpr size_t kWeightDims = 4;
+constexpr double kDemandFloor = 0.05;   // 各项需求下限，避免某一维权重完全失去作用
+constexpr double kDefaultParameter = 0.5;
+constexpr double kMetricBucket = 2.0;          // 指标量化档宽（0-100 量纲）
+constexpr double kParameterLevels = 255.0;     // 参数量化级数
+constexpr int64_t kDefaultCacheTtlMs = 15000;
+constexpr double kPowerBudgetMw = 6000.0;      // 功耗代价满分对应的整机功率
+
+inline uint64_t mix64(uint64_t value) {
+    // splitmix64 终结函数
+    value ^= value >> 30;
+    value *= 0xbf58476d1ce4e5b9ULL;
+    value ^= value >> 27;
+    value *= 0x94d049bb133111ebULL;
+    value ^= value >> 31;
+    return value;
+}
+
+inline uint64_t doubleBits(double value) {
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+double clampPercent(double value) {
+    return std::max(0.0, std::min(100.0, value));
+}
+
+double performanceComponent(const UIEECoreEngine::PerformanceMetrics& metrics) {
+    return 0.5 * clampPercent(metrics.responsiveness_score) + 0.5 * clampPercent(metrics.fluency_score);
+}
+
+double efficiencyComponent(const UIEECoreEngine::PerformanceMetrics& metrics) {
+    return clampPercent(metrics.efficiency_score);
+}
+
+double energyCostComponent(const UIEECoreEngine::PerformanceMetrics& metrics) {
+    if (metrics.power_mw <= 0.0) {
+        // 没有功耗遥测时以负载与温度近似
+        return 0.6 * clampPercent(metrics.cpu_usage) + 0.4 * clampPercent(metrics.thermal_state);
+    }
+    // 功耗相对预算；有帧数据时按每个有效帧的能量计：同样的功耗帧率越低代价越高，超出目标的帧不算有效
+    double ratio = metrics.power_mw / kPowerBudgetMw;
+    if (metrics.fps > 0.0 && metrics.fps_target > 0.0) {
+        ratio *= metrics.fps_target / std::max(std::min(metrics.fps, metrics.fps_target), 1.0);
+    }
+    return 0.8 * clampPercent(100.0 * ratio) + 0.2 * clampPercent(metrics.thermal_state);
+}
+
+// 4 维权重与需求分布的 L1 距离（权重先截到非负再归一化）
+// 向量化只覆盖单行的 4 个分量，整个种群的遍历由 calculateFitnessBatch 逐行完成
+inline double weightDistance(const double* weights, const double* demand) {
+#if defined(__AVX__)
+    __m256d w = _mm256_max_pd(_mm256_loadu_pd(weights), _mm256_setzero_pd());
+    __m128d sum2 = _mm_add_pd(_mm256_castpd256_pd128(w), _mm256_extractf128_pd(w, 1));
+    double sum = _mm_cvtsd_f64(_mm_add_sd(sum2, _mm_unpackhi_pd(sum2, sum2)));
+    if (sum <= 1e-9) {
+        return 2.0;
+    }
+    __m256d diff = _mm256_sub_pd(_mm256_mul_pd(w, _mm256_set1_pd(1.0 / sum)), _mm256_loadu_pd(demand));
+    __m256d abs = _mm256_andnot_pd(_mm256_set1_pd(-0.0), diff);
+    __m128d dist2 = _mm_add_pd(_mm256_castpd256_pd128(abs), _mm256_extractf128_pd(abs, 1));
+    return _mm_cvtsd_f64(_mm_add_sd(dist2, _mm_unpackhi_pd(dist2, dist2)));
+#elif defined(__SSE2__)
+    __m128d zero = _mm_setzero_pd();
+    __m128d lo = _mm_max_pd(_mm_loadu_pd(weights), zero);
+    __m128d hi = _mm_max_pd(_mm_loadu_pd(weights + 2), zero);
+    __m128d sum2 = _mm_add_pd(lo, hi);
+    double sum = _mm_cvtsd_f64(_mm_add_sd(sum2, _mm_unpackhi_pd(sum2, sum2)));
+    if (sum <= 1e-9) {
+        return 2.0;
+    }
+    __m128d inv = _mm_set1_pd(1.0 / sum);
+    __m128d sign = _mm_set1_pd(-0.0);
+    __m128d dlo = _mm_andnot_pd(sign, _mm_sub_pd(_mm_mul_pd(lo, inv), _mm_loadu_pd(demand)));
+    __m128d dhi = _mm_andnot_pd(sign, _mm_sub_pd(_mm_mul_pd(hi, inv), _mm_loadu_pd(demand + 2)));
+    __m128d dist2 = _mm_add_pd(dlo, dhi);
+    return _mm_cvtsd_f64(_mm_add_sd(dist2, _mm_unpackhi_pd(dist2, dist2)));
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+    float64x2_t zero = vdupq_n_f64(0.0);
+    float64x2_t lo = vmaxq_f64(vld1q_f64(weights), zero);
+    float64x2_t hi = vmaxq_f64(vld1q_f64(weights + 2), zero);
+    double sum = vaddvq_f64(vaddq_f64(lo, hi));
+    if (sum <= 1e-9) {
+        return 2.0;
+    }
+    float64x2_t inv = vdupq_n_f64(1.0 / sum);
+    float64x2_t dlo = vabdq_f64(vmulq_f64(lo, inv), vld1q_f64(demand));
+    float64x2_t dhi = vabdq_f64(vmulq_f64(hi, inv), vld1q_f64(demand + 2));
+    return vaddvq_f64(vaddq_f64(dlo, dhi));
+#else
+    double w[kWeightDims];
+    double sum = 0.0;
+    for (size_t i = 0; i < kWeightDims; ++i) {
+        w[i] = std::max(0.0, weights[i]);
+        sum += w[i];
+    }
+    if (sum <= 1e-9) {
+        return 2.0;
+    }
+    double distance = 0.0;
+    for (size_t i = 0; i < kWeightDims; ++i) {
+        distance += std::fabs(w[i] / sum - demand[i]);
+    }
+    return distance;
+#endif
+}
+
+struct BatchConstants {
+    double alpha_performance;
+    double beta_efficiency;
+    double gamma_cost;
+    double demand[kWeightDims];
+};
+
+inline double scoreRow(const BatchConstants& constants, const double* row) {
+    double alignment = 1.0 - 0.5 * weightDistance(row, constants.demand);
+    double intensity = std::max(0.0, std::min(1.0, row[kWeightDims]));
+    double match = 0.5 + 0.5 * alignment;
+    double fitness = constants.alpha_performance * match * (0.5 + 0.5 * intensity) +
+                     constants.beta_efficiency * match * (1.0 - 0.5 * intensity) -
+                     constants.gamma_cost * (0.5 + 0.5 * intensity);
+    return std::max(fitness, 0.0);
+}
+
+} // namespace
+
+UIEECoreEngine::HamiltonFitnessFunction::HamiltonFitnessFunction()
+    : alpha_(0.4), beta_(0.3), gamma_(0.3),
+      cache_size_(0), cache_set_mask_(0), cache_ttl_ms_(kDefaultCacheTtlMs),
+      cache_hits_(0), cache_misses_(0), cache_evictions_(0) {
+    setCacheSize(100);
+}
+
+UIEECoreEngine::HamiltonFitnessFunction::~HamiltonFitnessFunction() = default;
+
+double UIEECoreEngine::HamiltonFitnessFunction::calculatePerformanceComponent(const PerformanceMetrics& metrics) {
+    return performanceComponent(metrics);
+}
+
+double UIEECoreEngine::HamiltonFitnessFunction::calculateEfficiencyComponent(const PerformanceMetrics& metrics) {
+    return efficiencyComponent(metrics);
+}
+
+double UIEECoreEngine::HamiltonFitnessFunction::calculateEnergyCost(const PerformanceMetrics& metrics) {
+    return energyCostComponent(metrics);
+}
+
+UIEECoreEngine::HamiltonFitnessFunction::Components
+UIEECoreEngine::HamiltonFitnessFunction::calculateComponents(const PerformanceMetrics& metrics) const {
+    Components components;
+    components.performance = performanceComponent(metrics);
+    components.efficiency = efficiencyComponent(metrics);
+    components.energy_cost = energyCostComponent(metrics);
+
+    // 需求：负载高要响应，流畅分低要流畅，电量低/内存紧要能效，温度高要温控
+    double raw[kWeightDims] = {
+        clampPercent(metrics.cpu_usage) / 100.0,
+        (100.0 - clampPercent(metrics.fluency_score)) / 100.0,
+        (100.0 - clampPercent(metrics.battery_level)) / 100.0 + clampPercent(metrics.memory_usage) / 200.0,
+        clampPercent(metrics.thermal_state) / 100.0
+    };
+    double sum = 0.0;
+    for (double& value : raw) {
+        value += kDemandFloor;
+        sum += value;
+    }
+    for (size_t i = 0; i < kWeightDims; ++i) {
+        components.demand[i] = raw[i] / sum;
+    }
+    return components;
+}
+
+void UIEECoreEngine::HamiltonFitnessFunction::calculateFitnessBatch(const PerformanceMetrics& metrics,
+                                                                     const double* parameters,
+                                                                     size_t count, size_t dims, double* out) {
+    if (count == 0) {
+        return;
+    }
+    UIEE_TRACE_SCOPE(PHASE_FITNESS_BATCH);
+    UIEE_TRACE_COUNT(COUNTER_FITNESS_EVALUATIONS, count);
+    auto start = std::chrono::steady_clock::now();
+    int64_t now_ms = std::chrono::duration_cast<std::chrono::milliseconds>(start.time_since_epoch()).count();
+
+    Components components = calculateComponents(metrics);
+    BatchConstants constants;
+    uint64_t metrics_key = quantizeMetrics(metrics);
+    {
+        std::lock_guard<std::mutex> lock(weights_mutex_);
+        constants.alpha_performance = alpha_ * components.performance;
+        constants.beta_efficiency = beta_ * components.efficiency;
+        constants.gamma_cost = gamma_ * components.energy_cost;
+        // 权重变化后旧条目自然失配
+        metrics_key = mix64(metrics_key ^ mix64(doubleBits(alpha_)) ^
+                            mix64(doubleBits(beta_) + 1) ^ mix64(doubleBits(gamma_) + 2));
+    }
+    std::copy(components.demand, components.demand + kWeightDims, constants.demand);
+
+    std::shared_lock<std::shared_mutex> cache_lock(cache_mutex_);
+    bool use_cache = cache_ && cache_ttl_ms_.load(std::memory_order_relaxed) > 0;
+
+    constexpr size_t kRowDims = kWeightDims + 1;
+    double padded[kRowDims];
+    size_t hits = 0;
+    for (size_t i = 0; i < count; ++i) {
+        const double* row = parameters + i * dims;
+        if (dims < kRowDims) {
+            // 维数不足时缺失参数取中值
+            for (size_t d = 0; d < kRowDims; ++d) {
+                padded[d] = d < dims ? row[d] : kDefaultParameter;
+            }
+            row = padded;
+        }
+
+        uint64_t key = 0;
+        if (use_cache) {
+            key = cacheKey(metrics_key, row, kRowDims);
+            if (findCacheEntry(key, now_ms, out[i])) {
+                hits++;
+                continue;
+            }
+        }
+        out[i] = scoreRow(constants, row);
+        if (use_cache) {
+            insertCacheEntry(key, now_ms, out[i]);
+        }
+    }
+    cache_lock.unlock();
+
+    if (use_cache) {
+        cache_hits_.fetch_add(hits, std::memory_order_relaxed);
+        cache_misses_.fetch_add(count - hits, std::memory_order_relaxed);
+    }
+
+    auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start);
+    updateStats(elapsed.count(), count);
+}
+
+size_t UIEECoreEngine::HamiltonFitnessFunction::parallelChunkSize(size_t count, size_t workers) {
+    size_t parts = workers + 1;   // 调用线程同样参与
+    return std::max(MIN_PARALLEL_CHUNK, (count + parts - 1) / parts);
+}
+
+double UIEECoreEngine::HamiltonFitnessFunction::calculateFitness(const PerformanceMetrics& metrics,
+                                                                  const double* parameters, size_t count) {
+    double fitness = 0.0;
+    calculateFitnessBatch(metrics, parameters, 1, count, &fitness);
+    return fitness;
+}
+
+void UIEECoreEngine::HamiltonFitnessFunction::clearCache() {
+    std::unique_lock<std::shared_mutex> lock(cache_mutex_);
+    size_t sets = cache_ ? cache_set_mask_ + 1 : 0;
+    for (size_t i = 0; i < sets; ++i) {
+        for (size_t way = 0; way < FitnessCache::WAYS; ++way) {
+            cache_[i].keys[way].store(0, std::memory_order_relaxed);
+        }
+    }
+}
+
+void UIEECoreEngine::HamiltonFitnessFunction::setCacheSize(size_t size) {
+    // 组数取 2 的幂，按掩码定位
+    size_t sets = 1;
+    while (sets * FitnessCache::WAYS < std::max<size_t>(size, FitnessCache::WAYS)) {
+        sets <<= 1;
+    }
+
+    std::unique_lock<std::shared_mutex> lock(cache_mutex_);
+    if (cache_ && sets * FitnessCache::WAYS == cache_size_) {
+        return;
+    }
+    cache_ = std::make_unique<FitnessCache[]>(sets);
+    cache_size_ = sets * FitnessCache::WAYS;
+    cache_set_mask_ = sets - 1;
+}
+
+uint64_t UIEECoreEngine::HamiltonFitnessFunction::quantizeMetrics(const PerformanceMetrics& metrics) {
+    // 只取适应度实际用到的字段，每项 6 位；功耗与帧率只经由能量代价影响适应度，直接取代价
+    const double fields[] = {
+        metrics.cpu_usage, metrics.memory_usage, metrics.thermal_state, metrics.battery_level,
+        metrics.responsiveness_score, metrics.fluency_score, metrics.efficiency_score,
+        energyCostComponent(metrics)
+    };
+    uint64_t key = 0;
+    for (double field : fields) {
+        key = (key << 6) | static_cast<uint64_t>(clampPercent(field) / kMetricBucket);
+    }
+    return key;
+}
+
+uint64_t UIEECoreEngine::HamiltonFitnessFunction::cacheKey(uint64_t metrics_key, const double* parameters, size_t dims) {
+    uint64_t packed = 0;
+    for (size_t d = 0; d < dims && d < 8; ++d) {
+        double value = std::max(0.0, std::min(1.0, parameters[d]));
+        packed = (packed << 8) | static_cast<uint64_t>(std::lround(value * kParameterLevels));
+    }
+    return mix64(metrics_key ^ mix64(packed)) | 1;   // 0 保留为空槽
+}
+
+bool UIEECoreEngine::HamiltonFitnessFunction::isCacheValid(const FitnessCache& set, size_t way, int64_t now_ms) const {
+    return set.keys[way].load(std::memory_order_relaxed) != 0 &&
+           now_ms - set.stamps[way].load(std::memory_order_relaxed) <= cache_ttl_ms_.load(std::memory_order_relaxed);
+}
+
+bool UIEECoreEngine::HamiltonFitnessFunction::findCacheEntry(uint64_t key, int64_t now_ms, double& fitness) const {
+    const FitnessCache& set = cache_[key & cache_set_mask_];
+    uint32_t sequence = set.sequence.load(std::memory_order_acquire);
+    if (sequence & 1) {
+        return false;
+    }
+
+    bool found = false;
+    uint64_t bits = 0;
+    for (size_t way = 0; way < FitnessCache::WAYS; ++way) {
+        if (set.keys[way].load(std::memory_order_relaxed) == key && isCacheValid(set, way, now_ms)) {
+            bits = set.values[way].load(std::memory_order_relaxed);
+            found = true;
+            break;
+        }
+    }
+
+    // 读期间组被改写则作废本次读取
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (!found || set.sequence.load(std::memory_order_relaxed) != sequence) {
+        return false;
+    }
+    std::memcpy(&fitness, &bits, sizeof(fitness));
+    return true;
+}
+
+void UIEECoreEngine::HamiltonFitnessFunction::insertCacheEntry(uint64_t key, int64_t now_ms, double fitness) {
+    FitnessCache& set = cache_[key & cache_set_mask_];
+    uint32_t sequence = set.sequence.load(std::memory_order_relaxed);
+    if ((sequence & 1) ||
+        !set.sequence.compare_exchange_strong(sequence, sequence + 1, std::memory_order_acquire,
+                                              std::memory_order_relaxed)) {
+        return;
+    }
+
+    // 优先复用同键或失效的槽，全部有效时轮转替换
+    size_t target = FitnessCache::WAYS;
+    for (size_t way = 0; way < FitnessCache::WAYS && target == FitnessCache::WAYS; ++way) {
+        if (set.keys[way].load(std::memory_order_relaxed) == key) {
+            target = way;
+        }
+    }
+    for (size_t way = 0; way < FitnessCache::WAYS && target == FitnessCache::WAYS; ++way) {
+        if (!isCacheValid(set, way, now_ms)) {
+            target = way;
+        }
+    }
+    if (target == FitnessCache::WAYS) {
+        target = set.next_victim.fetch_add(1, std::memory_order_relaxed) % FitnessCache::WAYS;
+        cache_evictions_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    set.keys[target].store(key, std::memory_order_relaxed);
+    set.values[target].store(doubleBits(fitness), std::memory_order_relaxed);
+    set.stamps[target].store(now_ms, std::memory_order_relaxed);
+    set.sequence.store(sequence + 2, std::memory_order_release);
+}
+
+void UIEECoreEngine::HamiltonFitnessFunction::updateAdaptiveWeights(const PerformanceMetrics& metrics) {
+    // 向当前压力方向平滑调整：高温提高代价权重，高负载提高性能权重，否则回到效率
+    double thermal = clampPercent(metrics.thermal_state) / 100.0;
+    double load = clampPercent(metrics.cpu_usage) / 100.0;
+    double target_gamma = 0.2 + 0.4 * thermal;
+    double target_alpha = 0.3 + 0.3 * load;
+    double target_beta = std::max(0.1, 1.0 - target_alpha - target_gamma);
+
+    std::lock_guard<std::mutex> lock(weights_mutex_);
+    constexpr double kRate = 0.1;
+    alpha_ += kRate * (target_alpha - alpha_);
+    beta_ += kRate * (target_beta - beta_);
+    gamma_ += kRate * (target_gamma - gamma_);
+
+    double sum = alpha_ + beta_ + gamma_;
+    if (sum > 0.0) {
+        alpha_ /= sum;
+        beta_ /= sum;
+        gamma_ /= sum;
+    }
+}
+
+void UIEECoreEngine::HamiltonFitnessFunction::setWeights(double alpha, double beta, double gamma) {
+    std::lock_guard<std::mutex> lock(weights_mutex_);
+    alpha_ = alpha;
+    beta_ = beta;
+    gamma_ = gamma;
+}
+
+UIEECoreEngine::HamiltonFitnessFunction::PerformanceStats
+UIEECoreEngine::HamiltonFitnessFunction::getStats() const {
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    PerformanceStats stats = stats_;
+    stats.cache_hits = cache_hits_;
+    stats.cache_misses = cache_misses_;
+    stats.cache_evictions = cache_evictions_;
+    return stats;
+}
+
+void UIEECoreEngine::HamiltonFitnessFunction::updateStats(double calculation_time_ms, size_t calculations) {
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    size_t previous = stats_.total_calculations;
+    stats_.total_calculations += calculations;
+    // 按个体数加权的平均单次耗时
+    stats_.avg_calculation_time_ms =
+        (stats_.avg_calculation_time_ms * previous + calculation_time_ms) / stats_.total_calculations;
+}
@@ -0,0 +1,766 @@
+#include "uiee_http_server.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <strings.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#ifdef __linux__
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/sendfile.h>
+#include <sys/socket.h>
+#endif
+
+// 内嵌 Web 服务实现
+
+UIEEHttpServer::UIEEHttpServer()
+    : listen_fd_(-1), epoll_fd_(-1), wake_fd_(-1), port_(0), running_(false),
+      connection_count_(0), subscriber_count_(0) {}
+
+UIEEHttpServer::~UIEEHttpServer() {
+    stop();
+}
+
+void UIEEHttpServer::addRoute(const std::string& method, const std::string& path, Handler handler) {
+    routes_[{method, path}] = std::move(handler);
+}
+
+const char* UIEEHttpServer::statusText(int status) {
+    switch (status) {
+        case 200: return "OK";
+        case 204: return "No Content";
+        case 400: return "Bad Request";
+        case 403: return "Forbidden";
+        case 404: return "Not Found";
+        case 405: return "Method Not Allowed";
+        case 413: return "Payload Too Large";
+        case 415: return "Unsupported Media Type";
+        case 431: return "Request Header Fields Too Large";
+        case 501: return "Not Implemented";
+        case 503: return "Service Unavailable";
+        default: return "Internal Server Error";
+    }
+}
+
+const char* UIEEHttpServer::contentType(const std::string& path) {
+    size_t dot = path.find_last_of('.');
+    if (dot == std::string::npos) {
+        return "application/octet-stream";
+    }
+    const char* ext = path.c_str() + dot + 1;
+    if (strcasecmp(ext, "html") == 0 || strcasecmp(ext, "htm") == 0) return "text/html; charset=utf-8";
+    if (strcasecmp(ext, "js") == 0) return "application/javascript; charset=utf-8";
+    if (strcasecmp(ext, "css") == 0) return "text/css; charset=utf-8";
+    if (strcasecmp(ext, "json") == 0) return "application/json; charset=utf-8";
+    if (strcasecmp(ext, "svg") == 0) return "image/svg+xml";
+    if (strcasecmp(ext, "png") == 0) return "image/png";
+    if (strcasecmp(ext, "jpg") == 0 || strcasecmp(ext, "jpeg") == 0) return "image/jpeg";
+    if (strcasecmp(ext, "ico") == 0) return "image/x-icon";
+    if (strcasecmp(ext, "txt") == 0 || strcasecmp(ext, "log") == 0) return "text/plain; charset=utf-8";
+    return "application/octet-stream";
+}
+
+bool UIEEHttpServer::decodePath(const std::string& raw, std::string& decoded) {
+    decoded.clear();
+    decoded.reserve(raw.size());
+    for (size_t i = 0; i < raw.size(); ++i) {
+        char c = raw[i];
+        if (c == '%' && i + 2 < raw.size()) {
+            char hex[3] = {raw[i + 1], raw[i + 2], '\0'};
+            char* end = nullptr;
+            long value = strtol(hex, &end, 16);
+            if (end != hex + 2 || value == 0) {
+                return false;
+            }
+            decoded.push_back(static_cast<char>(value));
+            i += 2;
+        } else {
+            decoded.push_back(c);
+        }
+    }
+    // 只接受绝对路径，拒绝任何 ".." 路径段
+    if (decoded.empty() || decoded[0] != '/') {
+        return false;
+    }
+    size_t pos = 0;
+    while ((pos = decoded.find("..", pos)) != std::string::npos) {
+        bool segment_start = decoded[pos - 1] == '/';
+        bool segment_end = pos + 2 == decoded.size() || decoded[pos + 2] == '/';
+        if (segment_start && segment_end) {
+            return false;
+        }
+        pos += 2;
+    }
+    return true;
+}
+
+std::string UIEEHttpServer::formatEvent(const std::string& event, const std::string& data) {
+    std::string text;
+    text.reserve(event.size() + data.size() + 16);
+    text += "event: ";
+    text += event;
+    text += "\ndata: ";
+    text += data;
+    text += "\n\n";
+    return text;
+}
+
+bool UIEEHttpServer::parseRequest(Connection& connection, Request& request, size_t& consumed, int& error_status) {
+    error_status = 0;
+    const std::string& in = connection.in;
+    size_t header_end = in.find("\r\n\r\n");
+    if (header_end == std::string::npos) {
+        if (in.size() > MAX_REQUEST_SIZE) {
+            error_status = 431;
+        }
+        return false;
+    }
+
+    // 请求行：METHOD SP target SP version
+    size_t line_end = in.find("\r\n");
+    size_t first_space = in.find(' ');
+    size_t second_space = first_space == std::string::npos ? std::string::npos : in.find(' ', first_space + 1);
+    if (first_space == std::string::npos || second_space == std::string::npos || second_space > line_end) {
+        error_status = 400;
+        return false;
+    }
+    request.method = in.substr(0, first_space);
+    std::string target = in.substr(first_space + 1, second_space - first_space - 1);
+    std::string version = in.substr(second_space + 1, line_end - second_space - 1);
+    size_t question = target.find('?');
+    request.path = target.substr(0, question);
+    request.query = question == std::string::npos ? std::string() : target.substr(question + 1);
+    connection.keep_alive = version == "HTTP/1.1";
+
+    size_t content_length = 0;
+    size_t pos = line_end + 2;
+    while (pos < header_end) {
+        size_t eol = in.find("\r\n", pos);
+        const char* line = in.c_str() + pos;
+        size_t length = eol - pos;
+        auto headerIs = [line, length](const char* name) {
+            size_t name_length = strlen(name);
+            return length > name_length && line[name_length] == ':' && strncasecmp(line, name, name_length) == 0;
+        };
+        auto headerValue = [&]() {
+            size_t colon = in.find(':', pos) + 1;
+            while (colon < eol && in[colon] == ' ') {
+                colon++;
+            }
+            return in.substr(colon, eol - colon);
+        };
+        if (headerIs("Content-Length")) {
+            content_length = strtoul(headerValue().c_str(), nullptr, 10);
+        } else if (headerIs("Connection")) {
+            std::string value = headerValue();
+            if (strcasecmp(value.c_str(), "close") == 0) {
+                connection.keep_alive = false;
+            } else if (strcasecmp(value.c_str(), "keep-alive") == 0) {
+                connection.keep_alive = true;
+            }
+        } else if (headerIs("Host")) {
+            request.host = headerValue();
+        } else if (headerIs("Origin")) {
+            request.origin = headerValue();
+        } else if (headerIs("Content-Type")) {
+            request.content_type = headerValue();
+        } else if (headerIs("X-UIEE-Token")) {
+            request.token = headerValue();
+        } else if (headerIs("Transfer-Encoding")) {
+            error_status = 501;
+            return false;
+        }
+        pos = eol + 2;
+    }
+
+    if (content_length > MAX_REQUEST_SIZE) {
+        error_status = 413;
+        return false;
+    }
+    size_t body_start = header_end + 4;
+    if (in.size() < body_start + content_length) {
+        return false;
+    }
+    request.body = in.substr(body_start, content_length);
+    consumed = body_start + content_length;
+    return true;
+}
+
+void UIEEHttpServer::sendResponse(Connection& connection, const Response& response, bool head_only) {
+    char header[256];
+    int length = snprintf(header, sizeof(header),
+                          "HTTP/1.1 %d %s\r\nContent-Type: %s\r\nContent-Length: %zu\r\n"
+                          "Cache-Control: no-cache\r\nConnection: %s\r\n\r\n",
+                          response.status, statusText(response.status), response.content_type.c_str(),
+                          response.body.size(), connection.keep_alive ? "keep-alive" : "close");
+    connection.out.append(header, static_cast<size_t>(std::min<int>(length, sizeof(header) - 1)));
+    if (!head_only) {
+        connection.out += response.body;
+    }
+}
+
+void UIEEHttpServer::sendError(Connection& connection, int status, bool head_only) {
+    Response response;
+    response.status = status;
+    response.body = std::string("{\"error\": \"") + statusText(status) + "\"}";
+    sendResponse(connection, response, head_only);
+}
+
+int UIEEHttpServer::checkWriteRequest(const Connection& connection, const Request& request) const {
+    // Host 只接受连接实际到达的地址，回环连接另接受 localhost；缺少 Host 同样拒绝
+    bool host_ok = !request.host.empty() &&
+        (request.host == connection.local_host ||
+         (connection.loopback && request.host == "localhost:" + std::to_string(port_)));
+    if (!host_ok) {
+        return 403;
+    }
+    // 浏览器发起的写请求都带 Origin，跨站时与 Host 不一致；命令行工具不带 Origin
+    if (!request.origin.empty() && request.origin != "http://" + request.host) {
+        return 403;
+    }
+    // 参数之前的媒体类型必须是 application/json（不区分大小写）
+    const std::string& type = request.content_type;
+    static const char kJson[] = "application/json";
+    size_t length = sizeof(kJson) - 1;
+    if (type.size() < length || strncasecmp(type.c_str(), kJson, length) != 0 ||
+        (type.size() > length && type[length] != ';' && type[length] != ' ')) {
+        return 415;
+    }
+    if (!access_token_.empty() && request.token != access_token_) {
+        return 403;
+    }
+    return 0;
+}
+
+void UIEEHttpServer::dispatch(Connection& connection, const Request& request) {
+    if (!event_stream_path_.empty() && request.path == event_stream_path_ && request.method == "GET") {
+        serveEventStream(connection);
+        return;
+    }
+
+    // HEAD 没有单独登记时按 GET 处理，只回响应头
+    const bool head_only = request.method == "HEAD";
+    auto route = routes_.find({request.method, request.path});
+    if (route == routes_.end() && head_only) {
+        route = routes_.find({"GET", request.path});
+    }
+    if (route != routes_.end()) {
+        if (request.method != "GET" && request.method != "HEAD") {
+            int status = checkWriteRequest(connection, request);
+            if (status != 0) {
+                sendError(connection, status);
+                return;
+            }
+        }
+        Response response;
+        try {
+            response = route->second(request);
+        } catch (const std::exception&) {
+            response.status = 500;
+            response.body = "{\"error\": \"Internal Server Error\"}";
+        }
+        sendResponse(connection, response, head_only);
+        return;
+    }
+
+    // 路径存在但方法不匹配
+    for (const auto& entry : routes_) {
+        if (entry.first.second == request.path) {
+            sendError(connection, 405, head_only);
+            return;
+        }
+    }
+
+    if (request.method == "GET" || request.method == "HEAD") {
+        serveFile(connection, request);
+    } else {
+        sendError(connection, 405);
+    }
+}
+
+// 以下为 epoll/sendfile/eventfd 相关部分
+#ifdef __linux__
+
+void UIEEHttpServer::serveFile(Connection& connection, const Request& request) {
+    std::string path;
+    if (document_root_.empty() || !decodePath(request.path, path)) {
+        sendError(connection, document_root_.empty() ? 404 : 400, request.method == "HEAD");
+        return;
+    }
+    if (path.back() == '/') {
+        path += "index.html";
+    }
+
+    std::string full_path = document_root_ + path;
+    int fd = ::open(full_path.c_str(), O_RDONLY | O_CLOEXEC);
+    struct stat st;
+    if (fd < 0 || fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+        if (fd >= 0) {
+            ::close(fd);
+        }
+        sendError(connection, errno == EACCES ? 403 : 404, request.method == "HEAD");
+        return;
+    }
+
+    Response header_only;
+    header_only.content_type = contentType(path);
+    char header[256];
+    int length = snprintf(header, sizeof(header),
+                          "HTTP/1.1 200 OK\r\nContent-Type: %s\r\nContent-Length: %lld\r\n"
+                          "Cache-Control: no-cache\r\nConnection: %s\r\n\r\n",
+                          header_only.content_type.c_str(), static_cast<long long>(st.st_size),
+                          connection.keep_alive ? "keep-alive" : "close");
+    connection.out.append(header, static_cast<size_t>(std::min<int>(length, sizeof(header) - 1)));
+
+    if (request.method == "HEAD" || st.st_size == 0) {
+        ::close(fd);
+        return;
+    }
+    // 文件内容由 sendfile 直接从页缓存发送，不经过用户态缓冲
+    connection.file_fd = fd;
+    connection.file_offset = 0;
+    connection.file_end = st.st_size;
+}
+
+void UIEEHttpServer::serveEventStream(Connection& connection) {
+    connection.event_stream = true;
+    connection.keep_alive = true;
+    connection.in.clear();
+    connection.out += "HTTP/1.1 200 OK\r\nContent-Type: text/event-stream\r\n"
+                      "Cache-Control: no-cache\r\nConnection: keep-alive\r\n"
+                      "X-Accel-Buffering: no\r\n\r\n"
+                      "retry: 3000\n\n";
+    for (const auto& event : last_events_) {
+        connection.out += event.second;
+    }
+    subscriber_count_++;
+}
+
+bool UIEEHttpServer::start(uint16_t port, const std::string& bind_address) {
+    if (running_) {
+        return true;
+    }
+
+    struct sockaddr_in address;
+    memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    if (inet_pton(AF_INET, bind_address.c_str(), &address.sin_addr) != 1) {
+        errno = EINVAL;
+        return false;
+    }
+
+    listen_fd_ = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (listen_fd_ < 0) {
+        return false;
+    }
+    int reuse = 1;
+    setsockopt(listen_fd_, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+    if (bind(listen_fd_, reinterpret_cast<struct sockaddr*>(&address), sizeof(address)) != 0 ||
+        listen(listen_fd_, 16) != 0) {
+        int err = errno;
+        ::close(listen_fd_);
+        listen_fd_ = -1;
+        errno = err;
+        return false;
+    }
+    socklen_t address_length = sizeof(address);
+    if (getsockname(listen_fd_, reinterpret_cast<struct sockaddr*>(&address), &address_length) == 0) {
+        port_ = ntohs(address.sin_port);
+    }
+
+    epoll_fd_ = epoll_create1(EPOLL_CLOEXEC);
+    wake_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (epoll_fd_ < 0 || wake_fd_ < 0) {
+        int err = errno;
+        stop();
+        ::close(listen_fd_);
+        listen_fd_ = -1;
+        errno = err;
+        return false;
+    }
+
+    struct epoll_event event;
+    memset(&event, 0, sizeof(event));
+    event.events = EPOLLIN;
+    event.data.fd = listen_fd_;
+    epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, listen_fd_, &event);
+    event.data.fd = wake_fd_;
+    epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, wake_fd_, &event);
+
+    running_ = true;
+    thread_ = std::thread(&UIEEHttpServer::eventLoop, this);
+    return true;
+}
+
+void UIEEHttpServer::stop() {
+    if (running_) {
+        running_ = false;
+        uint64_t one = 1;
+        ssize_t ignored = ::write(wake_fd_, &one, sizeof(one));
+        (void)ignored;
+    }
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+
+    std::vector<int> fds;
+    for (const auto& entry : connections_) {
+        fds.push_back(entry.first);
+    }
+    for (int fd : fds) {
+        closeConnection(fd);
+    }
+    for (int* fd : {&listen_fd_, &epoll_fd_, &wake_fd_}) {
+        if (*fd >= 0) {
+            ::close(*fd);
+            *fd = -1;
+        }
+    }
+    last_events_.clear();
+}
+
+void UIEEHttpServer::publish(const std::string& event, const std::string& data) {
+    if (!running_) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(pending_mutex_);
+        // 同名事件未送出前被覆盖：订阅者只关心最新状态
+        auto existing = std::find_if(pending_events_.begin(), pending_events_.end(),
+                                     [&event](const std::pair<std::string, std::string>& item) {
+                                         return item.first == event;
+                                     });
+        if (existing != pending_events_.end()) {
+            existing->second = data;
+        } else {
+            pending_events_.emplace_back(event, data);
+        }
+    }
+    uint64_t one = 1;
+    ssize_t ignored = ::write(wake_fd_, &one, sizeof(one));
+    (void)ignored;
+}
+
+void UIEEHttpServer::eventLoop() {
+    struct epoll_event events[32];
+    auto last_sweep = Clock::now();
+    last_keepalive_ = last_sweep;
+
+    while (running_) {
+        int ready = epoll_wait(epoll_fd_, events, 32, 1000);
+        if (ready < 0 && errno != EINTR) {
+            break;
+        }
+
+        for (int i = 0; i < ready; ++i) {
+            int fd = events[i].data.fd;
+            uint32_t flags = events[i].events;
+            if (fd == listen_fd_) {
+                acceptConnections();
+                continue;
+            }
+            if (fd == wake_fd_) {
+                deliverPendingEvents();
+                continue;
+            }
+
+            auto found = connections_.find(fd);
+            if (found == connections_.end()) {
+                continue;
+            }
+            Connection& connection = found->second;
+            bool alive = true;
+            if (flags & (EPOLLERR | EPOLLHUP)) {
+                alive = false;
+            }
+            if (alive && (flags & EPOLLIN)) {
+                alive = handleReadable(connection);
+            }
+            if (alive && (flags & EPOLLOUT)) {
+                alive = handleWritable(connection) && processRequests(connection);
+            }
+            if (!alive) {
+                closeConnection(fd);
+            }
+        }
+
+        auto now = Clock::now();
+        if (now - last_sweep >= std::chrono::seconds(1)) {
+            last_sweep = now;
+            sweepConnections();
+        }
+    }
+}
+
+void UIEEHttpServer::acceptConnections() {
+    while (true) {
+        int fd = accept4(listen_fd_, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return;
+        }
+        if (connections_.size() >= MAX_CONNECTIONS) {
+            ::close(fd);
+            continue;
+        }
+        int nodelay = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &nodelay, sizeof(nodelay));
+
+        Connection& connection = connections_[fd];
+        connection.fd = fd;
+        struct sockaddr_in local;
+        socklen_t local_length = sizeof(local);
+        char address[INET_ADDRSTRLEN];
+        if (getsockname(fd, reinterpret_cast<struct sockaddr*>(&local), &local_length) == 0 &&
+            inet_ntop(AF_INET, &local.sin_addr, address, sizeof(address)) != nullptr) {
+            connection.local_host = std::string(address) + ":" + std::to_string(ntohs(local.sin_port));
+            connection.loopback = (ntohl(local.sin_addr.s_addr) >> 24) == 127;
+        }
+        connection.last_active = Clock::now();
+        connection.epoll_events = EPOLLIN;
+
+        struct epoll_event event;
+        memset(&event, 0, sizeof(event));
+        event.events = EPOLLIN;
+        event.data.fd = fd;
+        if (epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &event) != 0) {
+            connections_.erase(fd);
+            ::close(fd);
+            continue;
+        }
+        connection_count_ = connections_.size();
+    }
+}
+
+bool UIEEHttpServer::handleReadable(Connection& connection) {
+    char buffer[4096];
+    while (true) {
+        ssize_t n = recv(connection.fd, buffer, sizeof(buffer), 0);
+        if (n > 0) {
+            // 订阅者只接收推送，请求方向的数据丢弃
+            if (!connection.event_stream) {
+                connection.in.append(buffer, static_cast<size_t>(n));
+                if (connection.in.size() > 2 * MAX_REQUEST_SIZE) {
+                    return false;
+                }
+            }
+            continue;
+        }
+        if (n == 0) {
+            return false;
+        }
+        if (errno == EINTR) {
+            continue;
+        }
+        if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            break;
+        }
+        return false;
+    }
+    connection.last_active = Clock::now();
+    return processRequests(connection);
+}
+
+bool UIEEHttpServer::processRequests(Connection& connection) {
+    // 一次只处理一个请求，上一个响应发完后再处理缓冲区中的下一个（流水线请求按顺序应答）
+    while (!connection.event_stream && connection.out.empty() && connection.file_fd < 0 &&
+           !connection.in.empty()) {
+        Request request;
+        size_t consumed = 0;
+        int error_status = 0;
+        if (!parseRequest(connection, request, consumed, error_status)) {
+            if (error_status == 0) {
+                return true;   // 请求尚未收全
+            }
+            connection.keep_alive = false;
+            connection.in.clear();
+            sendError(connection, error_status);
+            return handleWritable(connection);
+        }
+        connection.in.erase(0, consumed);
+        dispatch(connection, request);
+        if (!handleWritable(connection)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool UIEEHttpServer::handleWritable(Connection& connection) {
+    while (connection.out_offset < connection.out.size()) {
+        ssize_t n = send(connection.fd, connection.out.data() + connection.out_offset,
+                         connection.out.size() - connection.out_offset, MSG_NOSIGNAL);
+        if (n > 0) {
+            connection.out_offset += static_cast<size_t>(n);
+            continue;
+        }
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            updateInterest(connection);
+            return true;
+        }
+        return false;
+    }
+    connection.out.clear();
+    connection.out_offset = 0;
+
+    while (connection.file_fd >= 0 && connection.file_offset < connection.file_end) {
+        ssize_t n = sendfile(connection.fd, connection.file_fd, &connection.file_offset,
+                             static_cast<size_t>(connection.file_end - connection.file_offset));
+        if (n > 0) {
+            continue;
+        }
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            updateInterest(connection);
+            return true;
+        }
+        // 文件被截断或发送失败，已声明的长度无法兑现，只能断开
+        return false;
+    }
+    if (connection.file_fd >= 0) {
+        ::close(connection.file_fd);
+        connection.file_fd = -1;
+    }
+
+    updateInterest(connection);
+    connection.last_active = Clock::now();
+    return connection.keep_alive || connection.event_stream;
+}
+
+void UIEEHttpServer::updateInterest(Connection& connection) {
+    bool pending = connection.out_offset < connection.out.size() ||
+                   (connection.file_fd >= 0 && connection.file_offset < connection.file_end);
+    uint32_t wanted = EPOLLIN | (pending ? static_cast<uint32_t>(EPOLLOUT) : 0u);
+    if (wanted == connection.epoll_events) {
+        return;
+    }
+    struct epoll_event event;
+    memset(&event, 0, sizeof(event));
+    event.events = wanted;
+    event.data.fd = connection.fd;
+    if (epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, connection.fd, &event) == 0) {
+        connection.epoll_events = wanted;
+    }
+}
+
+void UIEEHttpServer::closeConnection(int fd) {
+    auto found = connections_.find(fd);
+    if (found == connections_.end()) {
+        return;
+    }
+    if (epoll_fd_ >= 0) {
+        epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, fd, nullptr);
+    }
+    if (found->second.file_fd >= 0) {
+        ::close(found->second.file_fd);
+    }
+    if (found->second.event_stream) {
+        subscriber_count_--;
+    }
+    ::close(fd);
+    connections_.erase(found);
+    connection_count_ = connections_.size();
+}
+
+void UIEEHttpServer::deliverPendingEvents() {
+    uint64_t counter;
+    while (::read(wake_fd_, &counter, sizeof(counter)) > 0) {
+    }
+
+    std::vector<std::pair<std::string, std::string>> events;
+    {
+        std::lock_guard<std::mutex> lock(pending_mutex_);
+        events.swap(pending_events_);
+    }
+    if (events.empty()) {
+        return;
+    }
+
+    // 每条事件只格式化一次，追加到所有订阅者的发送缓冲
+    std::string batch;
+    for (const auto& event : events) {
+        std::string text = formatEvent(event.first, event.second);
+        batch += text;
+        last_events_[event.first] = std::move(text);
+    }
+
+    std::vector<int> dead;
+    for (auto& entry : connections_) {
+        Connection& connection = entry.second;
+        if (!connection.event_stream) {
+            continue;
+        }
+        if (connection.out.size() - connection.out_offset > MAX_EVENT_BACKLOG) {
+            dead.push_back(entry.first);
+            continue;
+        }
+        connection.out += batch;
+        if (!handleWritable(connection)) {
+            dead.push_back(entry.first);
+        }
+    }
+    for (int fd : dead) {
+        closeConnection(fd);
+    }
+}
+
+void UIEEHttpServer::sweepConnections() {
+    auto now = Clock::now();
+    bool keepalive = now - last_keepalive_ >= std::chrono::milliseconds(KEEPALIVE_INTERVAL_MS);
+    if (keepalive) {
+        last_keepalive_ = now;
+    }
+
+    std::vector<int> dead;
+    for (auto& entry : connections_) {
+        Connection& connection = entry.second;
+        if (connection.event_stream) {
+            if (keepalive) {
+                connection.out += ": ping\n\n";
+                if (!handleWritable(connection)) {
+                    dead.push_back(entry.first);
+                }
+            }
+        } else if (now - connection.last_active >= std::chrono::milliseconds(IDLE_TIMEOUT_MS)) {
+            dead.push_back(entry.first);
+        }
+    }
+    for (int fd : dead) {
+        closeConnection(fd);
+    }
+}
+
+#else
+
+void UIEEHttpServer::serveFile(Connection& connection, const Request&) {
+    sendError(connection, 501);
+}
+
+void UIEEHttpServer::serveEventStream(Connection& connection) {
+    sendError(connection, 501);
+}
+
+bool UIEEHttpServer::start(uint16_t, const std::string&) {
+    return false;
+}
+
+void UIEEHttpServer::stop() {}
+
+void UIEEHttpServer::publish(const std::string&, const std::string&) {}
+
+#endif
@@ -0,0 +1,356 @@
+#include "uiee_logger.h"
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+// 异步日志实现
+
+namespace {
+
+int64_t currentSecond() {
+    return std::chrono::duration_cast<std::chrono::seconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+} // namespace
+
+UIEELogger::UIEELogger()
+    : slots_(new Slot[RING_CAPACITY]), enqueue_pos_(0), dequeue_pos_(0),
+      running_(false), writer_sleeping_(false),
+      min_level_(LEVEL_INFO), max_file_size_(0),
+      performance_log_enabled_(true), error_log_enabled_(true),
+      dropped_count_(0), reported_dropped_(0), cached_second_(-1) {
+    for (size_t i = 0; i < RING_CAPACITY; ++i) {
+        slots_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    static const char* const kSinkNames[SINK_COUNT] = {
+        "engine.log", "service.log", "error.log", "performance.log"
+    };
+    for (int i = 0; i < SINK_COUNT; ++i) {
+        sinks_[i].name = kSinkNames[i];
+        sinks_[i].fd = -1;
+        sinks_[i].size = 0;
+        sinks_[i].last_open_attempt = 0;
+    }
+    cached_timestamp_[0] = '\0';
+}
+
+UIEELogger::~UIEELogger() {
+    stop();
+    // 未启动过写线程时，把队列中的日志至少输出到控制台
+    drain();
+    flushPending();
+    closeSinks();
+}
+
+bool UIEELogger::start(const std::string& log_dir) {
+    if (running_) {
+        return true;
+    }
+
+    log_dir_ = log_dir;
+    running_ = true;
+    writer_thread_ = std::thread(&UIEELogger::writerLoop, this);
+    return true;
+}
+
+void UIEELogger::stop() {
+    if (!running_) {
+        return;
+    }
+
+    running_ = false;
+    {
+        std::lock_guard<std::mutex> lock(wake_mutex_);
+        wake_cv_.notify_one();
+    }
+    if (writer_thread_.joinable()) {
+        writer_thread_.join();
+    }
+}
+
+bool UIEELogger::isEnabled(Level level) const {
+    if (level == LEVEL_PERF) {
+        return performance_log_enabled_;
+    }
+    return level >= min_level_.load(std::memory_order_relaxed);
+}
+
+void UIEELogger::log(Level level, std::string_view message) {
+    if (!isEnabled(level)) {
+        return;
+    }
+
+    // 有界 MPSC 队列：每个槽位的序号表示它当前可被哪一轮生产者/消费者使用
+    uint64_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+    Slot* slot;
+    for (;;) {
+        slot = &slots_[pos & (RING_CAPACITY - 1)];
+        uint64_t sequence = slot->sequence.load(std::memory_order_acquire);
+        int64_t diff = static_cast<int64_t>(sequence) - static_cast<int64_t>(pos);
+        if (diff == 0) {
+            if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            // 队列已满：丢弃而不是阻塞调度路径
+            dropped_count_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        } else {
+            pos = enqueue_pos_.load(std::memory_order_relaxed);
+        }
+    }
+
+    size_t length = std::min(message.size(), MAX_MESSAGE_LENGTH);
+    // 截断时退回到UTF-8字符边界，避免中文被截成半个字符
+    if (length < message.size()) {
+        while (length > 0 && (static_cast<unsigned char>(message[length]) & 0xC0) == 0x80) {
+            length--;
+        }
+    }
+    std::memcpy(slot->text, message.data(), length);
+    slot->length = static_cast<uint16_t>(length);
+    slot->level = level;
+    slot->timestamp = currentSecond();
+    slot->sequence.store(pos + 1, std::memory_order_release);
+
+    // 写线程空闲时才唤醒；偶发的丢失唤醒由等待超时兜底
+    if (writer_sleeping_.load(std::memory_order_acquire)) {
+        wake_cv_.notify_one();
+    }
+}
+
+bool UIEELogger::parseLevel(const std::string& text, Level& level) {
+    std::string upper;
+    upper.reserve(text.size());
+    for (char c : text) {
+        upper.push_back(static_cast<char>(std::toupper(static_cast<unsigned char>(c))));
+    }
+
+    if (upper == "DEBUG") {
+        level = LEVEL_DEBUG;
+    } else if (upper == "INFO") {
+        level = LEVEL_INFO;
+    } else if (upper == "WARNING" || upper == "WARN") {
+        level = LEVEL_WARNING;
+    } else if (upper == "ERROR") {
+        level = LEVEL_ERROR;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+void UIEELogger::writerLoop() {
+    while (running_) {
+        if (drain()) {
+            flushPending();
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(wake_mutex_);
+        writer_sleeping_.store(true, std::memory_order_release);
+        // 置位后再检查一次，缩小与生产者之间的竞争窗口
+        uint64_t head = dequeue_pos_;
+        if (slots_[head & (RING_CAPACITY - 1)].sequence.load(std::memory_order_acquire) != head + 1 &&
+            running_) {
+            wake_cv_.wait_for(lock, std::chrono::milliseconds(WRITER_IDLE_TIMEOUT_MS));
+        }
+        writer_sleeping_.store(false, std::memory_order_relaxed);
+    }
+
+    // 退出前写完剩余日志
+    drain();
+    flushPending();
+}
+
+bool UIEELogger::drain() {
+    bool any = false;
+    for (;;) {
+        Slot& slot = slots_[dequeue_pos_ & (RING_CAPACITY - 1)];
+        if (slot.sequence.load(std::memory_order_acquire) != dequeue_pos_ + 1) {
+            break;
+        }
+        appendLine(slot);
+        slot.sequence.store(dequeue_pos_ + RING_CAPACITY, std::memory_order_release);
+        dequeue_pos_++;
+        any = true;
+    }
+
+    uint64_t dropped = dropped_count_.load(std::memory_order_relaxed);
+    if (dropped != reported_dropped_) {
+        char line[128];
+        int n = std::snprintf(line, sizeof(line), "[%s] [WARNING] 日志队列已满，丢弃 %llu 条日志\n",
+                              formatTimestamp(currentSecond()),
+                              static_cast<unsigned long long>(dropped - reported_dropped_));
+        if (n > 0) {
+            sinks_[SINK_SERVICE].pending.append(line, static_cast<size_t>(n));
+            console_err_.append(line, static_cast<size_t>(n));
+        }
+        reported_dropped_ = dropped;
+        any = true;
+    }
+    return any;
+}
+
+void UIEELogger::appendLine(const Slot& slot) {
+    Sink sink = SINK_ENGINE;
+    std::string* console = &console_out_;
+    switch (slot.level) {
+        case LEVEL_DEBUG:
+        case LEVEL_INFO:
+            sink = SINK_ENGINE;
+            break;
+        case LEVEL_WARNING:
+            sink = SINK_SERVICE;
+            console = &console_err_;
+            break;
+        case LEVEL_ERROR:
+            sink = SINK_ERROR;
+            console = &console_err_;
+            break;
+        case LEVEL_PERF:
+            sink = SINK_PERFORMANCE;
+            break;
+    }
+
+    std::string& pending = sinks_[sink].pending;
+    size_t start = pending.size();
+    pending += '[';
+    pending += formatTimestamp(slot.timestamp);
+    pending += "] [";
+    pending += levelName(slot.level);
+    pending += "] ";
+    pending.append(slot.text, slot.length);
+    pending += '\n';
+    console->append(pending, start, std::string::npos);
+
+    if (sink == SINK_ERROR && !error_log_enabled_) {
+        pending.resize(start);
+    }
+}
+
+void UIEELogger::flushPending() {
+    if (!console_out_.empty()) {
+        writeAll(STDOUT_FILENO, console_out_);
+        console_out_.clear();
+    }
+    if (!console_err_.empty()) {
+        writeAll(STDERR_FILENO, console_err_);
+        console_err_.clear();
+    }
+
+    if (log_dir_.empty()) {
+        for (auto& sink : sinks_) {
+            sink.pending.clear();
+        }
+        return;
+    }
+
+    int64_t now = currentSecond();
+    size_t max_size = max_file_size_;
+    for (auto& sink : sinks_) {
+        if (sink.pending.empty()) {
+            continue;
+        }
+        if (sink.fd < 0 && !openSink(sink, now)) {
+            // 目录尚未就绪（如 service.sh 还没创建 logs），丢弃本批避免无限堆积
+            sink.pending.clear();
+            continue;
+        }
+
+        writeAll(sink.fd, sink.pending);
+        sink.size += sink.pending.size();
+        sink.pending.clear();
+
+        if (max_size > 0 && sink.size >= max_size) {
+            rotateSink(sink);
+        }
+    }
+}
+
+const char* UIEELogger::formatTimestamp(int64_t second) {
+    if (second != cached_second_) {
+        std::time_t time = static_cast<std::time_t>(second);
+        struct tm local;
+        localtime_r(&time, &local);
+        std::strftime(cached_timestamp_, sizeof(cached_timestamp_), "%Y-%m-%d %H:%M:%S", &local);
+        cached_second_ = second;
+    }
+    return cached_timestamp_;
+}
+
+bool UIEELogger::openSink(SinkFile& sink, int64_t now) {
+    // 打开失败后限制重试频率
+    if (sink.last_open_attempt != 0 && now - sink.last_open_attempt < 5) {
+        return false;
+    }
+    sink.last_open_attempt = now;
+
+    std::string path = log_dir_ + "/" + sink.name;
+    // O_APPEND 保证与 service.sh 的 >> 追加写互不覆盖
+    sink.fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+    if (sink.fd < 0) {
+        return false;
+    }
+
+    struct stat st;
+    sink.size = fstat(sink.fd, &st) == 0 ? static_cast<size_t>(st.st_size) : 0;
+    return true;
+}
+
+void UIEELogger::rotateSink(SinkFile& sink) {
+    std::string path = log_dir_ + "/" + sink.name;
+    std::string rotated = path + ".1";
+
+    ::close(sink.fd);
+    sink.fd = -1;
+    // 只保留一份历史文件
+    std::rename(path.c_str(), rotated.c_str());
+    sink.last_open_attempt = 0;
+    openSink(sink, currentSecond());
+}
+
+void UIEELogger::closeSinks() {
+    for (auto& sink : sinks_) {
+        if (sink.fd >= 0) {
+            ::close(sink.fd);
+            sink.fd = -1;
+        }
+    }
+}
+
+void UIEELogger::writeAll(int fd, const std::string& data) {
+    const char* p = data.data();
+    size_t remaining = data.size();
+    while (remaining > 0) {
+        ssize_t n = ::write(fd, p, remaining);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return;
+        }
+        p += n;
+        remaining -= static_cast<size_t>(n);
+    }
+}
+
+const char* UIEELogger::levelName(Level level) {
+    switch (level) {
+        case LEVEL_DEBUG: return "DEBUG";
+        case LEVEL_INFO: return "INFO";
+        case LEVEL_WARNING: return "WARNING";
+        case LEVEL_ERROR: return "ERROR";
+        case LEVEL_PERF: return "PERF";
+    }
+    return "INFO";
+}
@@ -0,0 +1,315 @@
+#include "uiee_engine.h"
+#include <new>
+#include <unordered_map>
+
+// 分级内存池实现
+// 小块：按2的幂分级（16B 起），从 64KB 整块切分，释放后挂回对应分级的空闲链表；
+// 大块：按精确大小缓存（monotonic arena 每一代请求的增长块大小是固定序列，命中率很高）。
+
+namespace {
+
+constexpr size_t kMinClassShift = 4;            // 最小分级 16 字节
+constexpr size_t kSlabSize = 64 * 1024;
+constexpr size_t kLargeAlignment = 64;
+constexpr size_t kHeaderSize = 16;               // 不带大小的 allocate() 所用的块头
+constexpr uint32_t kHeaderMagic = 0x55504d48;    // "UPMH"
+
+struct BlockHeader {
+    uint32_t magic;
+    uint32_t alignment;
+    uint64_t size;
+};
+static_assert(sizeof(BlockHeader) <= kHeaderSize, "块头超出预留空间");
+
+struct FreeNode {
+    FreeNode* next;
+};
+
+size_t roundUpPowerOfTwo(size_t value) {
+    size_t result = size_t(1) << kMinClassShift;
+    while (result < value) {
+        result <<= 1;
+    }
+    return result;
+}
+
+} // namespace
+
+class UIEECoreEngine::MemoryPoolManager::Impl {
+public:
+    class Resource : public std::pmr::memory_resource {
+    public:
+        explicit Resource(Impl* impl) : impl_(impl) {}
+
+    private:
+        Impl* impl_;
+
+        void* do_allocate(size_t bytes, size_t alignment) override {
+            return impl_->allocate(bytes, alignment);
+        }
+        void do_deallocate(void* ptr, size_t bytes, size_t alignment) override {
+            impl_->deallocate(ptr, bytes, alignment);
+        }
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+            return this == &other;
+        }
+    };
+
+    Impl(size_t block_size, size_t max_blocks)
+        : max_class_size_(roundUpPowerOfTwo(std::max<size_t>(block_size, 16))),
+          budget_(std::max<size_t>(block_size, 16) * std::max<size_t>(max_blocks, 1)),
+          resource_(this) {
+        size_t classes = 0;
+        for (size_t size = size_t(1) << kMinClassShift; size <= max_class_size_; size <<= 1) {
+            classes++;
+        }
+        free_lists_.assign(classes, nullptr);
+    }
+
+    ~Impl() {
+        for (char* slab : slabs_) {
+            ::operator delete(slab, std::align_val_t(kLargeAlignment));
+        }
+        for (auto& entry : large_cache_) {
+            for (void* ptr : entry.second) {
+                ::operator delete(ptr, std::align_val_t(kLargeAlignment));
+            }
+        }
+    }
+
+    void* allocate(size_t bytes, size_t alignment) {
+        if (bytes == 0) {
+            bytes = 1;
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        void* ptr = nullptr;
+        size_t class_size = roundUpPowerOfTwo(bytes);
+        // 分级块的对齐等于分级大小（不超过整块对齐），更高对齐要求走大块路径
+        if (class_size <= max_class_size_ && alignment <= std::min(class_size, kLargeAlignment)) {
+            ptr = allocateSmall(classIndex(class_size), class_size);
+            if (ptr) {
+                recordAllocation(class_size);
+                return ptr;
+            }
+        }
+
+        ptr = allocateLarge(bytes, alignment);
+        recordAllocation(bytes);
+        return ptr;
+    }
+
+    void deallocate(void* ptr, size_t bytes, size_t alignment) {
+        if (!ptr) {
+            return;
+        }
+        if (bytes == 0) {
+            bytes = 1;
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        size_t class_size = roundUpPowerOfTwo(bytes);
+        if (class_size <= max_class_size_ && ownsPointer(ptr)) {
+            FreeNode* node = static_cast<FreeNode*>(ptr);
+            size_t index = classIndex(class_size);
+            node->next = free_lists_[index];
+            free_lists_[index] = node;
+            cached_bytes_ += class_size;
+            recordRelease(class_size);
+            return;
+        }
+
+        deallocateLarge(ptr, bytes, alignment);
+        recordRelease(bytes);
+    }
+
+    size_t trim() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        size_t released = 0;
+        for (auto& entry : large_cache_) {
+            for (void* ptr : entry.second) {
+                ::operator delete(ptr, std::align_val_t(kLargeAlignment));
+                released += entry.first;
+            }
+        }
+        large_cache_.clear();
+        cached_bytes_ -= released;
+        large_cached_bytes_ = 0;
+        return released;
+    }
+
+    size_t inUse() const { std::lock_guard<std::mutex> lock(mutex_); return in_use_bytes_; }
+    size_t peak() const { std::lock_guard<std::mutex> lock(mutex_); return peak_bytes_; }
+    size_t active() const { std::lock_guard<std::mutex> lock(mutex_); return active_blocks_; }
+    size_t cached() const { std::lock_guard<std::mutex> lock(mutex_); return cached_bytes_; }
+    size_t systemAllocations() const { std::lock_guard<std::mutex> lock(mutex_); return system_allocations_; }
+
+    void resetStats() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        peak_bytes_ = in_use_bytes_;
+        system_allocations_ = 0;
+    }
+
+    std::pmr::memory_resource* resource() { return &resource_; }
+
+private:
+    size_t max_class_size_;
+    size_t budget_;                      // 整块与大块缓存的总上限
+    Resource resource_;
+
+    mutable std::mutex mutex_;
+    std::vector<FreeNode*> free_lists_;
+    std::vector<char*> slabs_;           // 按地址排序，用于判断指针归属
+    size_t slab_bytes_ = 0;
+    std::unordered_map<size_t, std::vector<void*>> large_cache_;
+    size_t large_cached_bytes_ = 0;
+
+    size_t in_use_bytes_ = 0;
+    size_t peak_bytes_ = 0;
+    size_t active_blocks_ = 0;
+    size_t cached_bytes_ = 0;
+    size_t system_allocations_ = 0;
+
+    static size_t classIndex(size_t class_size) {
+        size_t index = 0;
+        for (size_t size = size_t(1) << kMinClassShift; size < class_size; size <<= 1) {
+            index++;
+        }
+        return index;
+    }
+
+    void* allocateSmall(size_t index, size_t class_size) {
+        if (!free_lists_[index]) {
+            // 超出预算时不再新切整块，改走系统分配
+            if (slab_bytes_ + large_cached_bytes_ + kSlabSize > budget_) {
+                return nullptr;
+            }
+            char* slab = static_cast<char*>(::operator new(kSlabSize, std::align_val_t(kLargeAlignment)));
+            system_allocations_++;
+            slab_bytes_ += kSlabSize;
+            slabs_.insert(std::upper_bound(slabs_.begin(), slabs_.end(), slab), slab);
+
+            // 整块全部切给当前分级
+            for (size_t offset = kSlabSize; offset >= class_size; offset -= class_size) {
+                FreeNode* node = reinterpret_cast<FreeNode*>(slab + offset - class_size);
+                node->next = free_lists_[index];
+                free_lists_[index] = node;
+            }
+            cached_bytes_ += kSlabSize;
+        }
+
+        FreeNode* node = free_lists_[index];
+        free_lists_[index] = node->next;
+        cached_bytes_ -= class_size;
+        return node;
+    }
+
+    void* allocateLarge(size_t bytes, size_t alignment) {
+        if (alignment <= kLargeAlignment) {
+            auto it = large_cache_.find(bytes);
+            if (it != large_cache_.end() && !it->second.empty()) {
+                void* ptr = it->second.back();
+                it->second.pop_back();
+                large_cached_bytes_ -= bytes;
+                cached_bytes_ -= bytes;
+                return ptr;
+            }
+        }
+        system_allocations_++;
+        return ::operator new(bytes, std::align_val_t(std::max(alignment, kLargeAlignment)));
+    }
+
+    void deallocateLarge(void* ptr, size_t bytes, size_t alignment) {
+        if (alignment <= kLargeAlignment && slab_bytes_ + large_cached_bytes_ + bytes <= budget_) {
+            large_cache_[bytes].push_back(ptr);
+            large_cached_bytes_ += bytes;
+            cached_bytes_ += bytes;
+            return;
+        }
+        ::operator delete(ptr, std::align_val_t(std::max(alignment, kLargeAlignment)));
+    }
+
+    bool ownsPointer(const void* ptr) const {
+        const char* address = static_cast<const char*>(ptr);
+        auto it = std::upper_bound(slabs_.begin(), slabs_.end(), address,
+                                   [](const char* value, const char* slab) { return value < slab; });
+        if (it == slabs_.begin()) {
+            return false;
+        }
+        --it;
+        return address < *it + kSlabSize;
+    }
+
+    void recordAllocation(size_t bytes) {
+        in_use_bytes_ += bytes;
+        active_blocks_++;
+        peak_bytes_ = std::max(peak_bytes_, in_use_bytes_);
+    }
+
+    void recordRelease(size_t bytes) {
+        in_use_bytes_ -= std::min(in_use_bytes_, bytes);
+        if (active_blocks_ > 0) {
+            active_blocks_--;
+        }
+    }
+};
+
+UIEECoreEngine::MemoryPoolManager::MemoryPoolManager(size_t block_size, size_t max_blocks)
+    : impl_(std::make_unique<Impl>(block_size, max_blocks)) {}
+
+UIEECoreEngine::MemoryPoolManager::~MemoryPoolManager() = default;
+
+void* UIEECoreEngine::MemoryPoolManager::allocate(size_t size) {
+    // 块头记录原始大小，deallocate 时按相同大小归还
+    char* block = static_cast<char*>(impl_->allocate(size + kHeaderSize, kHeaderSize));
+    BlockHeader* header = reinterpret_cast<BlockHeader*>(block);
+    header->magic = kHeaderMagic;
+    header->alignment = static_cast<uint32_t>(kHeaderSize);
+    header->size = size + kHeaderSize;
+    return block + kHeaderSize;
+}
+
+void UIEECoreEngine::MemoryPoolManager::deallocate(void* ptr) {
+    if (!ptr) {
+        return;
+    }
+    char* block = static_cast<char*>(ptr) - kHeaderSize;
+    BlockHeader* header = reinterpret_cast<BlockHeader*>(block);
+    if (header->magic != kHeaderMagic) {
+        return;  // 不是本池分配的指针
+    }
+    header->magic = 0;
+    impl_->deallocate(block, static_cast<size_t>(header->size), header->alignment);
+}
+
+std::pmr::memory_resource* UIEECoreEngine::MemoryPoolManager::resource() {
+    return impl_->resource();
+}
+
+size_t UIEECoreEngine::MemoryPoolManager::trim() {
+    return impl_->trim();
+}
+
+size_t UIEECoreEngine::MemoryPoolManager::getTotalAllocated() const {
+    return impl_->inUse();
+}
+
+size_t UIEECoreEngine::MemoryPoolManager::getPeakUsage() const {
+    return impl_->peak();
+}
+
+size_t UIEECoreEngine::MemoryPoolManager::getActiveBlocks() const {
+    return impl_->active();
+}
+
+size_t UIEECoreEngine::MemoryPoolManager::getCachedBytes() const {
+    return impl_->cached();
+}
+
+size_t UIEECoreEngine::MemoryPoolManager::getSystemAllocations() const {
+    return impl_->systemAllocations();
+}
+
+void UIEECoreEngine::MemoryPoolManager::resetStats() {
+    impl_->resetStats();
+}
@@ -0,0 +1,378 @@
+#include "uiee_nash.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+// 纳什均衡求解器实现
+// 支撑集枚举：对每对等大小的支撑集解无差异方程组，检验非负性与最优反应条件，适合每方不超过几个策略的博弈；
+// regret matching+：交替更新、线性加权平均，每轮 O(rows × cols)，用于大规模或退化博弈。
+
+namespace {
+
+constexpr double kSupportEpsilon = 1e-9;
+constexpr int kExploitabilityCheckInterval = 16;
+
+// 字典序的下一个 k 组合，已是最后一个时返回 false
+bool nextCombination(std::vector<size_t>& combination, size_t n) {
+    size_t k = combination.size();
+    for (size_t i = k; i-- > 0;) {
+        if (combination[i] < n - k + i) {
+            combination[i]++;
+            for (size_t j = i + 1; j < k; ++j) {
+                combination[j] = combination[j - 1] + 1;
+            }
+            return true;
+        }
+    }
+    return false;
+}
+
+// 正遗憾归一化为策略，全部为零时取均匀分布
+void regretToStrategy(const std::vector<double>& regret, std::vector<double>& strategy) {
+    double total = 0.0;
+    for (double value : regret) {
+        total += value;
+    }
+    if (total <= 0.0) {
+        std::fill(strategy.begin(), strategy.end(), 1.0 / strategy.size());
+        return;
+    }
+    for (size_t i = 0; i < regret.size(); ++i) {
+        strategy[i] = regret[i] / total;
+    }
+}
+
+void normalize(std::vector<double>& values) {
+    double total = std::accumulate(values.begin(), values.end(), 0.0);
+    if (total <= 0.0) {
+        std::fill(values.begin(), values.end(), 1.0 / values.size());
+        return;
+    }
+    for (double& value : values) {
+        value /= total;
+    }
+}
+
+double payoffRange(const UIEEPayoffMatrix& row_payoff, const UIEEPayoffMatrix& col_payoff) {
+    double low = std::numeric_limits<double>::max();
+    double high = std::numeric_limits<double>::lowest();
+    for (size_t i = 0; i < row_payoff.rows(); ++i) {
+        for (size_t j = 0; j < row_payoff.cols(); ++j) {
+            low = std::min({low, row_payoff.at(i, j), col_payoff.at(i, j)});
+            high = std::max({high, row_payoff.at(i, j), col_payoff.at(i, j)});
+        }
+    }
+    return high - low;
+}
+
+} // namespace
+
+UIEEPayoffMatrix UIEEPayoffMatrix::fromRows(const std::vector<std::vector<double>>& rows) {
+    size_t cols = 0;
+    for (const auto& row : rows) {
+        cols = std::max(cols, row.size());
+    }
+    UIEEPayoffMatrix matrix(rows.size(), cols);
+    for (size_t i = 0; i < rows.size(); ++i) {
+        std::copy(rows[i].begin(), rows[i].end(), matrix.row(i));
+    }
+    return matrix;
+}
+
+UIEEPayoffMatrix UIEEPayoffMatrix::transposed() const {
+    UIEEPayoffMatrix matrix(cols_, rows_);
+    for (size_t i = 0; i < rows_; ++i) {
+        for (size_t j = 0; j < cols_; ++j) {
+            matrix.at(j, i) = at(i, j);
+        }
+    }
+    return matrix;
+}
+
+double UIEENashSolver::exploitability(const UIEEPayoffMatrix& row_payoff, const UIEEPayoffMatrix& col_payoff,
+                                      const double* x, const double* y,
+                                      double* row_value, double* col_value) {
+    size_t rows = row_payoff.rows();
+    size_t cols = row_payoff.cols();
+
+    // 行玩家：各纯策略对 y 的收益 (A y)_i
+    double row_expected = 0.0;
+    double row_best = std::numeric_limits<double>::lowest();
+    for (size_t i = 0; i < rows; ++i) {
+        const double* a = row_payoff.row(i);
+        double utility = 0.0;
+        for (size_t j = 0; j < cols; ++j) {
+            utility += a[j] * y[j];
+        }
+        row_expected += x[i] * utility;
+        row_best = std::max(row_best, utility);
+    }
+
+    // 列玩家：各纯策略对 x 的收益 (x^T B)_j
+    double col_expected = 0.0;
+    double col_best = std::numeric_limits<double>::lowest();
+    for (size_t j = 0; j < cols; ++j) {
+        double utility = 0.0;
+        for (size_t i = 0; i < rows; ++i) {
+            utility += x[i] * col_payoff.at(i, j);
+        }
+        col_expected += y[j] * utility;
+        col_best = std::max(col_best, utility);
+    }
+
+    if (row_value) {
+        *row_value = row_expected;
+    }
+    if (col_value) {
+        *col_value = col_expected;
+    }
+    return std::max(0.0, row_best - row_expected) + std::max(0.0, col_best - col_expected);
+}
+
+bool UIEENashSolver::solve(const UIEEPayoffMatrix& row_payoff, const UIEEPayoffMatrix& col_payoff, Result& result) {
+    size_t rows = row_payoff.rows();
+    size_t cols = row_payoff.cols();
+    if (rows == 0 || cols == 0 || col_payoff.rows() != rows || col_payoff.cols() != cols) {
+        return false;
+    }
+
+    double tolerance = tolerance_ * std::max(1.0, payoffRange(row_payoff, col_payoff));
+    bool warm = previous_.row_strategy.size() == rows && previous_.col_strategy.size() == cols;
+
+    // 热启动：上一 tick 的均衡仍满足精度时直接沿用
+    if (warm) {
+        double row_value = 0.0;
+        double col_value = 0.0;
+        double epsilon = exploitability(row_payoff, col_payoff, previous_.row_strategy.data(),
+                                        previous_.col_strategy.data(), &row_value, &col_value);
+        if (epsilon <= tolerance) {
+            previous_.row_value = row_value;
+            previous_.col_value = col_value;
+            previous_.exploitability = epsilon;
+            result = previous_;
+            result.iterations = 0;
+            result.warm_started = true;
+            return true;
+        }
+    }
+
+    std::vector<double> x(rows, 0.0);
+    std::vector<double> y(cols, 0.0);
+    result.exact = false;
+    result.iterations = 0;
+    if (rows <= SUPPORT_ENUMERATION_LIMIT && cols <= SUPPORT_ENUMERATION_LIMIT &&
+        supportEnumeration(row_payoff, col_payoff, x, y)) {
+        result.exact = true;
+    } else {
+        result.iterations = regretMatching(row_payoff, col_payoff, warm ? &previous_ : nullptr, x, y);
+    }
+
+    result.warm_started = warm && !result.exact;
+    result.exploitability = exploitability(row_payoff, col_payoff, x.data(), y.data(),
+                                           &result.row_value, &result.col_value);
+    result.row_strategy = std::move(x);
+    result.col_strategy = std::move(y);
+    previous_ = result;
+    return true;
+}
+
+bool UIEENashSolver::supportEnumeration(const UIEEPayoffMatrix& row_payoff, const UIEEPayoffMatrix& col_payoff,
+                                        std::vector<double>& x, std::vector<double>& y) {
+    size_t rows = row_payoff.rows();
+    size_t cols = row_payoff.cols();
+    std::vector<double> row_mix;
+    std::vector<double> col_mix;
+
+    // 按支撑集从小到大枚举，纯策略均衡优先
+    for (size_t k = 1; k <= std::min(rows, cols); ++k) {
+        row_support_.resize(k);
+        std::iota(row_support_.begin(), row_support_.end(), size_t(0));
+        do {
+            col_support_.resize(k);
+            std::iota(col_support_.begin(), col_support_.end(), size_t(0));
+            do {
+                // 列玩家的混合使行玩家在 row_support_ 上无差异，反之亦然
+                if (!solveIndifference(row_payoff, false, row_support_, col_support_, col_mix) ||
+                    !solveIndifference(col_payoff, true, col_support_, row_support_, row_mix)) {
+                    continue;
+                }
+
+                std::fill(x.begin(), x.end(), 0.0);
+                std::fill(y.begin(), y.end(), 0.0);
+                for (size_t s = 0; s < k; ++s) {
+                    x[row_support_[s]] = row_mix[s];
+                    y[col_support_[s]] = col_mix[s];
+                }
+
+                // 支撑集外的纯策略不能带来更高收益
+                if (exploitability(row_payoff, col_payoff, x.data(), y.data()) <= kSupportEpsilon * k) {
+                    return true;
+                }
+            } while (nextCombination(col_support_, cols));
+        } while (nextCombination(row_support_, rows));
+    }
+    return false;
+}
+
+bool UIEENashSolver::solveIndifference(const UIEEPayoffMatrix& payoff, bool transpose,
+                                       const std::vector<size_t>& own_support,
+                                       const std::vector<size_t>& other_support,
+                                       std::vector<double>& mix) {
+    // 未知量为对手在 other_support 上的概率 p 与无差异收益 v：
+    //   Σ_b payoff(a, b) p_b - v = 0  (a ∈ own_support)
+    //   Σ_b p_b = 1
+    size_t k = own_support.size();
+    size_t n = k + 1;
+    size_t width = n + 1;
+    system_.assign(n * width, 0.0);
+    for (size_t r = 0; r < k; ++r) {
+        for (size_t c = 0; c < k; ++c) {
+            size_t a = own_support[r];
+            size_t b = other_support[c];
+            system_[r * width + c] = transpose ? payoff.at(b, a) : payoff.at(a, b);
+        }
+        system_[r * width + k] = -1.0;
+    }
+    for (size_t c = 0; c < k; ++c) {
+        system_[k * width + c] = 1.0;
+    }
+    system_[k * width + n] = 1.0;
+
+    // 列主元高斯消元
+    for (size_t col = 0; col < n; ++col) {
+        size_t pivot = col;
+        for (size_t r = col + 1; r < n; ++r) {
+            if (std::fabs(system_[r * width + col]) > std::fabs(system_[pivot * width + col])) {
+                pivot = r;
+            }
+        }
+        if (std::fabs(system_[pivot * width + col]) < kSupportEpsilon) {
+            return false;   // 奇异：退化博弈交给迭代求解
+        }
+        if (pivot != col) {
+            std::swap_ranges(system_.begin() + pivot * width, system_.begin() + (pivot + 1) * width,
+                             system_.begin() + col * width);
+        }
+        for (size_t r = 0; r < n; ++r) {
+            if (r == col) {
+                continue;
+            }
+            double factor = system_[r * width + col] / system_[col * width + col];
+            if (factor == 0.0) {
+                continue;
+            }
+            for (size_t c = col; c < width; ++c) {
+                system_[r * width + c] -= factor * system_[col * width + c];
+            }
+        }
+    }
+
+    mix.resize(k);
+    for (size_t c = 0; c < k; ++c) {
+        double probability = system_[c * width + n] / system_[c * width + c];
+        if (probability < -kSupportEpsilon) {
+            return false;
+        }
+        mix[c] = std::max(0.0, probability);
+    }
+    return true;
+}
+
+int UIEENashSolver::regretMatching(const UIEEPayoffMatrix& row_payoff, const UIEEPayoffMatrix& col_payoff,
+                                   const Result* warm, std::vector<double>& x, std::vector<double>& y) {
+    size_t rows = row_payoff.rows();
+    size_t cols = row_payoff.cols();
+    double tolerance = tolerance_ * std::max(1.0, payoffRange(row_payoff, col_payoff));
+
+    utilities_.resize(std::max(rows, cols));
+    row_current_.resize(rows);
+    col_current_.resize(cols);
+    row_average_.resize(rows);
+    col_average_.resize(cols);
+
+    // 热启动：沿用上次迭代累积的遗憾，平均策略以上次均衡为先验，
+    // 先验权重等于上次迭代的线性权重之和的一半，使新迭代很快占主导但不会从均匀分布重来
+    int offset = 0;
+    if (warm && row_regret_.size() == rows && col_regret_.size() == cols) {
+        offset = warm->iterations / 2;
+        double weight = 0.5 * offset * (offset + 1);
+        for (size_t i = 0; i < rows; ++i) {
+            row_average_[i] = warm->row_strategy[i] * weight;
+        }
+        for (size_t j = 0; j < cols; ++j) {
+            col_average_[j] = warm->col_strategy[j] * weight;
+        }
+    } else {
+        row_regret_.assign(rows, 0.0);
+        col_regret_.assign(cols, 0.0);
+        std::fill(row_average_.begin(), row_average_.end(), 0.0);
+        std::fill(col_average_.begin(), col_average_.end(), 0.0);
+    }
+    regretToStrategy(row_regret_, row_current_);
+    regretToStrategy(col_regret_, col_current_);
+
+    int iteration = 0;
+    while (iteration < max_iterations_) {
+        iteration++;
+        double weight = static_cast<double>(offset + iteration);
+
+        // 行玩家对当前 y 更新遗憾
+        double expected = 0.0;
+        for (size_t i = 0; i < rows; ++i) {
+            const double* a = row_payoff.row(i);
+            double utility = 0.0;
+            for (size_t j = 0; j < cols; ++j) {
+                utility += a[j] * col_current_[j];
+            }
+            utilities_[i] = utility;
+            expected += row_current_[i] * utility;
+        }
+        for (size_t i = 0; i < rows; ++i) {
+            row_regret_[i] = std::max(0.0, row_regret_[i] + utilities_[i] - expected);
+        }
+        regretToStrategy(row_regret_, row_current_);
+
+        // 列玩家对更新后的 x 更新遗憾（交替更新）
+        std::fill(utilities_.begin(), utilities_.begin() + cols, 0.0);
+        for (size_t i = 0; i < rows; ++i) {
+            const double* b = col_payoff.row(i);
+            double probability = row_current_[i];
+            for (size_t j = 0; j < cols; ++j) {
+                utilities_[j] += probability * b[j];
+            }
+        }
+        expected = 0.0;
+        for (size_t j = 0; j < cols; ++j) {
+            expected += col_current_[j] * utilities_[j];
+        }
+        for (size_t j = 0; j < cols; ++j) {
+            col_regret_[j] = std::max(0.0, col_regret_[j] + utilities_[j] - expected);
+        }
+        regretToStrategy(col_regret_, col_current_);
+
+        // 线性加权平均：后期迭代权重更高
+        for (size_t i = 0; i < rows; ++i) {
+            row_average_[i] += weight * row_current_[i];
+        }
+        for (size_t j = 0; j < cols; ++j) {
+            col_average_[j] += weight * col_current_[j];
+        }
+
+        if (iteration % kExploitabilityCheckInterval == 0) {
+            x = row_average_;
+            y = col_average_;
+            normalize(x);
+            normalize(y);
+            if (exploitability(row_payoff, col_payoff, x.data(), y.data()) <= tolerance) {
+                return iteration;
+            }
+        }
+    }
+
+    x = row_average_;
+    y = col_average_;
+    normalize(x);
+    normalize(y);
+    return iteration;
+}
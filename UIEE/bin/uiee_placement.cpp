@@ -0,0 +1,585 @@
+#include "uiee_placement.h"
+#include <algorithm>
+#include <cstdio>
+#include <dirent.h>
+#include <sched.h>
+#include <sys/resource.h>
+
+#ifdef __linux__
+#include <sys/syscall.h>
+#endif
+
+// 任务放置策略实现
+
+namespace {
+
+#ifdef __linux__
+// glibc/bionic 均未导出 sched_setattr，按内核 uapi 定义（SCHED_ATTR_SIZE_VER1）
+struct SchedAttr {
+    uint32_t size;
+    uint32_t sched_policy;
+    uint64_t sched_flags;
+    int32_t sched_nice;
+    uint32_t sched_priority;
+    uint64_t sched_runtime;
+    uint64_t sched_deadline;
+    uint64_t sched_period;
+    uint32_t sched_util_min;
+    uint32_t sched_util_max;
+};
+
+constexpr uint64_t kSchedFlagKeepPolicy   = 0x08;
+constexpr uint64_t kSchedFlagKeepParams   = 0x10;
+constexpr uint64_t kSchedFlagUtilClampMin = 0x20;
+constexpr uint64_t kSchedFlagUtilClampMax = 0x40;
+
+// ioprio 的 uapi 定义（linux/ioprio.h 未随 libc 导出）
+constexpr int kIoprioWhoProcess = 1;
+constexpr int kIoprioClassShift = 13;
+constexpr int kIoprioClassBestEffort = 2;
+constexpr int kIoprioClassIdle = 3;
+#endif
+
+// 各档位的簇、分组与 uclamp
+struct TierPolicy {
+    UIEECpuTopology::ClusterType primary;
+    bool include_big;                              // 同时放开大核（超大核只有一两个时避免挤在一起）
+    UIEEPlacementEngine::CgroupGroup group;
+    uint16_t uclamp_min;
+    uint16_t uclamp_max;
+};
+
+const TierPolicy kTierPolicies[UIEEPlacementEngine::TIER_COUNT] = {
+    {UIEECpuTopology::CLUSTER_LITTLE, false, UIEEPlacementEngine::GROUP_UNKNOWN, 0, UIEEPlacementEngine::UCLAMP_MAX_VALUE},
+    {UIEECpuTopology::CLUSTER_LITTLE, false, UIEEPlacementEngine::GROUP_BACKGROUND, 0, 512},
+    {UIEECpuTopology::CLUSTER_BIG, false, UIEEPlacementEngine::GROUP_TOP_APP, 0, UIEEPlacementEngine::UCLAMP_MAX_VALUE},
+    {UIEECpuTopology::CLUSTER_PRIME, true, UIEEPlacementEngine::GROUP_TOP_APP, 512, UIEEPlacementEngine::UCLAMP_MAX_VALUE},
+};
+
+int popcount(uint32_t mask) {
+    return __builtin_popcount(mask);
+}
+
+bool isDigits(const char* name) {
+    if (*name == '\0') {
+        return false;
+    }
+    for (; *name; ++name) {
+        if (*name < '0' || *name > '9') {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+UIEEPlacementEngine::UIEEPlacementEngine(const UIEECpuTopology& topology)
+    : topology_(topology), max_bound_cores_(0), avoid_prime_(false), cpuset_groups_(0), cpuctl_groups_(0),
+      uclamp_supported_(true), ioprio_supported_(true) {
+    for (int i = 0; i < GROUP_COUNT; ++i) {
+        cpuset_[i].cpu_mask = 0;
+        cpuset_[i].procs_fd = -1;
+        cpuctl_fd_[i] = -1;
+    }
+}
+
+const char* UIEEPlacementEngine::groupName(CgroupGroup group) {
+    switch (group) {
+        case GROUP_ROOT: return "";
+        case GROUP_TOP_APP: return "top-app";
+        case GROUP_FOREGROUND: return "foreground";
+        case GROUP_BACKGROUND: return "background";
+        case GROUP_SYSTEM_BACKGROUND: return "system-background";
+        default: return nullptr;
+    }
+}
+
+const char* UIEEPlacementEngine::tierName(Tier tier) {
+    switch (tier) {
+        case TIER_BACKGROUND: return "background";
+        case TIER_INTERACTIVE: return "interactive";
+        case TIER_PERFORMANCE: return "performance";
+        default: return "default";
+    }
+}
+
+const char* UIEEPlacementEngine::ioClassName(IoClass io_class) {
+    switch (io_class) {
+        case IO_FOREGROUND: return "foreground";
+        case IO_BACKGROUND: return "background";
+        case IO_IDLE: return "idle";
+        default: return "default";
+    }
+}
+
+UIEEPlacementEngine::CgroupGroup UIEEPlacementEngine::parseGroupName(const char* path, size_t length) {
+    // 传入 "/top-app" 形式的分组路径（不含换行）
+    while (length > 0 && (path[length - 1] == '\n' || path[length - 1] == '/')) {
+        length--;
+    }
+    if (length > 0 && path[0] == '/') {
+        path++;
+        length--;
+    }
+    for (int i = 0; i < GROUP_COUNT; ++i) {
+        const char* name = groupName(static_cast<CgroupGroup>(i));
+        if (strlen(name) == length && memcmp(name, path, length) == 0) {
+            return static_cast<CgroupGroup>(i);
+        }
+    }
+    return GROUP_UNKNOWN;
+}
+
+void UIEEPlacementEngine::closeGroups() {
+    for (int i = 0; i < GROUP_COUNT; ++i) {
+        cpuset_[i].cpus_file.close();
+        cpuset_[i].cpu_mask = 0;
+        if (cpuset_[i].procs_fd >= 0) {
+            ::close(cpuset_[i].procs_fd);
+            cpuset_[i].procs_fd = -1;
+        }
+        if (cpuctl_fd_[i] >= 0) {
+            ::close(cpuctl_fd_[i]);
+            cpuctl_fd_[i] = -1;
+        }
+    }
+    cpuset_groups_ = 0;
+    cpuctl_groups_ = 0;
+}
+
+bool UIEEPlacementEngine::discover(const std::string& cpuset_root, const std::string& cpuctl_root) {
+    closeGroups();
+    applied_.clear();
+
+    for (int i = 0; i < GROUP_COUNT; ++i) {
+        std::string name = groupName(static_cast<CgroupGroup>(i));
+        std::string dir = name.empty() ? cpuset_root : cpuset_root + "/" + name;
+
+        Group& group = cpuset_[i];
+        group.procs_fd = ::open((dir + "/cgroup.procs").c_str(), O_WRONLY | O_CLOEXEC);
+        if (group.procs_fd < 0) {
+            continue;
+        }
+        // 旧内核的 cpuset 节点名带 "cpuset." 前缀，挂载选项 noprefix 时则没有
+        if (!group.cpus_file.open(dir + "/cpuset.cpus") && !group.cpus_file.open(dir + "/cpus")) {
+            ::close(group.procs_fd);
+            group.procs_fd = -1;
+            continue;
+        }
+        cpuset_groups_ |= 1u << i;
+        groupCpus(static_cast<CgroupGroup>(i));
+    }
+
+    for (int i = 0; i < GROUP_COUNT; ++i) {
+        std::string name = groupName(static_cast<CgroupGroup>(i));
+        std::string dir = name.empty() ? cpuctl_root : cpuctl_root + "/" + name;
+        cpuctl_fd_[i] = ::open((dir + "/cgroup.procs").c_str(), O_WRONLY | O_CLOEXEC);
+        if (cpuctl_fd_[i] >= 0) {
+            cpuctl_groups_ |= 1u << i;
+        }
+    }
+
+    return cpuset_groups_ != 0;
+}
+
+uint32_t UIEEPlacementEngine::groupCpus(CgroupGroup group) {
+    // 系统可能在开机后调整分组的CPU范围，每次使用前重新读取（常驻fd，一次 pread）
+    Group& entry = cpuset_[group];
+    char buffer[64];
+    ssize_t n = entry.cpus_file.read(buffer, sizeof(buffer));
+    if (n > 0) {
+        entry.cpu_mask = UIEECpuTopology::parseCpuList(buffer, static_cast<size_t>(n));
+    }
+    return entry.cpu_mask;
+}
+
+uint32_t UIEEPlacementEngine::boundMask(uint32_t mask, const UIEESystemSampler::CpuSample& sample,
+                                        uint32_t current_mask) const {
+    if (max_bound_cores_ <= 0 || popcount(mask) <= max_bound_cores_) {
+        return mask;
+    }
+
+    auto coreLoad = [&sample](int cpu) {
+        return cpu < sample.core_count ? sample.core_usage[cpu] : 0.0;
+    };
+    auto coreOnline = [&sample](int cpu) {
+        return cpu < sample.core_count ? sample.core_online[cpu] : sample.core_count == 0;
+    };
+
+    // 在目标范围内取负载最低的 max_bound_cores 个在线核心，负载相同时优先容量大的
+    int candidates[MAX_CPU_CORES];
+    int count = 0;
+    for (int cpu = 0; cpu < MAX_CPU_CORES; ++cpu) {
+        if ((mask & (1u << cpu)) && coreOnline(cpu)) {
+            candidates[count++] = cpu;
+        }
+    }
+    if (count <= max_bound_cores_) {
+        return mask;
+    }
+    std::sort(candidates, candidates + count, [&](int a, int b) {
+        double load_a = coreLoad(a);
+        double load_b = coreLoad(b);
+        if (load_a != load_b) {
+            return load_a < load_b;
+        }
+        return topology_.coreCapacity(a) > topology_.coreCapacity(b);
+    });
+
+    uint32_t best = 0;
+    double best_load = 0.0;
+    for (int i = 0; i < max_bound_cores_; ++i) {
+        best |= 1u << candidates[i];
+        best_load += coreLoad(candidates[i]);
+    }
+
+    // 已下发的掩码仍在目标范围内、核心数相同且总负载差距不大时保持不动，避免负载抖动导致每tick迁移
+    static constexpr double kRebindHysteresis = 20.0;
+    if (current_mask != 0 && (current_mask & ~mask) == 0 && popcount(current_mask) == max_bound_cores_) {
+        double current_load = 0.0;
+        bool online = true;
+        for (int cpu = 0; cpu < MAX_CPU_CORES; ++cpu) {
+            if (current_mask & (1u << cpu)) {
+                online &= coreOnline(cpu);
+                current_load += coreLoad(cpu);
+            }
+        }
+        if (online && current_load <= best_load + kRebindHysteresis) {
+            return current_mask;
+        }
+    }
+    return best;
+}
+
+UIEEPlacementEngine::Placement UIEEPlacementEngine::decide(Tier tier, const UIEESystemSampler::CpuSample& sample,
+                                                           uint32_t current_mask) const {
+    const TierPolicy& policy = kTierPolicies[tier < TIER_COUNT ? tier : TIER_DEFAULT];
+
+    Placement placement;
+    placement.tier = tier;
+    placement.group = policy.group;
+    placement.uclamp_min = policy.uclamp_min;
+    placement.uclamp_max = policy.uclamp_max;
+    placement.cpu_mask = 0;
+
+    if (tier == TIER_DEFAULT || topology_.clusterCount() == 0) {
+        return placement;
+    }
+
+    auto primary = policy.primary;
+    if (avoid_prime_ && primary == UIEECpuTopology::CLUSTER_PRIME) {
+        primary = UIEECpuTopology::CLUSTER_BIG;
+    }
+    uint32_t mask = topology_.clusterMask(primary);
+    if (policy.include_big) {
+        mask |= topology_.clusterMask(UIEECpuTopology::CLUSTER_BIG);
+    }
+    // 同构CPU上按簇限制没有意义，只保留核心数限制
+    if (topology_.clusterCount() == 1) {
+        mask = topology_.cluster(0).cpu_mask;
+    }
+    placement.cpu_mask = boundMask(mask, sample, current_mask);
+    return placement;
+}
+
+UIEEPlacementEngine::CgroupGroup UIEEPlacementEngine::currentGroup(int pid, bool cpuctl) const {
+    char path[48];
+    snprintf(path, sizeof(path), cpuctl ? "/proc/%d/cgroup" : "/proc/%d/cpuset", pid);
+    UIEEProcFile file(path);
+    char buffer[512];
+    ssize_t n = file.read(buffer, sizeof(buffer));
+    if (n <= 0) {
+        return GROUP_UNKNOWN;
+    }
+    if (!cpuctl) {
+        return parseGroupName(buffer, static_cast<size_t>(n));
+    }
+
+    // /proc/<pid>/cgroup 每行为 "层级:控制器列表:路径"，找控制器列表中含 cpu 的 v1 层级
+    const char* line = buffer;
+    const char* end = buffer + n;
+    while (line < end) {
+        const char* eol = static_cast<const char*>(memchr(line, '\n', end - line));
+        if (eol == nullptr) {
+            eol = end;
+        }
+        const char* first = static_cast<const char*>(memchr(line, ':', eol - line));
+        const char* second = first ? static_cast<const char*>(memchr(first + 1, ':', eol - first - 1)) : nullptr;
+        if (second != nullptr) {
+            const char* item = first + 1;
+            while (item < second) {
+                const char* comma = static_cast<const char*>(memchr(item, ',', second - item));
+                const char* item_end = comma ? comma : second;
+                if (item_end - item == 3 && memcmp(item, "cpu", 3) == 0) {
+                    return parseGroupName(second + 1, static_cast<size_t>(eol - second - 1));
+                }
+                item = item_end + 1;
+            }
+        }
+        line = eol + 1;
+    }
+    return GROUP_UNKNOWN;
+}
+
+bool UIEEPlacementEngine::moveToGroup(int fd, int pid, Stats& stats) {
+    char text[16];
+    int length = snprintf(text, sizeof(text), "%d", pid);
+    stats.syscalls++;
+    if (::write(fd, text, static_cast<size_t>(length)) == length) {
+        stats.cgroup_moves++;
+        return true;
+    }
+    if (errno != ESRCH) {
+        recordFailure(stats, errno);
+    }
+    return false;
+}
+
+template <typename Fn>
+int UIEEPlacementEngine::forEachThread(int pid, Fn fn) const {
+    char path[32];
+    snprintf(path, sizeof(path), "/proc/%d/task", pid);
+    DIR* dir = opendir(path);
+    if (dir == nullptr) {
+        return -1;
+    }
+    int threads = 0;
+    struct dirent* entry;
+    while ((entry = readdir(dir)) != nullptr) {
+        if (!isDigits(entry->d_name)) {
+            continue;
+        }
+        fn(atoi(entry->d_name));
+        threads++;
+    }
+    closedir(dir);
+    return threads;
+}
+
+bool UIEEPlacementEngine::setThreadAffinity(int tid, uint32_t cpu_mask, Stats& stats) {
+#ifdef __linux__
+    cpu_set_t mask;
+    CPU_ZERO(&mask);
+    if (cpu_mask == 0) {
+        long cores = std::max<long>(topology_.coreCount(), sysconf(_SC_NPROCESSORS_CONF));
+        for (long c = 0; c < cores && c < CPU_SETSIZE; ++c) {
+            CPU_SET(c, &mask);
+        }
+    } else {
+        for (int c = 0; c < 32; ++c) {
+            if (cpu_mask & (1u << c)) {
+                CPU_SET(c, &mask);
+            }
+        }
+    }
+    stats.syscalls++;
+    if (sched_setaffinity(tid, sizeof(mask), &mask) == 0) {
+        return true;
+    }
+    // 线程在遍历期间退出不算失败
+    if (errno != ESRCH) {
+        recordFailure(stats, errno);
+    }
+    return false;
+#else
+    (void)tid; (void)cpu_mask; (void)stats;
+    return false;
+#endif
+}
+
+bool UIEEPlacementEngine::setThreadUclamp(int tid, uint16_t min_value, uint16_t max_value, Stats& stats) {
+#if defined(__linux__) && defined(SYS_sched_setattr)
+    if (!uclamp_supported_) {
+        return false;
+    }
+    SchedAttr attr = {};
+    attr.size = sizeof(attr);
+    attr.sched_flags = kSchedFlagKeepPolicy | kSchedFlagKeepParams | kSchedFlagUtilClampMin | kSchedFlagUtilClampMax;
+    attr.sched_util_min = min_value;
+    attr.sched_util_max = max_value;
+    stats.syscalls++;
+    if (syscall(SYS_sched_setattr, tid, &attr, 0) == 0) {
+        return true;
+    }
+    // 内核不支持 uclamp（未开启 CONFIG_UCLAMP_TASK 或版本过低）时不再尝试
+    if (errno == EINVAL || errno == E2BIG || errno == ENOSYS || errno == EOPNOTSUPP) {
+        uclamp_supported_ = false;
+    } else if (errno != ESRCH) {
+        recordFailure(stats, errno);
+    }
+    return false;
+#else
+    (void)tid; (void)min_value; (void)max_value; (void)stats;
+    return false;
+#endif
+}
+
+bool UIEEPlacementEngine::setThreadNice(int tid, int nice_value, Stats& stats) {
+#ifdef __linux__
+    // Linux 上 PRIO_PROCESS 按线程ID生效，只影响该线程
+    stats.syscalls++;
+    if (setpriority(PRIO_PROCESS, tid, nice_value) == 0) {
+        return true;
+    }
+    if (errno != ESRCH) {
+        recordFailure(stats, errno);
+    }
+    return false;
+#else
+    (void)tid; (void)nice_value; (void)stats;
+    return false;
+#endif
+}
+
+bool UIEEPlacementEngine::setThreadIoClass(int tid, IoClass io_class, Stats& stats) {
+#if defined(__linux__) && defined(SYS_ioprio_set)
+    if (!ioprio_supported_) {
+        return false;
+    }
+    int value = 0;
+    switch (io_class) {
+        case IO_FOREGROUND: value = kIoprioClassBestEffort << kIoprioClassShift; break;
+        case IO_BACKGROUND: value = (kIoprioClassBestEffort << kIoprioClassShift) | 7; break;
+        case IO_IDLE: value = kIoprioClassIdle << kIoprioClassShift; break;
+        default: break;
+    }
+    stats.syscalls++;
+    if (syscall(SYS_ioprio_set, kIoprioWhoProcess, tid, value) == 0) {
+        return true;
+    }
+    if (errno == ENOSYS) {
+        ioprio_supported_ = false;
+    } else if (errno != ESRCH) {
+        recordFailure(stats, errno);
+    }
+    return false;
+#else
+    (void)tid; (void)io_class; (void)stats;
+    return false;
+#endif
+}
+
+bool UIEEPlacementEngine::setIoClass(int pid, IoClass io_class, Stats& stats) {
+    // IOPRIO_WHO_PROCESS 在 Linux 上同样只作用于单个线程
+    int threads = forEachThread(pid, [&](int tid) {
+        setThreadIoClass(tid, io_class, stats);
+    });
+    if (threads < 0) {
+        errno = ESRCH;
+        return false;
+    }
+    stats.threads += threads;
+    return true;
+}
+
+void UIEEPlacementEngine::recordFailure(Stats& stats, int err) {
+    if (err == EPERM || err == EACCES) {
+        stats.permission_denied++;
+    } else {
+        stats.other_failures++;
+        stats.other_errno = err;
+    }
+}
+
+bool UIEEPlacementEngine::apply(int pid, const Placement& placement, Stats& stats) {
+    if (placement.tier == TIER_DEFAULT) {
+        return restore(pid, stats);
+    }
+
+    auto found = applied_.find(pid);
+    Applied state = found != applied_.end() ? found->second
+                                            : Applied{GROUP_UNKNOWN, GROUP_UNKNOWN, false, false};
+
+    // 1. 分组：记下原分组以便恢复，已在目标分组时不写
+    uint32_t group_cpus = 0;
+    bool in_cpuset_group = false;
+    if (placement.group < GROUP_COUNT && (cpuset_groups_ & (1u << placement.group))) {
+        CgroupGroup current = currentGroup(pid, false);
+        if (found == applied_.end()) {
+            state.original_cpuset = current;
+        }
+        in_cpuset_group = current == placement.group ||
+                          moveToGroup(cpuset_[placement.group].procs_fd, pid, stats);
+        if (in_cpuset_group) {
+            group_cpus = groupCpus(placement.group);
+        }
+    }
+    bool in_cpuctl_group = false;
+    if (placement.group < GROUP_COUNT && (cpuctl_groups_ & (1u << placement.group))) {
+        CgroupGroup current = currentGroup(pid, true);
+        if (found == applied_.end()) {
+            state.original_cpuctl = current;
+        }
+        in_cpuctl_group = current == placement.group || moveToGroup(cpuctl_fd_[placement.group], pid, stats);
+    }
+
+    // 2. 掩码：移入分组时内核已把线程掩码设为分组范围，与目标一致时无需逐线程设置
+    bool need_affinity = placement.cpu_mask != 0 && !(in_cpuset_group && group_cpus == placement.cpu_mask);
+    // 3. uclamp：在 cpuctl 分组中时由分组的 uclamp 生效
+    bool need_uclamp = !in_cpuctl_group && uclamp_supported_ &&
+                       (placement.uclamp_min != 0 || placement.uclamp_max != UCLAMP_MAX_VALUE || state.uclamp);
+
+    if (need_affinity || need_uclamp || state.affinity) {
+        int threads = forEachThread(pid, [&](int tid) {
+            if (need_affinity || state.affinity) {
+                setThreadAffinity(tid, need_affinity ? placement.cpu_mask : group_cpus, stats);
+            }
+            if (need_uclamp) {
+                setThreadUclamp(tid, placement.uclamp_min, placement.uclamp_max, stats);
+            }
+        });
+        if (threads < 0) {
+            applied_.erase(pid);
+            errno = ESRCH;
+            return false;
+        }
+        stats.threads += threads;
+    }
+
+    state.affinity = need_affinity;
+    state.uclamp = need_uclamp;
+    applied_[pid] = state;
+    return true;
+}
+
+bool UIEEPlacementEngine::restore(int pid, Stats& stats) {
+    auto found = applied_.find(pid);
+    if (found == applied_.end()) {
+        return true;
+    }
+    Applied state = found->second;
+    applied_.erase(found);
+
+    if (state.original_cpuset < GROUP_COUNT && (cpuset_groups_ & (1u << state.original_cpuset)) &&
+        currentGroup(pid, false) != state.original_cpuset) {
+        moveToGroup(cpuset_[state.original_cpuset].procs_fd, pid, stats);
+    }
+    if (state.original_cpuctl < GROUP_COUNT && (cpuctl_groups_ & (1u << state.original_cpuctl)) &&
+        currentGroup(pid, true) != state.original_cpuctl) {
+        moveToGroup(cpuctl_fd_[state.original_cpuctl], pid, stats);
+    }
+
+    if (state.affinity || state.uclamp) {
+        // 掩码恢复为所在 cpuset 分组的范围（没有分组时为全部核心）
+        uint32_t mask = 0;
+        CgroupGroup group = currentGroup(pid, false);
+        if (group < GROUP_COUNT && (cpuset_groups_ & (1u << group))) {
+            mask = groupCpus(group);
+        }
+        int threads = forEachThread(pid, [&](int tid) {
+            if (state.affinity) {
+                setThreadAffinity(tid, mask, stats);
+            }
+            if (state.uclamp) {
+                setThreadUclamp(tid, 0, UCLAMP_MAX_VALUE, stats);
+            }
+        });
+        if (threads < 0) {
+            errno = ESRCH;
+            return false;
+        }
+        stats.threads += threads;
+    }
+    return true;
+}
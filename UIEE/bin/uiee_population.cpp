@@ -0,0 +1,345 @@
+#include "uiee_engine.h"
+
+// 种群进化管理器实现
+// 每代数据按列存放：parameters 为 size × dims 的行主序矩阵，fitness 等为长度 size 的并行数组。
+// 两套缓冲在构造/切换内存资源时一次性分配，换代只在两者之间交换，稳态下没有任何分配。
+
+namespace {
+
+constexpr double kMutationRate = 0.1;
+constexpr double kMutationStrength = 0.1;
+constexpr double kCrossoverRate = 0.8;
+constexpr size_t kTournamentSize = 3;
+constexpr size_t kEliteCount = 2;
+
+} // namespace
+
+struct UIEECoreEngine::PopulationEvolutionManager::Generation {
+    size_t size;
+    size_t dims;
+    int generation;
+    std::chrono::steady_clock::time_point creation_time;
+    std::chrono::steady_clock::time_point last_update_time;
+    std::pmr::vector<double> parameters;
+    std::pmr::vector<double> fitness;
+    std::pmr::vector<double> performance;
+    std::pmr::vector<double> efficiency;
+    std::pmr::vector<double> energy;
+    std::pmr::vector<uint8_t> valid;
+    std::pmr::vector<int> update_count;
+
+    Generation(size_t capacity, size_t dimensions, std::pmr::memory_resource* resource)
+        : size(0), dims(dimensions), generation(0),
+          parameters(capacity * dimensions, 0.0, resource),
+          fitness(capacity, 0.0, resource),
+          performance(capacity, 0.0, resource),
+          efficiency(capacity, 0.0, resource),
+          energy(capacity, 0.0, resource),
+          valid(capacity, 0, resource),
+          update_count(capacity, 0, resource) {}
+
+    double* row(size_t index) { return parameters.data() + index * dims; }
+    const double* row(size_t index) const { return parameters.data() + index * dims; }
+
+    // 从 other 的第 index 行整行拷贝到本代第 slot 行
+    void copyIndividual(size_t slot, const Generation& other, size_t index) {
+        std::copy(other.row(index), other.row(index) + dims, row(slot));
+        fitness[slot] = other.fitness[index];
+        performance[slot] = other.performance[index];
+        efficiency[slot] = other.efficiency[index];
+        energy[slot] = other.energy[index];
+        valid[slot] = other.valid[index];
+        update_count[slot] = other.update_count[index];
+    }
+
+    void resetScores(size_t slot) {
+        fitness[slot] = 0.0;
+        performance[slot] = 0.0;
+        efficiency[slot] = 0.0;
+        energy[slot] = 0.0;
+        valid[slot] = 1;
+        update_count[slot] = 0;
+    }
+};
+
+UIEECoreEngine::PopulationEvolutionManager::PopulationEvolutionManager(size_t population_size)
+    : population_size_(std::max<size_t>(population_size, 2)),
+      current_generation_(0),
+      rng_(std::random_device{}()),
+      upstream_(std::pmr::get_default_resource()),
+      current_(0) {
+    generations_[0] = std::make_unique<Generation>(population_size_, PARAMETER_COUNT, upstream_);
+    generations_[1] = std::make_unique<Generation>(population_size_, PARAMETER_COUNT, upstream_);
+}
+
+UIEECoreEngine::PopulationEvolutionManager::~PopulationEvolutionManager() = default;
+
+void UIEECoreEngine::PopulationEvolutionManager::setMemoryResource(std::pmr::memory_resource* upstream) {
+    std::lock_guard<std::mutex> lock(population_mutex_);
+    upstream_ = upstream ? upstream : std::pmr::get_default_resource();
+
+    // pmr 容器的分配器构造后不可更换，按新资源重建两套缓冲并迁移当前代
+    auto current = std::make_unique<Generation>(population_size_, PARAMETER_COUNT, upstream_);
+    const Generation& old = *generations_[current_];
+    current->size = old.size;
+    current->generation = old.generation;
+    current->creation_time = old.creation_time;
+    current->last_update_time = old.last_update_time;
+    for (size_t i = 0; i < old.size; ++i) {
+        current->copyIndividual(i, old, i);
+    }
+
+    generations_[0] = std::move(current);
+    generations_[1] = std::make_unique<Generation>(population_size_, PARAMETER_COUNT, upstream_);
+    current_ = 0;
+}
+
+void UIEECoreEngine::PopulationEvolutionManager::initializePopulation() {
+    std::lock_guard<std::mutex> lock(population_mutex_);
+    Generation& population = *generations_[current_];
+    std::uniform_real_distribution<double> dist(0.0, 1.0);
+
+    for (double& parameter : population.parameters) {
+        parameter = dist(rng_);
+    }
+    for (size_t i = 0; i < population_size_; ++i) {
+        population.resetScores(i);
+    }
+    population.size = population_size_;
+    population.generation = 0;
+    population.creation_time = std::chrono::steady_clock::now();
+    population.last_update_time = population.creation_time;
+    current_generation_ = 0;
+}
+
+void UIEECoreEngine::PopulationEvolutionManager::evolveGeneration() {
+    std::lock_guard<std::mutex> lock(population_mutex_);
+    const Generation& parents = *generations_[current_];
+    if (parents.size == 0 || shouldTerminate(parents)) {
+        return;
+    }
+
+    Generation& children = *generations_[1 - current_];
+
+    // 精英保留：适应度最高的个体直接进入下一代
+    size_t elite_count = std::min(kEliteCount, parents.size);
+    size_t elites[kEliteCount];
+    for (size_t e = 0; e < elite_count; ++e) {
+        size_t best = parents.size;
+        for (size_t i = 0; i < parents.size; ++i) {
+            bool taken = false;
+            for (size_t k = 0; k < e; ++k) {
+                taken |= elites[k] == i;
+            }
+            if (!taken && (best == parents.size || parents.fitness[i] > parents.fitness[best])) {
+                best = i;
+            }
+        }
+        elites[e] = best;
+        children.copyIndividual(e, parents, best);
+    }
+
+    for (size_t slot = elite_count; slot < population_size_; ++slot) {
+        size_t parent1 = selectParent(parents);
+        size_t parent2 = selectParent(parents);
+        crossover(parents.row(parent1), parents.row(parent2), children.row(slot));
+        mutate(children.row(slot));
+        children.resetScores(slot);
+    }
+
+    children.size = population_size_;
+    children.generation = parents.generation + 1;
+    children.creation_time = std::chrono::steady_clock::now();
+    children.last_update_time = children.creation_time;
+
+    current_ = 1 - current_;
+    current_generation_++;
+}
+
+UIEECoreEngine::FitnessIndividual UIEECoreEngine::PopulationEvolutionManager::getBestIndividual() {
+    std::lock_guard<std::mutex> lock(population_mutex_);
+    const Generation& population = *generations_[current_];
+    FitnessIndividual individual;
+    if (population.size == 0) {
+        return individual;
+    }
+
+    size_t best = 0;
+    for (size_t i = 1; i < population.size; ++i) {
+        if (population.fitness[i] > population.fitness[best]) {
+            best = i;
+        }
+    }
+
+    individual.parameters.assign(population.row(best), population.row(best) + population.dims);
+    individual.fitness_score = population.fitness[best];
+    individual.performance_score = population.performance[best];
+    individual.efficiency_score = population.efficiency[best];
+    individual.energy_cost = population.energy[best];
+    individual.creation_time = population.creation_time;
+    individual.last_update_time = population.last_update_time;
+    individual.generation = population.generation;
+    individual.is_valid = population.valid[best] != 0;
+    individual.update_count = population.update_count[best];
+    return individual;
+}
+
+UIEECoreEngine::PopulationEvolutionManager::FitnessSummary
+UIEECoreEngine::PopulationEvolutionManager::getFitnessSummary() const {
+    std::lock_guard<std::mutex> lock(population_mutex_);
+    const Generation& population = *generations_[current_];
+    FitnessSummary summary;
+
+    // 无效个体按掩码清零，循环内没有分支
+    double total = 0.0;
+    size_t valid_count = 0;
+    double best = population.size > 0 ? population.fitness[0] : 0.0;
+    for (size_t i = 0; i < population.size; ++i) {
+        double mask = population.valid[i] ? 1.0 : 0.0;
+        total += population.fitness[i] * mask;
+        valid_count += population.valid[i] ? 1 : 0;
+        best = std::max(best, population.fitness[i]);
+    }
+
+    summary.valid_count = valid_count;
+    summary.mean_fitness = valid_count > 0 ? total / valid_count : 0.0;
+    summary.best_fitness = best;
+    return summary;
+}
+
+UIEECoreEngine::PopulationEvolutionManager::PopulationView
+UIEECoreEngine::PopulationEvolutionManager::view() const {
+    const Generation& population = *generations_[current_];
+    PopulationView view;
+    view.size = population.size;
+    view.dims = population.dims;
+    view.parameters = population.parameters.data();
+    view.fitness = population.fitness.data();
+    view.performance = population.performance.data();
+    view.efficiency = population.efficiency.data();
+    view.energy = population.energy.data();
+    view.valid = population.valid.data();
+    view.generation = population.generation;
+    return view;
+}
+
+int UIEECoreEngine::PopulationEvolutionManager::copyPopulation(std::vector<double>& parameters,
+                                                               std::vector<double>& fitness,
+                                                               std::vector<uint8_t>& valid) const {
+    std::lock_guard<std::mutex> lock(population_mutex_);
+    const Generation& population = *generations_[current_];
+    parameters.assign(population.parameters.begin(), population.parameters.begin() + population.size * population.dims);
+    fitness.assign(population.fitness.begin(), population.fitness.begin() + population.size);
+    valid.assign(population.valid.begin(), population.valid.begin() + population.size);
+    return population.generation;
+}
+
+bool UIEECoreEngine::PopulationEvolutionManager::restorePopulation(const double* parameters, const double* fitness,
+                                                                   const uint8_t* valid, size_t size, size_t dims,
+                                                                   int generation) {
+    if (dims != PARAMETER_COUNT || size == 0 || parameters == nullptr || fitness == nullptr || valid == nullptr) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(population_mutex_);
+    Generation& population = *generations_[current_];
+    size_t restored = std::min(size, population_size_);
+    std::uniform_real_distribution<double> dist(0.0, 1.0);
+    for (size_t i = 0; i < population_size_; ++i) {
+        population.resetScores(i);
+        if (i < restored) {
+            // 参数限制在 [0,1]，与变异时的取值范围一致
+            for (size_t d = 0; d < dims; ++d) {
+                population.row(i)[d] = std::clamp(parameters[i * dims + d], 0.0, 1.0);
+            }
+            population.fitness[i] = fitness[i];
+            population.valid[i] = valid[i] ? 1 : 0;
+        } else {
+            for (size_t d = 0; d < dims; ++d) {
+                population.row(i)[d] = dist(rng_);
+            }
+        }
+    }
+    population.size = population_size_;
+    population.generation = generation;
+    population.creation_time = std::chrono::steady_clock::now();
+    population.last_update_time = population.creation_time;
+    current_generation_ = generation;
+    return true;
+}
+
+void UIEECoreEngine::PopulationEvolutionManager::setFitnessFunction(std::shared_ptr<HamiltonFitnessFunction> fitness_func) {
+    std::lock_guard<std::mutex> lock(population_mutex_);
+    fitness_function_ = std::move(fitness_func);
+}
+
+void UIEECoreEngine::PopulationEvolutionManager::applyFitnessScores(const std::vector<double>& scores,
+                                                                     double performance_score,
+                                                                     double efficiency_score,
+                                                                     double energy_cost) {
+    std::lock_guard<std::mutex> lock(population_mutex_);
+    Generation& population = *generations_[current_];
+    size_t count = std::min(scores.size(), population.size);
+    std::copy(scores.begin(), scores.begin() + count, population.fitness.begin());
+    std::fill(population.performance.begin(), population.performance.begin() + count, performance_score);
+    std::fill(population.efficiency.begin(), population.efficiency.begin() + count, efficiency_score);
+    std::fill(population.energy.begin(), population.energy.begin() + count, energy_cost);
+    for (size_t i = 0; i < count; ++i) {
+        population.update_count[i]++;
+    }
+    population.last_update_time = std::chrono::steady_clock::now();
+}
+
+void UIEECoreEngine::PopulationEvolutionManager::crossover(const double* parent1, const double* parent2, double* child) {
+    std::uniform_real_distribution<double> dist(0.0, 1.0);
+    if (dist(rng_) > kCrossoverRate) {
+        std::copy(parent1, parent1 + PARAMETER_COUNT, child);
+        return;
+    }
+
+    // 算术交叉：每个参数独立取父母之间的随机插值
+    double weights[PARAMETER_COUNT];
+    for (double& weight : weights) {
+        weight = dist(rng_);
+    }
+    for (size_t i = 0; i < PARAMETER_COUNT; ++i) {
+        child[i] = weights[i] * parent1[i] + (1.0 - weights[i]) * parent2[i];
+    }
+}
+
+void UIEECoreEngine::PopulationEvolutionManager::mutate(double* parameters) {
+    std::uniform_real_distribution<double> chance(0.0, 1.0);
+    std::normal_distribution<double> noise(0.0, kMutationStrength);
+    for (size_t i = 0; i < PARAMETER_COUNT; ++i) {
+        if (chance(rng_) < kMutationRate) {
+            parameters[i] = std::clamp(parameters[i] + noise(rng_), 0.0, 1.0);
+        }
+    }
+}
+
+size_t UIEECoreEngine::PopulationEvolutionManager::selectParent(const Generation& population) {
+    // 锦标赛选择，只读取 fitness 数组
+    std::uniform_int_distribution<size_t> dist(0, population.size - 1);
+    size_t best = dist(rng_);
+    for (size_t i = 1; i < kTournamentSize; ++i) {
+        size_t candidate = dist(rng_);
+        if (population.fitness[candidate] > population.fitness[best]) {
+            best = candidate;
+        }
+    }
+    return best;
+}
+
+bool UIEECoreEngine::PopulationEvolutionManager::shouldTerminate(const Generation& population) const {
+    // 参数已全部收敛到同一点时继续进化没有意义
+    if (population.size < 2) {
+        return true;
+    }
+    const double* reference = population.row(0);
+    size_t total = population.size * population.dims;
+    for (size_t i = population.dims; i < total; ++i) {
+        if (std::fabs(population.parameters[i] - reference[i % population.dims]) > 1e-9) {
+            return false;
+        }
+    }
+    return true;
+}
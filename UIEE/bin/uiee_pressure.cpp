@@ -0,0 +1,234 @@
+#include "uiee_pressure.h"
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+
+// 资源压力监测实现
+
+namespace {
+
+const char* const kResourceFiles[UIEEPressureMonitor::RESOURCE_COUNT] = {"cpu", "memory", "io"};
+
+int64_t nowMs() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// 解析 "12.34" 形式的两位小数
+bool readDecimal(UIEEScanner& scanner, double& value) {
+    uint64_t integer = 0;
+    if (!scanner.readU64(integer)) {
+        return false;
+    }
+    value = static_cast<double>(integer);
+    if (scanner.consume(".")) {
+        const char* start = scanner.position();
+        uint64_t fraction = 0;
+        if (scanner.readU64(fraction)) {
+            double scale = 1.0;
+            for (const char* p = start; p < scanner.position(); ++p) {
+                scale *= 10.0;
+            }
+            value += fraction / scale;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+UIEEPressureMonitor::UIEEPressureMonitor()
+    : available_(false), latest_{}, running_(false), event_count_(0), last_event_ms_(0) {
+    for (int i = 0; i < RESOURCE_COUNT; ++i) {
+        trigger_fd_[i] = -1;
+    }
+}
+
+UIEEPressureMonitor::~UIEEPressureMonitor() {
+    stop();
+}
+
+bool UIEEPressureMonitor::open(const std::string& pressure_root) {
+    std::lock_guard<std::mutex> lock(sample_mutex_);
+    root_ = pressure_root;
+    available_ = false;
+    for (int i = 0; i < RESOURCE_COUNT; ++i) {
+        // 内核以 psi=0 启动时文件存在但读取返回 EOPNOTSUPP，按不可用处理
+        if (files_[i].open(root_ + "/" + kResourceFiles[i]) && files_[i].read(buffer_, sizeof(buffer_)) > 0) {
+            available_ = true;
+        } else {
+            files_[i].close();
+        }
+    }
+    return available_;
+}
+
+bool UIEEPressureMonitor::parse(const char* data, size_t length, Pressure& pressure) {
+    // some avg10=0.12 avg60=0.05 avg300=0.01 total=123456
+    // full avg10=0.00 avg60=0.00 avg300=0.00 total=0
+    pressure = Pressure{};
+    UIEEScanner scanner(data, length);
+    while (!scanner.atEnd()) {
+        double* target = nullptr;
+        if (scanner.consume("some avg10=")) {
+            target = &pressure.some_avg10;
+        } else if (scanner.consume("full avg10=")) {
+            target = &pressure.full_avg10;
+        }
+        if (target != nullptr && readDecimal(scanner, *target)) {
+            pressure.valid = true;
+        }
+        scanner.skipLine();
+    }
+    return pressure.valid;
+}
+
+UIEEPressureMonitor::Sample UIEEPressureMonitor::sample() {
+    std::lock_guard<std::mutex> lock(sample_mutex_);
+    Sample sample{};
+    for (int i = 0; i < RESOURCE_COUNT; ++i) {
+        if (!files_[i].isOpen()) {
+            continue;
+        }
+        ssize_t n = files_[i].read(buffer_, sizeof(buffer_));
+        if (n > 0 && parse(buffer_, static_cast<size_t>(n), sample.resource[i])) {
+            sample.valid = true;
+        }
+    }
+    latest_ = sample;
+    return sample;
+}
+
+UIEEPressureMonitor::Sample UIEEPressureMonitor::latest() const {
+    std::lock_guard<std::mutex> lock(sample_mutex_);
+    return latest_;
+}
+
+bool UIEEPressureMonitor::registerTrigger(Resource resource, int stall_us) {
+#ifdef __linux__
+    // 每个fd只能登记一个触发器，fd 关闭时内核撤销
+    const std::string path = root_ + "/" + kResourceFiles[resource];
+    int fd = ::open(path.c_str(), O_RDWR | O_NONBLOCK | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+    // 没有 CAP_SYS_RESOURCE 时内核对 1 秒窗口返回 EINVAL，改用 2 秒窗口并按比例放大停顿阈值
+    for (int scale = 1; scale <= 2; ++scale) {
+        char trigger[48];
+        int n = snprintf(trigger, sizeof(trigger), "some %d %d", stall_us * scale, TRIGGER_WINDOW_US * scale);
+        if (n > 0 && write(fd, trigger, static_cast<size_t>(n) + 1) >= 0) {
+            trigger_fd_[resource] = fd;
+            return true;
+        }
+        if (errno != EINVAL) {
+            break;
+        }
+    }
+    ::close(fd);
+    return false;
+#else
+    (void)resource; (void)stall_us;
+    return false;
+#endif
+}
+
+void UIEEPressureMonitor::closeTriggers() {
+    for (int i = 0; i < RESOURCE_COUNT; ++i) {
+        if (trigger_fd_[i] >= 0) {
+            ::close(trigger_fd_[i]);
+            trigger_fd_[i] = -1;
+        }
+    }
+}
+
+bool UIEEPressureMonitor::start(Callback callback) {
+    if (running_) {
+        return true;
+    }
+    if (!available_) {
+        return false;
+    }
+
+    // 启动卡顿主要来自回收与 I/O，只对这两类登记；CPU 压力由周期采样观察
+    bool registered = registerTrigger(RESOURCE_MEMORY, MEMORY_TRIGGER_STALL_US);
+    registered |= registerTrigger(RESOURCE_IO, IO_TRIGGER_STALL_US);
+    if (!registered) {
+        return false;
+    }
+
+    callback_ = std::move(callback);
+    running_ = true;
+    thread_ = std::thread(&UIEEPressureMonitor::watchLoop, this);
+    return true;
+}
+
+void UIEEPressureMonitor::stop() {
+    if (!running_) {
+        return;
+    }
+
+    running_ = false;
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+    closeTriggers();
+}
+
+bool UIEEPressureMonitor::triggeredWithin(std::chrono::milliseconds window) const {
+    int64_t last = last_event_ms_.load(std::memory_order_relaxed);
+    return last != 0 && nowMs() - last <= window.count();
+}
+
+void UIEEPressureMonitor::watchLoop() {
+#ifdef __linux__
+    while (running_) {
+        struct pollfd fds[RESOURCE_COUNT];
+        Resource resources[RESOURCE_COUNT];
+        nfds_t count = 0;
+        for (int i = 0; i < RESOURCE_COUNT; ++i) {
+            if (trigger_fd_[i] >= 0) {
+                fds[count].fd = trigger_fd_[i];
+                fds[count].events = POLLPRI;
+                fds[count].revents = 0;
+                resources[count] = static_cast<Resource>(i);
+                count++;
+            }
+        }
+        if (count == 0) {
+            break;
+        }
+
+        // 超时只用于检查停止标志
+        int ready = poll(fds, count, POLL_INTERVAL_MS);
+        if (ready <= 0) {
+            continue;
+        }
+
+        for (nfds_t i = 0; i < count; ++i) {
+            if (fds[i].revents & POLLERR) {
+                // 触发器已被内核撤销（例如 cgroup 被删除），不再监听
+                ::close(trigger_fd_[resources[i]]);
+                trigger_fd_[resources[i]] = -1;
+            } else if (fds[i].revents & POLLPRI) {
+                event_count_++;
+                last_event_ms_.store(nowMs(), std::memory_order_relaxed);
+                if (callback_) {
+                    callback_(resources[i]);
+                }
+            }
+        }
+    }
+#endif
+}
+
+const char* UIEEPressureMonitor::resourceName(Resource resource) {
+    switch (resource) {
+        case RESOURCE_CPU: return "cpu";
+        case RESOURCE_MEMORY: return "memory";
+        case RESOURCE_IO: return "io";
+        default: return "unknown";
+    }
+}
@@ -0,0 +1,250 @@
+#include "uiee_proc_events.h"
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <dirent.h>
+#include <errno.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/socket.h>
+
+#ifdef __linux__
+#include <linux/netlink.h>
+#include <linux/connector.h>
+#include <linux/cn_proc.h>
+#endif
+
+// 进程事件监听实现
+
+UIEEProcEventListener::UIEEProcEventListener()
+    : socket_fd_(-1), running_(false), event_count_(0), overflow_count_(0) {}
+
+UIEEProcEventListener::~UIEEProcEventListener() {
+    stop();
+}
+
+bool UIEEProcEventListener::start(Callback callback) {
+#ifdef __linux__
+    if (running_) {
+        return true;
+    }
+
+    socket_fd_ = socket(PF_NETLINK, SOCK_DGRAM | SOCK_CLOEXEC, NETLINK_CONNECTOR);
+    if (socket_fd_ < 0) {
+        return false;
+    }
+
+    struct sockaddr_nl addr;
+    std::memset(&addr, 0, sizeof(addr));
+    addr.nl_family = AF_NETLINK;
+    addr.nl_groups = CN_IDX_PROC;
+    addr.nl_pid = 0;  // 由内核分配端口号
+
+    // 加大接收缓冲区，降低应用启动风暴时的溢出概率
+    int rcvbuf = 256 * 1024;
+    setsockopt(socket_fd_, SOL_SOCKET, SO_RCVBUF, &rcvbuf, sizeof(rcvbuf));
+
+    if (bind(socket_fd_, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)) < 0 ||
+        !subscribe(true)) {
+        close(socket_fd_);
+        socket_fd_ = -1;
+        return false;
+    }
+
+    callback_ = std::move(callback);
+    running_ = true;
+    thread_ = std::thread(&UIEEProcEventListener::receiveLoop, this);
+    return true;
+#else
+    (void)callback;
+    return false;
+#endif
+}
+
+void UIEEProcEventListener::stop() {
+    if (!running_) {
+        return;
+    }
+
+    running_ = false;
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+
+    if (socket_fd_ >= 0) {
+        subscribe(false);
+        close(socket_fd_);
+        socket_fd_ = -1;
+    }
+}
+
+bool UIEEProcEventListener::subscribe(bool enable) {
+#ifdef __linux__
+    // nlmsghdr + cn_msg + proc_cn_mcast_op 需要连续存放
+    alignas(NLMSG_ALIGNTO) char buffer[NLMSG_SPACE(sizeof(struct cn_msg) + sizeof(enum proc_cn_mcast_op))];
+    std::memset(buffer, 0, sizeof(buffer));
+
+    struct nlmsghdr* header = reinterpret_cast<struct nlmsghdr*>(buffer);
+    header->nlmsg_len = NLMSG_LENGTH(sizeof(struct cn_msg) + sizeof(enum proc_cn_mcast_op));
+    header->nlmsg_type = NLMSG_DONE;
+    header->nlmsg_pid = getpid();
+
+    struct cn_msg* message = reinterpret_cast<struct cn_msg*>(NLMSG_DATA(header));
+    message->id.idx = CN_IDX_PROC;
+    message->id.val = CN_VAL_PROC;
+    message->len = sizeof(enum proc_cn_mcast_op);
+
+    enum proc_cn_mcast_op op = enable ? PROC_CN_MCAST_LISTEN : PROC_CN_MCAST_IGNORE;
+    std::memcpy(message->data, &op, sizeof(op));
+
+    return send(socket_fd_, header, header->nlmsg_len, 0) >= 0;
+#else
+    (void)enable;
+    return false;
+#endif
+}
+
+void UIEEProcEventListener::receiveLoop() {
+#ifdef __linux__
+    alignas(NLMSG_ALIGNTO) char buffer[8192];
+    Event batch[MAX_BATCH_EVENTS];
+
+    while (running_) {
+        struct pollfd pfd;
+        pfd.fd = socket_fd_;
+        pfd.events = POLLIN;
+        pfd.revents = 0;
+
+        // 超时只用于检查停止标志
+        int ready = poll(&pfd, 1, 500);
+        if (ready <= 0) {
+            continue;
+        }
+
+        ssize_t length = recv(socket_fd_, buffer, sizeof(buffer), 0);
+        if (length < 0) {
+            if (errno == ENOBUFS) {
+                overflow_count_++;
+                Event overflow{EVENT_OVERFLOW, 0, 0};
+                if (callback_) {
+                    callback_(&overflow, 1);
+                }
+            }
+            continue;
+        }
+
+        size_t count = 0;
+        int remaining = static_cast<int>(length);
+        for (struct nlmsghdr* header = reinterpret_cast<struct nlmsghdr*>(buffer);
+             NLMSG_OK(header, remaining);
+             header = NLMSG_NEXT(header, remaining)) {
+            if (header->nlmsg_type == NLMSG_ERROR || header->nlmsg_type == NLMSG_NOOP) {
+                continue;
+            }
+
+            struct cn_msg* message = reinterpret_cast<struct cn_msg*>(NLMSG_DATA(header));
+            if (message->id.idx != CN_IDX_PROC || message->id.val != CN_VAL_PROC) {
+                continue;
+            }
+
+            const struct proc_event* event = reinterpret_cast<const struct proc_event*>(message->data);
+            Event out{EVENT_FORK, 0, 0};
+            bool process_level = false;
+
+            switch (event->what) {
+                case proc_event::PROC_EVENT_FORK:
+                    // 只关心新进程，线程创建（child_pid != child_tgid）忽略
+                    out.type = EVENT_FORK;
+                    out.pid = event->event_data.fork.child_pid;
+                    out.parent_pid = event->event_data.fork.parent_tgid;
+                    process_level = event->event_data.fork.child_pid == event->event_data.fork.child_tgid;
+                    break;
+                case proc_event::PROC_EVENT_EXEC:
+                    out.type = EVENT_EXEC;
+                    out.pid = event->event_data.exec.process_tgid;
+                    process_level = true;
+                    break;
+                case proc_event::PROC_EVENT_COMM:
+                    out.type = EVENT_COMM;
+                    out.pid = event->event_data.comm.process_pid;
+                    process_level = event->event_data.comm.process_pid == event->event_data.comm.process_tgid;
+                    break;
+                case proc_event::PROC_EVENT_EXIT:
+                    out.type = EVENT_EXIT;
+                    out.pid = event->event_data.exit.process_pid;
+                    process_level = event->event_data.exit.process_pid == event->event_data.exit.process_tgid;
+                    break;
+                default:
+                    break;
+            }
+
+            if (!process_level) {
+                continue;
+            }
+
+            batch[count++] = out;
+            if (count == MAX_BATCH_EVENTS) {
+                event_count_ += count;
+                if (callback_) {
+                    callback_(batch, count);
+                }
+                count = 0;
+            }
+        }
+
+        if (count > 0) {
+            event_count_ += count;
+            if (callback_) {
+                callback_(batch, count);
+            }
+        }
+    }
+#endif
+}
+
+// ========== /proc 差量扫描 ==========
+
+const std::vector<int>& UIEEPidRescanner::rescan() {
+    pids_.clear();
+
+    DIR* dir = opendir("/proc");
+    if (!dir) {
+        return pids_;
+    }
+
+    struct dirent* entry;
+    while ((entry = readdir(dir)) != nullptr) {
+        const char* name = entry->d_name;
+        if (name[0] < '0' || name[0] > '9') {
+            continue;
+        }
+
+        // 手写解析，避免 std::stoi 的异常与字符串构造
+        int pid = 0;
+        bool numeric = true;
+        for (const char* p = name; *p; ++p) {
+            if (*p < '0' || *p > '9') {
+                numeric = false;
+                break;
+            }
+            pid = pid * 10 + (*p - '0');
+        }
+        if (numeric) {
+            pids_.push_back(pid);
+        }
+    }
+
+    closedir(dir);
+    std::sort(pids_.begin(), pids_.end());
+    return pids_;
+}
+
+void UIEEPidRescanner::diff(const std::vector<int>& before, const std::vector<int>& after,
+                            std::vector<int>& added, std::vector<int>& removed) {
+    added.clear();
+    removed.clear();
+    std::set_difference(after.begin(), after.end(), before.begin(), before.end(),
+                        std::back_inserter(added));
+    std::set_difference(before.begin(), before.end(), after.begin(), after.end(),
+                        std::back_inserter(removed));
+}
@@ -0,0 +1,453 @@
+#include "uiee_sampler.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <dirent.h>
+
+// 系统指标采样器实现
+
+namespace {
+
+bool readU64Path(const std::string& path, uint64_t& value) {
+    UIEEProcFile file(path);
+    char buffer[64];
+    ssize_t n = file.read(buffer, sizeof(buffer));
+    if (n <= 0) {
+        return false;
+    }
+    UIEEScanner scanner(buffer, static_cast<size_t>(n));
+    return scanner.readU64(value);
+}
+
+bool containsIgnoreCase(const char* text, const char* needle) {
+    std::string lower(text);
+    std::transform(lower.begin(), lower.end(), lower.begin(), [](unsigned char c) { return std::tolower(c); });
+    return lower.find(needle) != std::string::npos;
+}
+
+} // namespace
+
+UIEESystemSampler::UIEESystemSampler()
+    : stat_file_("/proc/stat"),
+      meminfo_file_("/proc/meminfo"),
+      thermal_file_("/sys/class/thermal/thermal_zone0/temp"),
+      gpu_source_(GPU_NONE), gpu_busy_pair_(false), gpu_max_freq_mhz_(0), battery_current_scale_(0.001),
+      has_previous_(false), prev_total_{0, 0} {
+    std::fill(std::begin(prev_cores_), std::end(prev_cores_), CpuTimes{0, 0});
+    last_sample_ = CpuSample{};
+    stat_buffer_[0] = '\0';
+    meminfo_buffer_[0] = '\0';
+    thermal_buffer_[0] = '\0';
+    gpu_buffer_[0] = '\0';
+    battery_buffer_[0] = '\0';
+    last_gpu_ = GpuSample{};
+    last_battery_ = BatterySample{};
+    last_battery_.level = 100.0;
+}
+
+bool UIEESystemSampler::open() {
+    bool stat_ok = stat_file_.open();
+    meminfo_file_.open();
+    thermal_file_.open();
+    discoverPowerNodes("/sys");
+    return stat_ok;
+}
+
+void UIEESystemSampler::close() {
+    stat_file_.close();
+    meminfo_file_.close();
+    thermal_file_.close();
+    gpu_busy_file_.close();
+    gpu_freq_file_.close();
+    battery_capacity_file_.close();
+    battery_current_file_.close();
+    battery_voltage_file_.close();
+    battery_status_file_.close();
+}
+
+void UIEESystemSampler::discoverPowerNodes(const std::string& sysfs_root) {
+    {
+        std::lock_guard<std::mutex> lock(gpu_mutex_);
+        discoverGpu(sysfs_root);
+        last_gpu_time_ = {};
+    }
+    std::lock_guard<std::mutex> lock(battery_mutex_);
+    discoverBattery(sysfs_root);
+    last_battery_time_ = {};
+}
+
+bool UIEESystemSampler::discoverGpu(const std::string& sysfs_root) {
+    gpu_source_ = GPU_NONE;
+    gpu_busy_file_.close();
+    gpu_freq_file_.close();
+    gpu_busy_pair_ = false;
+    gpu_max_freq_mhz_ = 0;
+    uint64_t max_freq = 0;
+
+    // Adreno：gpu_busy_percentage 为 "37 %"，旧内核只有 gpubusy 的 "busy total"
+    const std::string kgsl = sysfs_root + "/class/kgsl/kgsl-3d0";
+    if (gpu_freq_file_.open(kgsl + "/gpuclk")) {
+        if (!gpu_busy_file_.open(kgsl + "/gpu_busy_percentage")) {
+            gpu_busy_pair_ = gpu_busy_file_.open(kgsl + "/gpubusy");
+        }
+        if (readU64Path(kgsl + "/max_gpuclk", max_freq)) {
+            gpu_max_freq_mhz_ = toMegahertz(max_freq);
+        }
+        gpu_source_ = GPU_KGSL;
+        return true;
+    }
+
+    // Mali（Exynos/Tensor 等）的 /sys/kernel/gpu 接口
+    const std::string kernel_gpu = sysfs_root + "/kernel/gpu";
+    if (gpu_freq_file_.open(kernel_gpu + "/gpu_clock")) {
+        gpu_busy_file_.open(kernel_gpu + "/gpu_busy");
+        if (readU64Path(kernel_gpu + "/gpu_max_clock", max_freq)) {
+            gpu_max_freq_mhz_ = toMegahertz(max_freq);
+        }
+        gpu_source_ = GPU_KERNEL_GPU;
+        return true;
+    }
+
+    // 其余平台在 devfreq 下按设备名找 GPU，部分驱动提供 "37@585000000Hz" 格式的 load 节点
+    const std::string devfreq = sysfs_root + "/class/devfreq";
+    DIR* dir = opendir(devfreq.c_str());
+    if (!dir) {
+        return false;
+    }
+    struct dirent* entry;
+    while ((entry = readdir(dir)) != nullptr) {
+        if (entry->d_name[0] == '.' ||
+            !(containsIgnoreCase(entry->d_name, "gpu") || containsIgnoreCase(entry->d_name, "mali") ||
+              containsIgnoreCase(entry->d_name, "kgsl"))) {
+            continue;
+        }
+        const std::string device = devfreq + "/" + entry->d_name;
+        if (gpu_freq_file_.open(device + "/cur_freq")) {
+            gpu_busy_file_.open(device + "/load");
+            if (readU64Path(device + "/max_freq", max_freq)) {
+                gpu_max_freq_mhz_ = toMegahertz(max_freq);
+            }
+            gpu_source_ = GPU_DEVFREQ;
+            break;
+        }
+    }
+    closedir(dir);
+    return gpu_source_ != GPU_NONE;
+}
+
+void UIEESystemSampler::discoverBattery(const std::string& sysfs_root) {
+    battery_capacity_file_.close();
+    battery_current_file_.close();
+    battery_voltage_file_.close();
+    battery_status_file_.close();
+    battery_current_scale_ = 0.001;
+
+    // 多数设备为 power_supply/battery，其余按 type 为 Battery 的供电设备查找
+    const std::string power_supply = sysfs_root + "/class/power_supply";
+    std::string battery = power_supply + "/battery";
+    UIEEProcFile probe(battery + "/capacity");
+    if (!probe.open()) {
+        battery.clear();
+        DIR* dir = opendir(power_supply.c_str());
+        if (dir) {
+            struct dirent* entry;
+            while (battery.empty() && (entry = readdir(dir)) != nullptr) {
+                if (entry->d_name[0] == '.') {
+                    continue;
+                }
+                UIEEProcFile type(power_supply + "/" + entry->d_name + "/type");
+                char buffer[32];
+                ssize_t n = type.read(buffer, sizeof(buffer));
+                if (n > 0 && UIEEScanner(buffer, static_cast<size_t>(n)).startsWith("Battery")) {
+                    battery = power_supply + "/" + entry->d_name;
+                }
+            }
+            closedir(dir);
+        }
+        if (battery.empty()) {
+            return;
+        }
+    }
+    battery_capacity_file_.open(battery + "/capacity");
+    battery_current_file_.open(battery + "/current_now");
+    battery_voltage_file_.open(battery + "/voltage_now");
+    battery_status_file_.open(battery + "/status");
+
+    // 电流单位在这里定一次，不再按每次读数的量级猜测（小电流的 µA 读数会被误当成 mA）。
+    // ABI 规定 current_now 为 µA，少数厂商驱动整体改用毫单位：同目录的设计容量/满充容量/最大电流
+    // 按 µ 单位读数都在 10^5 以上（数千 mAh、数百 mA 以上），小于该量级说明驱动用的是毫单位；都读不到时按 µA
+    const char* const kScaleNodes[] = {"charge_full_design", "charge_full", "current_max"};
+    for (const char* node : kScaleNodes) {
+        UIEEProcFile file(battery + "/" + node);
+        char buffer[32];
+        int64_t value = 0;
+        if (file.open() && readI64(file, buffer, sizeof(buffer), value) && value > 0) {
+            battery_current_scale_ = value < 100000 ? 1.0 : 0.001;
+            break;
+        }
+    }
+}
+
+bool UIEESystemSampler::readI64(UIEEProcFile& file, char* buffer, size_t size, int64_t& value) {
+    if (!file.isOpen()) {
+        return false;
+    }
+    ssize_t n = file.read(buffer, size);
+    if (n <= 0) {
+        return false;
+    }
+    UIEEScanner scanner(buffer, static_cast<size_t>(n));
+    return scanner.readI64(value);
+}
+
+uint32_t UIEESystemSampler::toMegahertz(uint64_t frequency) {
+    // 各驱动分别以 Hz / kHz / MHz 输出，GPU 频率在 100-2000MHz 之间，按量级区分
+    if (frequency >= 10000000) {
+        return static_cast<uint32_t>(frequency / 1000000);
+    }
+    if (frequency >= 10000) {
+        return static_cast<uint32_t>(frequency / 1000);
+    }
+    return static_cast<uint32_t>(frequency);
+}
+
+UIEESystemSampler::GpuSample UIEESystemSampler::sampleGPU() {
+    std::lock_guard<std::mutex> lock(gpu_mutex_);
+    auto now = std::chrono::steady_clock::now();
+    if (last_gpu_time_.time_since_epoch().count() != 0 && now - last_gpu_time_ < CACHE_INTERVAL) {
+        return last_gpu_;
+    }
+    last_gpu_time_ = now;
+
+    GpuSample sample{};
+    sample.available = gpu_source_ != GPU_NONE;
+    sample.max_freq_mhz = gpu_max_freq_mhz_;
+    if (!sample.available) {
+        last_gpu_ = sample;
+        return sample;
+    }
+
+    int64_t freq = 0;
+    if (readI64(gpu_freq_file_, gpu_buffer_, sizeof(gpu_buffer_), freq) && freq > 0) {
+        sample.freq_mhz = toMegahertz(static_cast<uint64_t>(freq));
+    }
+    ssize_t n = gpu_busy_file_.isOpen() ? gpu_busy_file_.read(gpu_buffer_, sizeof(gpu_buffer_)) : -1;
+    if (n > 0) {
+        UIEEScanner scanner(gpu_buffer_, static_cast<size_t>(n));
+        uint64_t busy = 0;
+        uint64_t total = 0;
+        if (gpu_busy_pair_) {
+            // 驱动按自身的采样窗口给出，两次读取之间不需要做差
+            if (scanner.readU64(busy) && scanner.readU64(total)) {
+                sample.busy_measured = true;
+                sample.busy = total > 0 ? 100.0 * static_cast<double>(busy) / static_cast<double>(total) : 0.0;
+            }
+        } else if (scanner.readU64(busy)) {
+            sample.busy_measured = true;
+            sample.busy = static_cast<double>(busy);
+        }
+    }
+    if (!sample.busy_measured && sample.max_freq_mhz > 0) {
+        sample.busy = 100.0 * sample.freq_mhz / sample.max_freq_mhz;
+    }
+    sample.busy = std::max(0.0, std::min(100.0, sample.busy));
+    last_gpu_ = sample;
+    return sample;
+}
+
+UIEESystemSampler::BatterySample UIEESystemSampler::sampleBattery() {
+    std::lock_guard<std::mutex> lock(battery_mutex_);
+    auto now = std::chrono::steady_clock::now();
+    if (last_battery_time_.time_since_epoch().count() != 0 && now - last_battery_time_ < CACHE_INTERVAL) {
+        return last_battery_;
+    }
+    last_battery_time_ = now;
+
+    BatterySample sample{};
+    sample.level = 100.0;
+    int64_t value = 0;
+    if (readI64(battery_capacity_file_, battery_buffer_, sizeof(battery_buffer_), value)) {
+        sample.available = true;
+        sample.level = std::max(0.0, std::min(100.0, static_cast<double>(value)));
+    }
+
+    // 没有 status 节点时按放电处理；"Not charging" 表示接着电源但不充电，不算放电
+    sample.discharging = true;
+    if (battery_status_file_.isOpen() && battery_status_file_.read(battery_buffer_, sizeof(battery_buffer_)) > 0) {
+        sample.discharging = UIEEScanner(battery_buffer_, strlen(battery_buffer_)).startsWith("Discharging");
+    }
+
+    // 电流：单位在 discoverBattery() 时确定；放电方向的正负号因设备而异，只取绝对值
+    if (readI64(battery_current_file_, battery_buffer_, sizeof(battery_buffer_), value)) {
+        uint64_t magnitude = static_cast<uint64_t>(value < 0 ? -value : value);
+        sample.current_ma = magnitude * battery_current_scale_;
+    }
+    // 电压：µV 或 mV
+    if (readI64(battery_voltage_file_, battery_buffer_, sizeof(battery_buffer_), value) && value > 0) {
+        sample.voltage_mv = value >= 100000 ? value / 1000.0 : static_cast<double>(value);
+    }
+    if (sample.discharging && sample.current_ma > 0.0 && sample.voltage_mv > 0.0) {
+        sample.power_mw = sample.current_ma * sample.voltage_mv / 1000.0;
+    }
+    last_battery_ = sample;
+    return sample;
+}
+
+const char* UIEESystemSampler::gpuSourceName(GpuSource source) {
+    switch (source) {
+        case GPU_KGSL: return "kgsl";
+        case GPU_KERNEL_GPU: return "kernel_gpu";
+        case GPU_DEVFREQ: return "devfreq";
+        default: return "none";
+    }
+}
+
+bool UIEESystemSampler::parseCpuLine(UIEEScanner& scanner, CpuTimes& times) {
+    // 格式: user nice system idle iowait irq softirq steal [guest guest_nice]
+    // guest 时间已经计入 user/nice，这里不重复累加
+    uint64_t fields[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+    int parsed = 0;
+    while (parsed < 8 && scanner.readU64(fields[parsed])) {
+        ++parsed;
+    }
+    if (parsed < 4) {
+        return false;
+    }
+
+    uint64_t idle = fields[3] + fields[4];
+    uint64_t total = 0;
+    for (int i = 0; i < parsed; ++i) {
+        total += fields[i];
+    }
+
+    times.total = total;
+    times.busy = total - idle;
+    return true;
+}
+
+double UIEESystemSampler::deltaUsage(const CpuTimes& now, const CpuTimes& prev, double fallback) {
+    if (now.total <= prev.total) {
+        return fallback;
+    }
+    uint64_t total_delta = now.total - prev.total;
+    uint64_t busy_delta = now.busy >= prev.busy ? now.busy - prev.busy : 0;
+    double usage = static_cast<double>(busy_delta) / static_cast<double>(total_delta) * 100.0;
+    return std::max(0.0, std::min(100.0, usage));
+}
+
+UIEESystemSampler::CpuSample UIEESystemSampler::sampleCPU() {
+    std::lock_guard<std::mutex> lock(cpu_mutex_);
+
+    // /proc/stat 开头是 cpu 与 cpuN 行，后面的 intr 行很长但不需要，4KB足够覆盖16核
+    ssize_t n = stat_file_.read(stat_buffer_, sizeof(stat_buffer_));
+    if (n <= 0) {
+        return last_sample_;
+    }
+
+    CpuTimes total_now{0, 0};
+    CpuTimes cores_now[MAX_CPU_CORES] = {};
+    bool seen[MAX_CPU_CORES] = {false};
+    int core_count = 0;
+
+    UIEEScanner scanner(stat_buffer_, static_cast<size_t>(n));
+    while (!scanner.atEnd() && scanner.consume("cpu")) {
+        if (scanner.startsWith(" ")) {
+            parseCpuLine(scanner, total_now);
+        } else {
+            uint64_t core_id = 0;
+            CpuTimes times{0, 0};
+            if (scanner.readU64(core_id) && core_id < MAX_CPU_CORES && parseCpuLine(scanner, times)) {
+                cores_now[core_id] = times;
+                seen[core_id] = true;
+                core_count = std::max(core_count, static_cast<int>(core_id) + 1);
+            }
+        }
+        scanner.skipLine();
+    }
+
+    CpuSample sample = last_sample_;
+    sample.core_count = core_count;
+    if (has_previous_) {
+        sample.total_usage = deltaUsage(total_now, prev_total_, last_sample_.total_usage);
+    } else {
+        // 首次采样没有基准，退化为开机以来的平均值
+        sample.total_usage = deltaUsage(total_now, CpuTimes{0, 0}, 0.0);
+    }
+
+    for (int i = 0; i < MAX_CPU_CORES; ++i) {
+        sample.core_online[i] = seen[i];
+        if (!seen[i]) {
+            // 离线核心（热插拔）清零并丢弃基准，重新上线后从新基准开始
+            sample.core_usage[i] = 0.0;
+            prev_cores_[i] = CpuTimes{0, 0};
+            continue;
+        }
+        const CpuTimes& base = prev_cores_[i];
+        if (base.total == 0) {
+            sample.core_usage[i] = deltaUsage(cores_now[i], CpuTimes{0, 0}, 0.0);
+        } else {
+            sample.core_usage[i] = deltaUsage(cores_now[i], base, last_sample_.core_usage[i]);
+        }
+        prev_cores_[i] = cores_now[i];
+    }
+
+    prev_total_ = total_now;
+    has_previous_ = true;
+    last_sample_ = sample;
+    return sample;
+}
+
+UIEESystemSampler::CpuSample UIEESystemSampler::lastCPUSample() const {
+    std::lock_guard<std::mutex> lock(cpu_mutex_);
+    return last_sample_;
+}
+
+double UIEESystemSampler::readMemoryUsage() {
+    std::lock_guard<std::mutex> lock(meminfo_mutex_);
+
+    // MemTotal 与 MemAvailable 位于 meminfo 的前三行
+    ssize_t n = meminfo_file_.read(meminfo_buffer_, sizeof(meminfo_buffer_));
+    if (n <= 0) {
+        return 0.0;
+    }
+
+    uint64_t total_mem = 0, available_mem = 0;
+    bool have_total = false, have_available = false;
+
+    UIEEScanner scanner(meminfo_buffer_, static_cast<size_t>(n));
+    while (!scanner.atEnd() && !(have_total && have_available)) {
+        if (scanner.consume("MemTotal:")) {
+            have_total = scanner.readU64(total_mem);
+        } else if (scanner.consume("MemAvailable:")) {
+            have_available = scanner.readU64(available_mem);
+        }
+        scanner.skipLine();
+    }
+
+    if (total_mem > 0 && available_mem <= total_mem) {
+        return static_cast<double>(total_mem - available_mem) / static_cast<double>(total_mem) * 100.0;
+    }
+
+    return 0.0;
+}
+
+double UIEESystemSampler::readThermalState() {
+    std::lock_guard<std::mutex> lock(thermal_mutex_);
+
+    ssize_t n = thermal_file_.read(thermal_buffer_, sizeof(thermal_buffer_));
+    if (n <= 0) {
+        return 0.0;
+    }
+
+    int64_t temp = 0;
+    UIEEScanner scanner(thermal_buffer_, static_cast<size_t>(n));
+    if (!scanner.readI64(temp)) {
+        return 0.0;
+    }
+
+    // 转换为摄氏度
+    double temp_celsius = temp / 1000.0;
+
+    // 转换为0-100的热状态分数
+    return std::max(0.0, std::min(100.0, (temp_celsius - 30.0) / 50.0 * 100.0));
+}
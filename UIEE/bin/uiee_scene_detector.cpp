@@ -0,0 +1,292 @@
+#include "uiee_scene_detector.h"
+#include <algorithm>
+#include <fstream>
+#include <cstdio>
+#include <poll.h>
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#endif
+
+// 前台应用检测实现
+
+namespace {
+
+const char* const kTopAppProcs = "/dev/cpuset/top-app/cgroup.procs";
+const char* const kTopAppTasks = "/dev/cpuset/top-app/tasks";
+
+std::string_view stripProcessSuffix(std::string_view name) {
+    // 同一应用的子进程形如 "com.example.app:remote"
+    size_t colon = name.find(':');
+    return colon == std::string_view::npos ? name : name.substr(0, colon);
+}
+
+void trim(std::string& text) {
+    text.erase(0, text.find_first_not_of(" \t\r\n"));
+    text.erase(text.find_last_not_of(" \t\r\n") + 1);
+}
+
+} // namespace
+
+UIEESceneDetector::UIEESceneDetector()
+    : inotify_fd_(-1), running_(false), change_count_(0) {}
+
+UIEESceneDetector::~UIEESceneDetector() {
+    stop();
+}
+
+int UIEESceneDetector::loadPackageTable(const std::string& path, const SceneParser& parser) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        return -1;
+    }
+
+    std::vector<PackageEntry> exact;
+    std::vector<PackageEntry> prefixes;
+    std::string line;
+    while (std::getline(file, line)) {
+        trim(line);
+        if (line.empty() || line[0] == '#' || line[0] == '[') {
+            continue;
+        }
+        size_t pos = line.find('=');
+        if (pos == std::string::npos) {
+            continue;
+        }
+
+        std::string package = line.substr(0, pos);
+        std::string value = line.substr(pos + 1);
+        trim(package);
+        trim(value);
+        if (package.empty()) {
+            continue;
+        }
+
+        uint8_t scene;
+        if (value == "ignore") {
+            scene = SCENE_IGNORE;
+        } else {
+            int parsed = parser ? parser(value) : -1;
+            if (parsed < 0 || parsed >= SCENE_IGNORE) {
+                continue;
+            }
+            scene = static_cast<uint8_t>(parsed);
+        }
+
+        if (package.back() == '*') {
+            package.pop_back();
+            prefixes.push_back({std::move(package), scene});
+        } else {
+            exact.push_back({std::move(package), scene});
+        }
+    }
+
+    // 同名条目以文件中后出现的为准
+    std::stable_sort(exact.begin(), exact.end(),
+                     [](const PackageEntry& a, const PackageEntry& b) { return a.package < b.package; });
+    std::vector<PackageEntry> unique;
+    unique.reserve(exact.size());
+    for (auto& entry : exact) {
+        if (!unique.empty() && unique.back().package == entry.package) {
+            unique.back() = std::move(entry);
+        } else {
+            unique.push_back(std::move(entry));
+        }
+    }
+    std::stable_sort(prefixes.begin(), prefixes.end(), [](const PackageEntry& a, const PackageEntry& b) {
+        return a.package.size() > b.package.size();
+    });
+
+    int count = static_cast<int>(unique.size() + prefixes.size());
+    std::lock_guard<std::mutex> lock(table_mutex_);
+    exact_ = std::move(unique);
+    prefixes_ = std::move(prefixes);
+    return count;
+}
+
+uint8_t UIEESceneDetector::classify(std::string_view package) const {
+    package = stripProcessSuffix(package);
+
+    std::lock_guard<std::mutex> lock(table_mutex_);
+    auto it = std::lower_bound(exact_.begin(), exact_.end(), package,
+                               [](const PackageEntry& entry, std::string_view key) { return entry.package < key; });
+    if (it != exact_.end() && it->package == package) {
+        return it->scene;
+    }
+    for (const auto& entry : prefixes_) {
+        if (package.size() >= entry.package.size() &&
+            package.compare(0, entry.package.size(), entry.package) == 0) {
+            return entry.scene;
+        }
+    }
+    return SCENE_NONE;
+}
+
+bool UIEESceneDetector::start(Callback callback) {
+#ifdef __linux__
+    if (running_) {
+        return true;
+    }
+
+    if (!procs_file_.open(kTopAppProcs) && !procs_file_.open(kTopAppTasks)) {
+        return false;
+    }
+
+    // ActivityManager 切换前台时会写这两个文件，写操作会产生 IN_MODIFY
+    inotify_fd_ = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (inotify_fd_ >= 0) {
+        int watches = 0;
+        for (const char* path : {kTopAppProcs, kTopAppTasks}) {
+            if (inotify_add_watch(inotify_fd_, path, IN_MODIFY | IN_CLOSE_WRITE) >= 0) {
+                watches++;
+            }
+        }
+        if (watches == 0) {
+            close(inotify_fd_);
+            inotify_fd_ = -1;
+        }
+    }
+
+    callback_ = std::move(callback);
+    running_ = true;
+    refresh();
+    thread_ = std::thread(&UIEESceneDetector::detectLoop, this);
+    return true;
+#else
+    (void)callback;
+    return false;
+#endif
+}
+
+void UIEESceneDetector::stop() {
+    if (!running_) {
+        return;
+    }
+
+    running_ = false;
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+
+    if (inotify_fd_ >= 0) {
+        close(inotify_fd_);
+        inotify_fd_ = -1;
+    }
+    procs_file_.close();
+}
+
+UIEESceneDetector::ForegroundApp UIEESceneDetector::current() const {
+    std::lock_guard<std::mutex> lock(current_mutex_);
+    return current_;
+}
+
+void UIEESceneDetector::detectLoop() {
+#ifdef __linux__
+    alignas(struct inotify_event) char buffer[4096];
+
+    while (running_) {
+        if (inotify_fd_ < 0) {
+            poll(nullptr, 0, POLL_INTERVAL_MS);
+            refresh();
+            continue;
+        }
+
+        struct pollfd pfd;
+        pfd.fd = inotify_fd_;
+        pfd.events = POLLIN;
+        pfd.revents = 0;
+
+        // 超时只用于检查停止标志
+        int ready = poll(&pfd, 1, POLL_INTERVAL_MS);
+        if (ready <= 0) {
+            continue;
+        }
+
+        // 一次切换会写入多个PID，先把积压的事件读空再统一读取一次
+        while (read(inotify_fd_, buffer, sizeof(buffer)) > 0) {
+        }
+        refresh();
+    }
+#endif
+}
+
+bool UIEESceneDetector::refresh() {
+    ForegroundApp app;
+    readTopApp(app);
+
+    {
+        std::lock_guard<std::mutex> lock(current_mutex_);
+        if (app.pid == current_.pid && app.package == current_.package) {
+            return false;
+        }
+        current_ = app;
+    }
+
+    change_count_++;
+    if (callback_) {
+        callback_(app);
+    }
+    return true;
+}
+
+bool UIEESceneDetector::readTopApp(ForegroundApp& app) {
+    char buffer[4096];
+    ssize_t n = procs_file_.read(buffer, sizeof(buffer));
+    if (n <= 0) {
+        return false;
+    }
+
+    // 优先取表中有场景的应用进程，否则取第一个形如包名的进程
+    UIEEScanner scanner(buffer, static_cast<size_t>(n));
+    ForegroundApp fallback;
+    std::string package;
+    size_t examined = 0;
+    while (!scanner.atEnd() && examined < MAX_TOP_APP_PIDS) {
+        int64_t pid = 0;
+        if (!scanner.readI64(pid)) {
+            break;
+        }
+        scanner.skipLine();
+        examined++;
+
+        if (!readPackageName(static_cast<int>(pid), package) || package.find('.') == std::string::npos) {
+            continue;
+        }
+        uint8_t scene = classify(package);
+        if (scene == SCENE_IGNORE) {
+            continue;
+        }
+        if (scene != SCENE_NONE) {
+            app.pid = static_cast<int>(pid);
+            app.package = std::string(stripProcessSuffix(package));
+            app.scene = scene;
+            return true;
+        }
+        if (fallback.pid < 0) {
+            fallback.pid = static_cast<int>(pid);
+            fallback.package = std::string(stripProcessSuffix(package));
+        }
+    }
+
+    app = std::move(fallback);
+    return app.pid >= 0;
+}
+
+bool UIEESceneDetector::readPackageName(int pid, std::string& package) {
+    // 应用进程由 zygote fork 后把 cmdline 改写为包名
+    char path[32];
+    snprintf(path, sizeof(path), "/proc/%d/cmdline", pid);
+    int fd = ::open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+    char buffer[256];
+    ssize_t n = ::read(fd, buffer, sizeof(buffer) - 1);
+    ::close(fd);
+    if (n <= 0) {
+        return false;
+    }
+    buffer[n] = '\0';
+    package.assign(buffer);   // 取第一个参数（以 '\0' 结尾）
+    return !package.empty();
+}
@@ -0,0 +1,197 @@
+#include "uiee_task_table.h"
+
+// ========== 字符串驻留池 ==========
+
+uint32_t UIEEStringPool::intern(std::string_view text) {
+    auto it = index_.find(text);
+    if (it != index_.end()) {
+        refs_[it->second]++;
+        return it->second;
+    }
+
+    uint32_t id;
+    if (!free_ids_.empty()) {
+        id = free_ids_.back();
+        free_ids_.pop_back();
+        strings_[id].assign(text.data(), text.size());
+        refs_[id] = 1;
+    } else {
+        id = static_cast<uint32_t>(strings_.size());
+        strings_.emplace_back(text.data(), text.size());
+        refs_.push_back(1);
+    }
+
+    index_.emplace(std::string_view(strings_[id]), id);
+    return id;
+}
+
+void UIEEStringPool::release(uint32_t id) {
+    if (id >= refs_.size() || refs_[id] == 0) {
+        return;
+    }
+    if (--refs_[id] == 0) {
+        index_.erase(std::string_view(strings_[id]));
+        strings_[id].clear();
+        free_ids_.push_back(id);
+    }
+}
+
+const std::string& UIEEStringPool::get(uint32_t id) const {
+    static const std::string empty;
+    return id < strings_.size() ? strings_[id] : empty;
+}
+
+// ========== 任务表 ==========
+
+UIEETaskTable::UIEETaskTable() : slot_mask_(0), version_(0) {
+    rehash(256);
+}
+
+size_t UIEETaskTable::slotFor(int pid) const {
+    // Fibonacci 散列，PID 通常是连续递增的小整数
+    uint32_t h = static_cast<uint32_t>(pid) * 2654435769u;
+    return static_cast<size_t>(h ^ (h >> 16)) & slot_mask_;
+}
+
+size_t UIEETaskTable::findSlot(int pid) const {
+    size_t slot = slotFor(pid);
+    while (slots_[slot].pid != EMPTY_SLOT) {
+        if (slots_[slot].pid == pid) {
+            return slot;
+        }
+        slot = (slot + 1) & slot_mask_;
+    }
+    return slot;
+}
+
+int UIEETaskTable::indexOf(int pid) const {
+    if (pid < 0) {
+        return -1;
+    }
+    const Slot& slot = slots_[findSlot(pid)];
+    return slot.pid == pid ? slot.index : -1;
+}
+
+void UIEETaskTable::rehash(size_t capacity) {
+    slots_.assign(capacity, Slot{EMPTY_SLOT, -1});
+    slot_mask_ = capacity - 1;
+    for (size_t i = 0; i < records_.size(); ++i) {
+        size_t slot = findSlot(records_[i].pid);
+        slots_[slot] = Slot{records_[i].pid, static_cast<int32_t>(i)};
+    }
+}
+
+int UIEETaskTable::insert(int pid, std::string_view name, uint8_t app_type, int priority,
+                          bool foreground, float cpu_affinity,
+                          std::chrono::steady_clock::time_point start_time, bool* inserted) {
+    if (pid < 0) {
+        if (inserted) *inserted = false;
+        return -1;
+    }
+
+    size_t slot = findSlot(pid);
+    if (slots_[slot].pid == pid) {
+        if (inserted) *inserted = false;
+        return slots_[slot].index;
+    }
+
+    // 负载因子保持在 1/2 以下，探测链足够短
+    if ((records_.size() + 1) * 2 > slots_.size()) {
+        rehash(slots_.size() * 2);
+        slot = findSlot(pid);
+    }
+
+    TaskRecord record{};
+    record.pid = pid;
+    record.priority = priority;
+    record.name_id = names_.intern(name);
+    record.app_type = app_type;
+    record.setForeground(foreground);
+    record.applied_nice = NICE_UNSET;
+    record.placement_tier = 0;
+    record.io_class = 0;
+    record.applied_mask = 0;
+    record.uid = 0;
+    record.cpu_affinity = cpu_affinity;
+
+    int index = static_cast<int>(records_.size());
+    records_.push_back(record);
+    start_times_.push_back(start_time);
+    slots_[slot] = Slot{pid, index};
+    version_++;
+
+    if (inserted) *inserted = true;
+    return index;
+}
+
+void UIEETaskTable::eraseSlot(size_t slot) {
+    // 线性探测的反向移位删除，不留墓碑
+    size_t hole = slot;
+    size_t next = (hole + 1) & slot_mask_;
+    while (slots_[next].pid != EMPTY_SLOT) {
+        size_t home = slotFor(slots_[next].pid);
+        // home 不在 (hole, next] 区间内时，next 可以前移到 hole
+        bool movable = (next > hole) ? (home <= hole || home > next)
+                                     : (home <= hole && home > next);
+        if (movable) {
+            slots_[hole] = slots_[next];
+            hole = next;
+        }
+        next = (next + 1) & slot_mask_;
+    }
+    slots_[hole] = Slot{EMPTY_SLOT, -1};
+}
+
+bool UIEETaskTable::erase(int pid) {
+    if (pid < 0) {
+        return false;
+    }
+
+    size_t slot = findSlot(pid);
+    if (slots_[slot].pid != pid) {
+        return false;
+    }
+
+    size_t index = static_cast<size_t>(slots_[slot].index);
+    names_.release(records_[index].name_id);
+    eraseSlot(slot);
+
+    // 末尾记录移入空位，保持数组稠密
+    size_t last = records_.size() - 1;
+    if (index != last) {
+        records_[index] = records_[last];
+        start_times_[index] = start_times_[last];
+        slots_[findSlot(records_[index].pid)].index = static_cast<int32_t>(index);
+    }
+    records_.pop_back();
+    start_times_.pop_back();
+    version_++;
+    return true;
+}
+
+void UIEETaskTable::clear() {
+    for (const auto& record : records_) {
+        names_.release(record.name_id);
+    }
+    records_.clear();
+    start_times_.clear();
+    slots_.assign(slots_.size(), Slot{EMPTY_SLOT, -1});
+    version_++;
+}
+
+void UIEETaskTable::rename(size_t index, std::string_view name) {
+    TaskRecord& record = records_[index];
+    if (names_.get(record.name_id) == name) {
+        return;
+    }
+    uint32_t new_id = names_.intern(name);
+    names_.release(record.name_id);
+    record.name_id = new_id;
+}
+
+void UIEETaskTable::collectPids(std::vector<int>& out) const {
+    out.reserve(out.size() + records_.size());
+    for (const auto& record : records_) {
+        out.push_back(record.pid);
+    }
+}
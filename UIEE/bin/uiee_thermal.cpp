@@ -0,0 +1,419 @@
+#include "uiee_thermal.h"
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <dirent.h>
+
+// 多分区热模型实现
+
+namespace {
+
+// 各类别热状态分数的起点与满分温度：SoC 在 95°C 附近开始硬降频，机身/电池在 45°C 左右即触发限流
+struct CategoryRange {
+    double base_c;
+    double limit_c;
+};
+
+const CategoryRange kCategoryRanges[UIEEThermalModel::CATEGORY_COUNT] = {
+    {40.0, 95.0},   // CPU
+    {40.0, 95.0},   // GPU
+    {30.0, 48.0},   // 机身
+    {30.0, 48.0},   // 电池
+};
+
+const CategoryRange kLegacyRange = {30.0, 80.0};
+
+constexpr double kMinValidC = -40.0;
+constexpr double kMaxValidC = 150.0;
+constexpr double kMaxRiseC = 25.0;        // 预测相对当前值的上下限，防止拟合偶然发散
+constexpr double kMaxFallC = 15.0;
+
+int64_t nowMs() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+bool isZoneName(const char* name) {
+    if (std::strncmp(name, "thermal_zone", 12) != 0 || name[12] == '\0') {
+        return false;
+    }
+    for (const char* p = name + 12; *p; ++p) {
+        if (*p < '0' || *p > '9') {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool readRaw(UIEEProcFile& file, int64_t& value) {
+    char buffer[32];
+    ssize_t n = file.read(buffer, sizeof(buffer));
+    if (n <= 0) {
+        return false;
+    }
+    UIEEScanner scanner(buffer, static_cast<size_t>(n));
+    return scanner.readI64(value);
+}
+
+bool readTemperature(UIEEProcFile& file, double scale, double& temp_c) {
+    int64_t value = 0;
+    if (!readRaw(file, value)) {
+        return false;
+    }
+    temp_c = value * scale;
+    return temp_c > kMinValidC && temp_c < kMaxValidC;
+}
+
+// 支持 '*'（任意长度，含空串）与 '?'（任意单个字符）
+bool globMatch(const char* pattern, const char* text) {
+    if (*pattern == '\0') {
+        return *text == '\0';
+    }
+    if (*pattern == '*') {
+        for (const char* p = text;; ++p) {
+            if (globMatch(pattern + 1, p)) {
+                return true;
+            }
+            if (*p == '\0') {
+                return false;
+            }
+        }
+    }
+    if (*text == '\0') {
+        return false;
+    }
+    return (*pattern == '?' || *pattern == *text) && globMatch(pattern + 1, text + 1);
+}
+
+// 分区类型名（小写）到类别的匹配表，按顺序取第一个命中的；CATEGORY_COUNT 表示排除。
+// 排除项在前：socd（SoC 电量百分比）、*-lvl*（限流档位）、vbat*/ibat*（电池电压/电流）、
+// pm*-bcl*（PMIC 欠压告警）都是 thermal_zone 形式的非温度量，读数是小整数，不能当作摄氏度。
+// 具体的电池/机身/GPU/CPU 名称在前，通用的 *-therm 板载热敏电阻放在最后归为机身
+struct ZonePattern {
+    const char* pattern;
+    int category;
+};
+
+const ZonePattern kZonePatterns[] = {
+    {"socd", UIEEThermalModel::CATEGORY_COUNT},
+    {"*-lvl*", UIEEThermalModel::CATEGORY_COUNT},
+    {"vbat*", UIEEThermalModel::CATEGORY_COUNT},
+    {"ibat*", UIEEThermalModel::CATEGORY_COUNT},
+    {"pm*-bcl*", UIEEThermalModel::CATEGORY_COUNT},
+
+    {"battery", UIEEThermalModel::CATEGORY_BATTERY},
+    {"battery?therm", UIEEThermalModel::CATEGORY_BATTERY},
+    {"batt?therm", UIEEThermalModel::CATEGORY_BATTERY},
+    {"bms", UIEEThermalModel::CATEGORY_BATTERY},
+    {"mtktsbattery", UIEEThermalModel::CATEGORY_BATTERY},
+
+    {"skin", UIEEThermalModel::CATEGORY_SKIN},
+    {"skin?*", UIEEThermalModel::CATEGORY_SKIN},           // skin-therm、skin_msm 等
+    {"virtual-skin*", UIEEThermalModel::CATEGORY_SKIN},
+    {"xo?therm*", UIEEThermalModel::CATEGORY_SKIN},
+    {"quiet?therm*", UIEEThermalModel::CATEGORY_SKIN},
+    {"shell_*", UIEEThermalModel::CATEGORY_SKIN},
+    {"back_temp", UIEEThermalModel::CATEGORY_SKIN},
+
+    {"gpuss-*", UIEEThermalModel::CATEGORY_GPU},
+    {"gpu", UIEEThermalModel::CATEGORY_GPU},
+    {"gpu?*", UIEEThermalModel::CATEGORY_GPU},             // gpu0-usr、gpu_therm 等
+    {"mali*", UIEEThermalModel::CATEGORY_GPU},
+    {"g3d", UIEEThermalModel::CATEGORY_GPU},
+
+    {"cpu", UIEEThermalModel::CATEGORY_CPU},
+    {"cpu-*-*", UIEEThermalModel::CATEGORY_CPU},           // cpu-0-0-usr、cpu-1-2
+    {"cpuss-*", UIEEThermalModel::CATEGORY_CPU},
+    {"cpu_*", UIEEThermalModel::CATEGORY_CPU},             // cpu_big0、cpu_little0（MTK）
+    {"cpu?-*", UIEEThermalModel::CATEGORY_CPU},            // cpu0-silver-usr、cpu4-gold-usr
+    {"apc?-cpu*", UIEEThermalModel::CATEGORY_CPU},
+    {"mtktscpu", UIEEThermalModel::CATEGORY_CPU},
+    {"big", UIEEThermalModel::CATEGORY_CPU},               // Exynos / Tensor
+    {"mid", UIEEThermalModel::CATEGORY_CPU},
+    {"little", UIEEThermalModel::CATEGORY_CPU},
+    {"x86_pkg_temp", UIEEThermalModel::CATEGORY_CPU},
+
+    {"*-therm", UIEEThermalModel::CATEGORY_SKIN},
+    {"*_therm", UIEEThermalModel::CATEGORY_SKIN},
+};
+
+} // namespace
+
+UIEEThermalModel::UIEEThermalModel() : legacy_(false), latest_{}, has_estimate_(false) {
+}
+
+bool UIEEThermalModel::classify(const char* type, Category& category) {
+    // type 文件以换行结尾
+    std::string lower(type);
+    while (!lower.empty() && std::isspace(static_cast<unsigned char>(lower.back()))) {
+        lower.pop_back();
+    }
+    std::transform(lower.begin(), lower.end(), lower.begin(), [](unsigned char c) { return std::tolower(c); });
+
+    for (const auto& entry : kZonePatterns) {
+        if (globMatch(entry.pattern, lower.c_str())) {
+            if (entry.category == CATEGORY_COUNT) {
+                return false;
+            }
+            category = static_cast<Category>(entry.category);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool UIEEThermalModel::discover(const std::string& thermal_root) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    zones_.clear();
+    legacy_ = false;
+    history_.clear();
+    has_estimate_ = false;
+
+    DIR* dir = opendir(thermal_root.c_str());
+    if (dir) {
+        struct dirent* entry;
+        while ((entry = readdir(dir)) != nullptr && static_cast<int>(zones_.size()) < MAX_ZONES) {
+            if (!isZoneName(entry->d_name)) {
+                continue;
+            }
+            const std::string zone_path = thermal_root + "/" + entry->d_name;
+            UIEEProcFile type_file(zone_path + "/type");
+            char type[64];
+            Category category;
+            if (type_file.read(type, sizeof(type)) <= 0 || !classify(type, category)) {
+                continue;
+            }
+            // 关闭或未接入的传感器读取失败、读数为 0 或给出明显无效的值，直接排除。
+            // 单位在这里按首次读数定下来：绝大多数驱动以毫摄氏度上报，少数旧驱动直接给摄氏度；
+            // 之后不再逐次猜测，避免毫摄氏度分区偶尔的小读数被当成摄氏度
+            Zone zone{category, UIEEProcFile(zone_path + "/temp"), 0.001};
+            int64_t raw = 0;
+            double temp_c;
+            if (!readRaw(zone.temp_file, raw) || raw == 0) {
+                continue;
+            }
+            zone.scale = (raw >= 1000 || raw <= -1000) ? 0.001 : 1.0;
+            if (readTemperature(zone.temp_file, zone.scale, temp_c)) {
+                zones_.push_back(std::move(zone));
+            }
+        }
+        closedir(dir);
+    }
+
+    if (zones_.empty()) {
+        Zone zone{CATEGORY_CPU, UIEEProcFile(thermal_root + "/thermal_zone0/temp"), 0.001};
+        if (zone.temp_file.open()) {
+            int64_t raw = 0;
+            if (readRaw(zone.temp_file, raw) && raw > -1000 && raw < 1000 && raw != 0) {
+                zone.scale = 1.0;
+            }
+            zones_.push_back(std::move(zone));
+            legacy_ = true;
+        }
+    }
+    return !zones_.empty();
+}
+
+int UIEEThermalModel::zoneCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return static_cast<int>(zones_.size());
+}
+
+bool UIEEThermalModel::readTemperatures(double* temp_c, bool* present) {
+    bool any = false;
+    for (int i = 0; i < CATEGORY_COUNT; ++i) {
+        present[i] = false;
+        temp_c[i] = 0.0;
+    }
+    for (auto& zone : zones_) {
+        double value;
+        if (!readTemperature(zone.temp_file, zone.scale, value)) {
+            continue;
+        }
+        if (!present[zone.category] || value > temp_c[zone.category]) {
+            temp_c[zone.category] = value;
+        }
+        present[zone.category] = true;
+        any = true;
+    }
+    return any;
+}
+
+bool UIEEThermalModel::fit(int category, double& a, double& b, double& c) const {
+    // 以相邻两条记录的差分为观测：y = ΔT/Δt，自变量为前一条的功率与温度。
+    // 先中心化再解 2×2 正规方程，温度与功率都近似不变时条件数不会失控
+    constexpr int64_t kMinStepMs = 500;
+    constexpr int64_t kMaxStepMs = 5000;
+
+    size_t n = 0;
+    double sum_p = 0.0, sum_t = 0.0, sum_y = 0.0;
+    for (size_t i = 1; i < history_.size(); ++i) {
+        const Record& previous = history_[i - 1];
+        const Record& current = history_[i];
+        int64_t step = current.time_ms - previous.time_ms;
+        if (step < kMinStepMs || step > kMaxStepMs ||
+            std::isnan(previous.temp_c[category]) || std::isnan(current.temp_c[category])) {
+            continue;
+        }
+        sum_p += previous.power_w;
+        sum_t += previous.temp_c[category];
+        sum_y += (current.temp_c[category] - previous.temp_c[category]) * 1000.0 / step;
+        n++;
+    }
+    if (n < MIN_FIT_SAMPLES) {
+        return false;
+    }
+    const double mean_p = sum_p / n, mean_t = sum_t / n, mean_y = sum_y / n;
+
+    double spp = 0.0, stt = 0.0, spt = 0.0, spy = 0.0, sty = 0.0;
+    for (size_t i = 1; i < history_.size(); ++i) {
+        const Record& previous = history_[i - 1];
+        const Record& current = history_[i];
+        int64_t step = current.time_ms - previous.time_ms;
+        if (step < kMinStepMs || step > kMaxStepMs ||
+            std::isnan(previous.temp_c[category]) || std::isnan(current.temp_c[category])) {
+            continue;
+        }
+        double p = previous.power_w - mean_p;
+        double t = previous.temp_c[category] - mean_t;
+        double y = (current.temp_c[category] - previous.temp_c[category]) * 1000.0 / step - mean_y;
+        spp += p * p;
+        stt += t * t;
+        spt += p * t;
+        spy += p * y;
+        sty += t * y;
+    }
+
+    // 温度几乎没变化时散热系数不可辨识
+    constexpr double kMinTempVariance = 0.05;
+    if (stt < kMinTempVariance * n) {
+        return false;
+    }
+
+    double alpha = 0.0, beta = 0.0;
+    double det = spp * stt - spt * spt;
+    constexpr double kMinPowerVariance = 0.01;
+    if (spp >= kMinPowerVariance * n && det > 1e-6 * spp * stt) {
+        alpha = (spy * stt - sty * spt) / det;
+        beta = (sty * spp - spy * spt) / det;
+    } else {
+        // 功率恒定（或未知）时只拟合散热项，功率的贡献并入常数项
+        beta = sty / stt;
+    }
+
+    // 物理约束：温度越高散热越快（时间常数大于1秒），功率只会让温度上升
+    a = alpha;
+    b = -beta;
+    c = mean_y - alpha * mean_p - beta * mean_t;
+    return b > 0.0 && b < 1.0 && a >= 0.0;
+}
+
+double UIEEThermalModel::trendSlope(int category) const {
+    if (history_.size() < 2) {
+        return 0.0;
+    }
+    const Record& newest = history_.back();
+    if (std::isnan(newest.temp_c[category])) {
+        return 0.0;
+    }
+    for (size_t i = 0; i + 1 < history_.size(); ++i) {
+        const Record& record = history_[i];
+        int64_t span = newest.time_ms - record.time_ms;
+        if (span > TREND_WINDOW_S * 1000 || std::isnan(record.temp_c[category])) {
+            continue;
+        }
+        return span > 0 ? (newest.temp_c[category] - record.temp_c[category]) * 1000.0 / span : 0.0;
+    }
+    return 0.0;
+}
+
+double UIEEThermalModel::predict(int category, double temp_c, double power_w, bool& fitted) const {
+    double a, b, c;
+    double predicted;
+    fitted = fit(category, a, b, c);
+    if (fitted) {
+        // 功率保持不变时一阶系统的解：按 (1-b)^H 向平衡温度收敛
+        double equilibrium = (a * power_w + c) / b;
+        predicted = equilibrium + (temp_c - equilibrium) * std::pow(1.0 - b, PREDICTION_HORIZON_S);
+    } else {
+        predicted = temp_c + trendSlope(category) * PREDICTION_HORIZON_S;
+    }
+    return std::max(temp_c - kMaxFallC, std::min(temp_c + kMaxRiseC, predicted));
+}
+
+double UIEEThermalModel::stateOf(int category, double temp_c) const {
+    const CategoryRange& range = legacy_ ? kLegacyRange : kCategoryRanges[category];
+    double state = (temp_c - range.base_c) / (range.limit_c - range.base_c) * 100.0;
+    return std::max(0.0, std::min(100.0, state));
+}
+
+void UIEEThermalModel::fillStates(Estimate& estimate) const {
+    estimate.state = 0.0;
+    estimate.predicted_state = 0.0;
+    for (int i = 0; i < CATEGORY_COUNT; ++i) {
+        if (estimate.present[i]) {
+            estimate.state = std::max(estimate.state, stateOf(i, estimate.temp_c[i]));
+            estimate.predicted_state = std::max(estimate.predicted_state, stateOf(i, estimate.predicted_c[i]));
+        }
+    }
+}
+
+UIEEThermalModel::Estimate UIEEThermalModel::update(double power_w) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Estimate estimate{};
+    estimate.valid = readTemperatures(estimate.temp_c, estimate.present);
+    if (!estimate.valid) {
+        return estimate;
+    }
+
+    Record record;
+    record.time_ms = nowMs();
+    record.power_w = static_cast<float>(std::max(0.0, power_w));
+    for (int i = 0; i < CATEGORY_COUNT; ++i) {
+        record.temp_c[i] = estimate.present[i] ? static_cast<float>(estimate.temp_c[i]) : NAN;
+    }
+    history_.push(record);
+
+    for (int i = 0; i < CATEGORY_COUNT; ++i) {
+        estimate.predicted_c[i] = estimate.present[i] ?
+            predict(i, estimate.temp_c[i], record.power_w, estimate.fitted[i]) : 0.0;
+    }
+    fillStates(estimate);
+    latest_ = estimate;
+    has_estimate_ = true;
+    return estimate;
+}
+
+UIEEThermalModel::Estimate UIEEThermalModel::sample() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Estimate estimate{};
+    estimate.valid = readTemperatures(estimate.temp_c, estimate.present);
+    for (int i = 0; i < CATEGORY_COUNT; ++i) {
+        estimate.predicted_c[i] = estimate.temp_c[i];
+    }
+    fillStates(estimate);
+    return estimate;
+}
+
+UIEEThermalModel::Estimate UIEEThermalModel::latest() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return latest_;
+}
+
+bool UIEEThermalModel::hasEstimate() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return has_estimate_;
+}
+
+const char* UIEEThermalModel::categoryName(Category category) {
+    switch (category) {
+        case CATEGORY_CPU: return "cpu";
+        case CATEGORY_GPU: return "gpu";
+        case CATEGORY_SKIN: return "skin";
+        case CATEGORY_BATTERY: return "battery";
+        default: return "unknown";
+    }
+}
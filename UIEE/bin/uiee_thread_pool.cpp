@@ -0,0 +1,263 @@
+#include "uiee_engine.h"
+#include <deque>
+#include <unistd.h>
+#include <sched.h>
+#include <sys/syscall.h>
+
+// 工作窃取线程池实现
+// 每个工作线程有自己的任务队列：本线程从队尾取（后进先出，缓存更热），
+// 空闲时从其他线程的队首窃取（先进先出，偷到的通常是更大的剩余工作）
+
+namespace {
+
+pid_t currentThreadId() {
+#ifdef __linux__
+    return static_cast<pid_t>(syscall(SYS_gettid));
+#else
+    return 0;
+#endif
+}
+
+bool applyCpuMask(pid_t tid, uint32_t cpu_mask) {
+#ifdef __linux__
+    // Android bionic 没有 pthread_setaffinity_np，按线程ID调用 sched_setaffinity
+    cpu_set_t mask;
+    CPU_ZERO(&mask);
+    if (cpu_mask == 0) {
+        long cores = sysconf(_SC_NPROCESSORS_CONF);
+        for (long c = 0; c < cores && c < CPU_SETSIZE; ++c) {
+            CPU_SET(c, &mask);
+        }
+    } else {
+        for (int c = 0; c < 32; ++c) {
+            if (cpu_mask & (1u << c)) {
+                CPU_SET(c, &mask);
+            }
+        }
+    }
+    return sched_setaffinity(tid, sizeof(mask), &mask) == 0;
+#else
+    (void)tid; (void)cpu_mask;
+    return false;
+#endif
+}
+
+} // namespace
+
+class UIEECoreEngine::ThreadPoolManager::Impl {
+public:
+    struct Worker {
+        std::mutex mutex;
+        std::deque<Job> jobs;
+        std::atomic<pid_t> tid{0};
+    };
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::vector<std::thread> threads;
+
+    std::mutex sleep_mutex;
+    std::condition_variable sleep_cv;
+    std::atomic<size_t> queued{0};        // 所有队列中尚未取走的任务数
+    std::atomic<bool> stopping{false};
+    std::atomic<size_t> active{0};
+    std::atomic<size_t> total{0};
+    std::atomic<size_t> steals{0};
+    std::atomic<size_t> next_worker{0};
+    std::atomic<uint32_t> cpu_mask{0};
+
+    bool popLocal(size_t index, Job& job) {
+        Worker& worker = *workers[index];
+        std::lock_guard<std::mutex> lock(worker.mutex);
+        if (worker.jobs.empty()) {
+            return false;
+        }
+        job = worker.jobs.back();
+        worker.jobs.pop_back();
+        queued.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    bool steal(size_t thief, Job& job) {
+        size_t count = workers.size();
+        for (size_t offset = 1; offset <= count; ++offset) {
+            size_t victim = (thief + offset) % count;
+            Worker& worker = *workers[victim];
+            std::lock_guard<std::mutex> lock(worker.mutex);
+            if (worker.jobs.empty()) {
+                continue;
+            }
+            job = worker.jobs.front();
+            worker.jobs.pop_front();
+            queued.fetch_sub(1, std::memory_order_relaxed);
+            if (victim != thief) {
+                steals.fetch_add(1, std::memory_order_relaxed);
+            }
+            return true;
+        }
+        return false;
+    }
+
+    void execute(const Job& job) {
+        active.fetch_add(1, std::memory_order_relaxed);
+        TaskGroup* group = job.group;
+        try {
+            job.run(job.context, job.begin, job.end);
+        } catch (...) {
+            if (group && !group->failed.exchange(true)) {
+                group->error = std::current_exception();
+            }
+        }
+        active.fetch_sub(1, std::memory_order_relaxed);
+        total.fetch_add(1, std::memory_order_relaxed);
+
+        // TaskGroup 在调用方栈上：递减与通知都在锁内完成，调用方拿到锁后才会返回
+        if (group) {
+            std::lock_guard<std::mutex> lock(group->mutex);
+            if (group->remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                group->done.notify_all();
+            }
+        }
+    }
+
+    void workerLoop(size_t index) {
+        workers[index]->tid = currentThreadId();
+        uint32_t mask = cpu_mask.load();
+        if (mask != 0) {
+            applyCpuMask(workers[index]->tid, mask);
+        }
+
+        while (true) {
+            Job job;
+            if (popLocal(index, job) || steal(index, job)) {
+                execute(job);
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(sleep_mutex);
+            sleep_cv.wait(lock, [this] {
+                return stopping.load() || queued.load(std::memory_order_relaxed) > 0;
+            });
+            if (stopping && queued.load(std::memory_order_relaxed) == 0) {
+                return;
+            }
+        }
+    }
+};
+
+UIEECoreEngine::ThreadPoolManager::ThreadPoolManager(size_t num_threads, uint32_t cpu_mask)
+    : impl_(std::make_unique<Impl>()) {
+    impl_->cpu_mask = cpu_mask;
+    impl_->workers.reserve(num_threads);
+    for (size_t i = 0; i < num_threads; ++i) {
+        impl_->workers.push_back(std::make_unique<Impl::Worker>());
+    }
+    impl_->threads.reserve(num_threads);
+    for (size_t i = 0; i < num_threads; ++i) {
+        impl_->threads.emplace_back(&Impl::workerLoop, impl_.get(), i);
+    }
+}
+
+UIEECoreEngine::ThreadPoolManager::~ThreadPoolManager() {
+    shutdown();
+}
+
+void UIEECoreEngine::ThreadPoolManager::enqueue(const Job* jobs, size_t count) {
+    if (count == 0) {
+        return;
+    }
+
+    // 已关闭或没有工作线程时在调用线程上直接执行
+    if (impl_->workers.empty() || impl_->stopping) {
+        for (size_t i = 0; i < count; ++i) {
+            impl_->execute(jobs[i]);
+        }
+        return;
+    }
+
+    // 按轮转把任务分散到各线程队列，窃取负责后续的负载均衡
+    size_t worker_count = impl_->workers.size();
+    size_t start = impl_->next_worker.fetch_add(count, std::memory_order_relaxed);
+    for (size_t i = 0; i < count; ++i) {
+        Impl::Worker& worker = *impl_->workers[(start + i) % worker_count];
+        std::lock_guard<std::mutex> lock(worker.mutex);
+        worker.jobs.push_back(jobs[i]);
+    }
+    impl_->queued.fetch_add(count, std::memory_order_relaxed);
+
+    {
+        std::lock_guard<std::mutex> lock(impl_->sleep_mutex);
+    }
+    if (count == 1) {
+        impl_->sleep_cv.notify_one();
+    } else {
+        impl_->sleep_cv.notify_all();
+    }
+}
+
+void UIEECoreEngine::ThreadPoolManager::waitForGroup(TaskGroup& group) {
+    // 调用线程也从队列里取任务执行，嵌套 parallelFor 不会因为工作线程全部阻塞而死锁
+    size_t helper = impl_->workers.empty() ? 0 : impl_->next_worker.load() % impl_->workers.size();
+    while (group.remaining.load(std::memory_order_acquire) > 0) {
+        Job job;
+        if (!impl_->workers.empty() && impl_->steal(helper, job)) {
+            impl_->execute(job);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(group.mutex);
+        group.done.wait(lock, [&group] {
+            return group.remaining.load(std::memory_order_acquire) == 0;
+        });
+    }
+
+    // 等最后一个完成者释放锁，之后 group 才能安全销毁
+    std::lock_guard<std::mutex> lock(group.mutex);
+}
+
+void UIEECoreEngine::ThreadPoolManager::setCpuMask(uint32_t cpu_mask) {
+    impl_->cpu_mask = cpu_mask;
+    for (auto& worker : impl_->workers) {
+        pid_t tid = worker->tid.load();
+        if (tid > 0) {
+            applyCpuMask(tid, cpu_mask);
+        }
+    }
+}
+
+void UIEECoreEngine::ThreadPoolManager::shutdown() {
+    if (impl_->stopping.exchange(true)) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(impl_->sleep_mutex);
+    }
+    impl_->sleep_cv.notify_all();
+
+    // 工作线程退出前会清空队列，已提交的 future 都能拿到结果
+    for (auto& thread : impl_->threads) {
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+}
+
+bool UIEECoreEngine::ThreadPoolManager::isShutdown() const {
+    return impl_->stopping;
+}
+
+size_t UIEECoreEngine::ThreadPoolManager::getThreadCount() const {
+    return impl_->workers.size();
+}
+
+size_t UIEECoreEngine::ThreadPoolManager::getActiveTasks() const {
+    return impl_->active;
+}
+
+size_t UIEECoreEngine::ThreadPoolManager::getTotalTasks() const {
+    return impl_->total;
+}
+
+size_t UIEECoreEngine::ThreadPoolManager::getStealCount() const {
+    return impl_->steals;
+}
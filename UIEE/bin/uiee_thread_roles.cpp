@@ -0,0 +1,284 @@
+#include "uiee_thread_roles.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <dirent.h>
+#include <sys/resource.h>
+
+// 前台应用线程级调度实现
+
+namespace {
+
+struct RolePattern {
+    const char* prefix;
+    UIEEThreadRoleScheduler::Role role;
+};
+
+// comm 前缀（内核截断为15字节）
+const RolePattern kRolePatterns[] = {
+    // Android hwui / WebView / 常见游戏引擎的渲染与主循环线程
+    {"RenderThread", UIEEThreadRoleScheduler::ROLE_RENDER},
+    {"hwuiTask", UIEEThreadRoleScheduler::ROLE_RENDER},
+    {"GLThread", UIEEThreadRoleScheduler::ROLE_RENDER},
+    {"CrRendererMain", UIEEThreadRoleScheduler::ROLE_RENDER},
+    {"VizCompositorTh", UIEEThreadRoleScheduler::ROLE_RENDER},
+    {"UnityMain", UIEEThreadRoleScheduler::ROLE_RENDER},
+    {"UnityGfxDeviceW", UIEEThreadRoleScheduler::ROLE_RENDER},
+    {"UnityChoreograp", UIEEThreadRoleScheduler::ROLE_RENDER},
+    {"GameThread", UIEEThreadRoleScheduler::ROLE_RENDER},
+    {"RHIThread", UIEEThreadRoleScheduler::ROLE_RENDER},
+    // 游戏引擎工作线程
+    {"Worker Thread", UIEEThreadRoleScheduler::ROLE_WORKER},
+    {"Job.Worker", UIEEThreadRoleScheduler::ROLE_WORKER},
+    {"UnityMultiRende", UIEEThreadRoleScheduler::ROLE_WORKER},
+    {"TaskGraphThread", UIEEThreadRoleScheduler::ROLE_WORKER},
+    {"Foreground Work", UIEEThreadRoleScheduler::ROLE_WORKER},
+    // ART 守护线程与引擎后台线程
+    {"HeapTaskDaemon", UIEEThreadRoleScheduler::ROLE_BACKGROUND},
+    {"FinalizerDaemon", UIEEThreadRoleScheduler::ROLE_BACKGROUND},
+    {"FinalizerWatchd", UIEEThreadRoleScheduler::ROLE_BACKGROUND},
+    {"ReferenceQueueD", UIEEThreadRoleScheduler::ROLE_BACKGROUND},
+    {"Jit thread pool", UIEEThreadRoleScheduler::ROLE_BACKGROUND},
+    {"Profile Saver", UIEEThreadRoleScheduler::ROLE_BACKGROUND},
+    {"Signal Catcher", UIEEThreadRoleScheduler::ROLE_BACKGROUND},
+    {"ADB-JDWP Connec", UIEEThreadRoleScheduler::ROLE_BACKGROUND},
+    {"perfetto_hprof_", UIEEThreadRoleScheduler::ROLE_BACKGROUND},
+    {"Background Work", UIEEThreadRoleScheduler::ROLE_BACKGROUND},
+};
+
+constexpr int8_t kNoChange = INT8_MIN;
+
+// 各角色的调整目标：nice、掩码来源、uclamp
+struct RoleBoost {
+    int8_t nice;             // kNoChange 表示保持
+    enum MaskSource : uint8_t { MASK_NONE, MASK_PLACEMENT, MASK_LITTLE } mask;
+    bool uclamp;
+    uint16_t uclamp_min;     // 关键线程在性能档另行抬高
+    uint16_t uclamp_max;
+};
+
+const RoleBoost kRoleBoosts[UIEEThreadRoleScheduler::ROLE_COUNT] = {
+    {kNoChange, RoleBoost::MASK_NONE, false, 0, UIEEPlacementEngine::UCLAMP_MAX_VALUE},        // OTHER
+    {-10, RoleBoost::MASK_PLACEMENT, true, 512, UIEEPlacementEngine::UCLAMP_MAX_VALUE},        // MAIN
+    {-10, RoleBoost::MASK_PLACEMENT, true, 512, UIEEPlacementEngine::UCLAMP_MAX_VALUE},        // RENDER
+    {-5, RoleBoost::MASK_PLACEMENT, false, 0, UIEEPlacementEngine::UCLAMP_MAX_VALUE},          // WORKER
+    {10, RoleBoost::MASK_LITTLE, true, 0, 384},                                                // BACKGROUND
+};
+
+constexpr uint16_t kPerformanceCriticalUclampMin = 768;
+
+bool isDigits(const char* name) {
+    if (*name == '\0') {
+        return false;
+    }
+    for (; *name; ++name) {
+        if (*name < '0' || *name > '9') {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+UIEEThreadRoleScheduler::UIEEThreadRoleScheduler(UIEEPlacementEngine& placement, const UIEECpuTopology& topology)
+    : placement_(placement), topology_(topology) {}
+
+UIEEThreadRoleScheduler::Role UIEEThreadRoleScheduler::classify(const char* comm, size_t length, bool is_main) {
+    if (is_main) {
+        return ROLE_MAIN;
+    }
+    for (const auto& pattern : kRolePatterns) {
+        size_t prefix_length = strlen(pattern.prefix);
+        if (length >= prefix_length && memcmp(comm, pattern.prefix, prefix_length) == 0) {
+            return pattern.role;
+        }
+    }
+    return ROLE_OTHER;
+}
+
+const char* UIEEThreadRoleScheduler::roleName(Role role) {
+    switch (role) {
+        case ROLE_MAIN: return "main";
+        case ROLE_RENDER: return "render";
+        case ROLE_WORKER: return "worker";
+        case ROLE_BACKGROUND: return "background";
+        default: return "other";
+    }
+}
+
+UIEEThreadRoleScheduler::Role UIEEThreadRoleScheduler::readRole(int pid, int tid) {
+    if (tid == pid) {
+        return ROLE_MAIN;
+    }
+    char path[48];
+    snprintf(path, sizeof(path), "/proc/%d/task/%d/comm", pid, tid);
+    int fd = ::open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return ROLE_OTHER;
+    }
+    char comm[32];
+    ssize_t n = ::read(fd, comm, sizeof(comm));
+    ::close(fd);
+    if (n <= 0) {
+        return ROLE_OTHER;
+    }
+    size_t length = static_cast<size_t>(n);
+    if (comm[length - 1] == '\n') {
+        length--;
+    }
+    return classify(comm, length, false);
+}
+
+bool UIEEThreadRoleScheduler::scan(int pid, ProcessThreads& process) {
+    char path[32];
+    snprintf(path, sizeof(path), "/proc/%d/task", pid);
+    DIR* dir = opendir(path);
+    if (dir == nullptr) {
+        return false;
+    }
+    tid_buffer_.clear();
+    struct dirent* entry;
+    while ((entry = readdir(dir)) != nullptr && tid_buffer_.size() < MAX_THREADS) {
+        if (isDigits(entry->d_name)) {
+            tid_buffer_.push_back(atoi(entry->d_name));
+        }
+    }
+    closedir(dir);
+    std::sort(tid_buffer_.begin(), tid_buffer_.end());
+
+    // 与缓存做有序归并：已知线程沿用角色，只为新线程（以及到期的未识别线程）读取 comm
+    merge_buffer_.clear();
+    auto known = process.threads.begin();
+    for (int tid : tid_buffer_) {
+        while (known != process.threads.end() && known->tid < tid) {
+            ++known;
+        }
+        if (known != process.threads.end() && known->tid == tid) {
+            ThreadEntry thread = *known;
+            if (thread.role == ROLE_OTHER && ++thread.scans_since_classify >= RECLASSIFY_SCANS) {
+                thread.role = readRole(pid, tid);
+                thread.scans_since_classify = 0;
+            }
+            merge_buffer_.push_back(thread);
+            continue;
+        }
+        ThreadEntry thread;
+        thread.tid = tid;
+        thread.role = readRole(pid, tid);
+        thread.scans_since_classify = 0;
+        thread.original_nice = NICE_UNSET;
+        thread.applied_nice = NICE_UNSET;
+        thread.applied_mask = 0;
+        thread.applied_uclamp_min = 0;
+        thread.applied_uclamp_max = UIEEPlacementEngine::UCLAMP_MAX_VALUE;
+        thread.uclamp_applied = false;
+        merge_buffer_.push_back(thread);
+    }
+    process.threads.swap(merge_buffer_);
+    return true;
+}
+
+bool UIEEThreadRoleScheduler::apply(int pid, const UIEEPlacementEngine::Placement& placement,
+                                    UIEEPlacementEngine::Stats& stats) {
+    ProcessThreads& process = processes_[pid];
+    if (!scan(pid, process)) {
+        processes_.erase(pid);
+        errno = ESRCH;
+        return false;
+    }
+
+    // 同构CPU上小核掩码与全部核心相同，不再单独下发
+    const uint32_t little_mask = topology_.clusterCount() > 1 ?
+        topology_.clusterMask(UIEECpuTopology::CLUSTER_LITTLE) : 0;
+    const bool performance = placement.tier == UIEEPlacementEngine::TIER_PERFORMANCE;
+
+    for (auto& thread : process.threads) {
+        const RoleBoost& boost = kRoleBoosts[thread.role];
+
+        if (boost.nice != kNoChange && thread.applied_nice != boost.nice) {
+            if (thread.original_nice == NICE_UNSET) {
+                errno = 0;
+                int current = getpriority(PRIO_PROCESS, thread.tid);
+                if (errno != 0) {
+                    continue;
+                }
+                thread.original_nice = static_cast<int8_t>(current);
+            }
+            // 失败同样记为已尝试，权限不足时每tick重试只会得到同样的结果
+            thread.applied_nice = boost.nice;
+            placement_.setThreadNice(thread.tid, boost.nice, stats);
+        }
+
+        uint32_t mask = 0;
+        if (boost.mask == RoleBoost::MASK_PLACEMENT) {
+            mask = placement.cpu_mask;
+        } else if (boost.mask == RoleBoost::MASK_LITTLE) {
+            mask = little_mask;
+        }
+        if (mask != 0 && thread.applied_mask != mask) {
+            thread.applied_mask = mask;
+            placement_.setThreadAffinity(thread.tid, mask, stats);
+        }
+
+        if (boost.uclamp && placement_.uclampSupported()) {
+            uint16_t uclamp_min = boost.uclamp_min;
+            if (performance && boost.uclamp_min > 0) {
+                uclamp_min = kPerformanceCriticalUclampMin;
+            }
+            if (!thread.uclamp_applied || thread.applied_uclamp_min != uclamp_min ||
+                thread.applied_uclamp_max != boost.uclamp_max) {
+                thread.uclamp_applied = true;
+                thread.applied_uclamp_min = uclamp_min;
+                thread.applied_uclamp_max = boost.uclamp_max;
+                placement_.setThreadUclamp(thread.tid, uclamp_min, boost.uclamp_max, stats);
+            }
+        }
+    }
+    stats.threads += static_cast<int>(process.threads.size());
+    return true;
+}
+
+bool UIEEThreadRoleScheduler::restore(int pid, uint32_t restore_mask, UIEEPlacementEngine::Stats& stats) {
+    auto found = processes_.find(pid);
+    if (found == processes_.end()) {
+        return true;
+    }
+    for (const auto& thread : found->second.threads) {
+        if (thread.original_nice != NICE_UNSET) {
+            placement_.setThreadNice(thread.tid, thread.original_nice, stats);
+        }
+        if (thread.applied_mask != 0) {
+            placement_.setThreadAffinity(thread.tid, restore_mask, stats);
+        }
+        if (thread.uclamp_applied) {
+            placement_.setThreadUclamp(thread.tid, 0, UIEEPlacementEngine::UCLAMP_MAX_VALUE, stats);
+        }
+    }
+    processes_.erase(found);
+    return true;
+}
+
+void UIEEThreadRoleScheduler::invalidate(int pid) {
+    auto found = processes_.find(pid);
+    if (found == processes_.end()) {
+        return;
+    }
+    for (auto& thread : found->second.threads) {
+        thread.applied_mask = 0;
+        thread.uclamp_applied = false;
+    }
+}
+
+bool UIEEThreadRoleScheduler::summary(int pid, RoleSummary& out) const {
+    auto found = processes_.find(pid);
+    if (found == processes_.end()) {
+        return false;
+    }
+    out = RoleSummary{};
+    for (const auto& thread : found->second.threads) {
+        out.threads++;
+        out.roles[thread.role]++;
+    }
+    return true;
+}
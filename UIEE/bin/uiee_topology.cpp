@@ -0,0 +1,249 @@
+#include "uiee_topology.h"
+#include <algorithm>
+
+// CPU拓扑实现
+
+UIEECpuTopology::UIEECpuTopology() : core_count_(0) {
+    std::fill(std::begin(core_to_cluster_), std::end(core_to_cluster_), -1);
+    std::fill(std::begin(core_capacity_), std::end(core_capacity_), 0u);
+    freq_buffer_[0] = '\0';
+}
+
+bool UIEECpuTopology::readU64File(const std::string& path, uint64_t& value) {
+    UIEEProcFile file(path);
+    char buffer[64];
+    ssize_t n = file.read(buffer, sizeof(buffer));
+    if (n <= 0) {
+        return false;
+    }
+    UIEEScanner scanner(buffer, static_cast<size_t>(n));
+    return scanner.readU64(value);
+}
+
+uint32_t UIEECpuTopology::parseCpuList(const char* text, size_t length) {
+    // 同时兼容 "0 1 2 3"（related_cpus）与 "0-3,6"（cpulist）两种格式
+    uint32_t mask = 0;
+    UIEEScanner scanner(text, length);
+    while (!scanner.atEnd()) {
+        uint64_t first = 0;
+        if (!scanner.readU64(first)) {
+            if (scanner.consume(",") || scanner.consume("\n")) {
+                continue;
+            }
+            break;
+        }
+        uint64_t last = first;
+        if (scanner.consume("-")) {
+            scanner.readU64(last);
+        }
+        for (uint64_t cpu = first; cpu <= last && cpu < static_cast<uint64_t>(MAX_CPU_CORES); ++cpu) {
+            mask |= 1u << cpu;
+        }
+        scanner.consume(",");
+    }
+    return mask;
+}
+
+bool UIEECpuTopology::discover(int fallback_cores, const std::string& sysfs_root) {
+    clusters_.clear();
+    cur_freq_files_.clear();
+    std::fill(std::begin(core_to_cluster_), std::end(core_to_cluster_), -1);
+    std::fill(std::begin(core_capacity_), std::end(core_capacity_), 0u);
+
+    // 读取在线CPU范围
+    uint32_t possible_mask = 0;
+    {
+        UIEEProcFile present(sysfs_root + "/present");
+        char buffer[64];
+        ssize_t n = present.read(buffer, sizeof(buffer));
+        if (n > 0) {
+            possible_mask = parseCpuList(buffer, static_cast<size_t>(n));
+        }
+    }
+    if (possible_mask == 0) {
+        int cores = std::max(1, std::min(fallback_cores, MAX_CPU_CORES));
+        possible_mask = (1u << cores) - 1;
+    }
+
+    core_count_ = 0;
+    for (int cpu = 0; cpu < MAX_CPU_CORES; ++cpu) {
+        if (possible_mask & (1u << cpu)) {
+            core_count_ = cpu + 1;
+        }
+    }
+
+    // 按 policy 收集簇，related_cpus 相同的核心属于同一簇
+    uint32_t assigned = 0;
+    for (int cpu = 0; cpu < core_count_; ++cpu) {
+        if (!(possible_mask & (1u << cpu)) || (assigned & (1u << cpu))) {
+            continue;
+        }
+
+        std::string cpu_dir = sysfs_root + "/cpu" + std::to_string(cpu);
+        uint32_t related = 0;
+        {
+            UIEEProcFile related_file(cpu_dir + "/cpufreq/related_cpus");
+            char buffer[128];
+            ssize_t n = related_file.read(buffer, sizeof(buffer));
+            if (n > 0) {
+                related = parseCpuList(buffer, static_cast<size_t>(n));
+            }
+        }
+        if (related == 0) {
+            related = 1u << cpu;
+        }
+        related &= possible_mask & ~assigned;
+        related |= 1u << cpu;
+
+        Cluster cluster{};
+        cluster.type = CLUSTER_BIG;
+        cluster.cpu_mask = related;
+        cluster.first_cpu = cpu;
+        cluster.core_count = __builtin_popcount(related);
+
+        uint64_t value = 0;
+        if (readU64File(cpu_dir + "/cpufreq/cpuinfo_max_freq", value)) {
+            cluster.max_freq_khz = static_cast<uint32_t>(value);
+        }
+        if (readU64File(cpu_dir + "/cpufreq/cpuinfo_min_freq", value)) {
+            cluster.min_freq_khz = static_cast<uint32_t>(value);
+        }
+        if (readU64File(cpu_dir + "/cpu_capacity", value)) {
+            cluster.capacity = static_cast<uint32_t>(value);
+        }
+
+        assigned |= related;
+        clusters_.push_back(cluster);
+        if (static_cast<int>(clusters_.size()) >= MAX_CLUSTERS) {
+            break;
+        }
+    }
+
+    // 剩余未归类的核心（簇数超限或 cpufreq 缺失）并入最后一个簇
+    uint32_t leftover = possible_mask & ~assigned;
+    if (leftover && !clusters_.empty()) {
+        clusters_.back().cpu_mask |= leftover;
+        clusters_.back().core_count = __builtin_popcount(clusters_.back().cpu_mask);
+    }
+
+    bool discovered = !clusters_.empty() && clusters_.front().max_freq_khz > 0;
+    if (clusters_.empty()) {
+        Cluster cluster{};
+        cluster.type = CLUSTER_BIG;
+        cluster.cpu_mask = possible_mask;
+        cluster.first_cpu = 0;
+        cluster.core_count = __builtin_popcount(possible_mask);
+        clusters_.push_back(cluster);
+    }
+
+    // 没有 cpu_capacity 的内核按最高频率比较
+    uint32_t max_freq = 0;
+    for (const auto& cluster : clusters_) {
+        max_freq = std::max(max_freq, cluster.max_freq_khz);
+    }
+    for (auto& cluster : clusters_) {
+        if (cluster.capacity == 0) {
+            cluster.capacity = max_freq > 0 ?
+                static_cast<uint32_t>(1024ull * cluster.max_freq_khz / max_freq) : 1024;
+        }
+    }
+
+    std::sort(clusters_.begin(), clusters_.end(), [](const Cluster& a, const Cluster& b) {
+        return a.capacity != b.capacity ? a.capacity < b.capacity : a.first_cpu < b.first_cpu;
+    });
+
+    // 单簇视为大核；两簇为小核+大核；三簇及以上最低为小核、最高为超大核
+    size_t count = clusters_.size();
+    for (size_t i = 0; i < count; ++i) {
+        if (count == 1) {
+            clusters_[i].type = CLUSTER_BIG;
+        } else if (i == 0) {
+            clusters_[i].type = CLUSTER_LITTLE;
+        } else if (count >= 3 && i == count - 1) {
+            clusters_[i].type = CLUSTER_PRIME;
+        } else {
+            clusters_[i].type = CLUSTER_BIG;
+        }
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        for (int cpu = 0; cpu < MAX_CPU_CORES; ++cpu) {
+            if (clusters_[i].cpu_mask & (1u << cpu)) {
+                core_to_cluster_[cpu] = static_cast<int>(i);
+                core_capacity_[cpu] = clusters_[i].capacity;
+            }
+        }
+        cur_freq_files_.emplace_back(sysfs_root + "/cpu" + std::to_string(clusters_[i].first_cpu) +
+                                     "/cpufreq/scaling_cur_freq");
+        cur_freq_files_.back().open();
+    }
+
+    return discovered;
+}
+
+int UIEECpuTopology::clusterOfCore(int cpu) const {
+    if (cpu < 0 || cpu >= MAX_CPU_CORES) {
+        return -1;
+    }
+    return core_to_cluster_[cpu];
+}
+
+int UIEECpuTopology::clusterIndex(ClusterType type) const {
+    // 从请求的类型向下回退，保证总能返回一个簇
+    for (int wanted = static_cast<int>(type); wanted >= 0; --wanted) {
+        for (size_t i = 0; i < clusters_.size(); ++i) {
+            if (static_cast<int>(clusters_[i].type) == wanted) {
+                return static_cast<int>(i);
+            }
+        }
+    }
+    return clusters_.empty() ? -1 : static_cast<int>(clusters_.size()) - 1;
+}
+
+uint32_t UIEECpuTopology::clusterMask(ClusterType type) const {
+    int index = clusterIndex(type);
+    return index >= 0 ? clusters_[index].cpu_mask : 0;
+}
+
+uint32_t UIEECpuTopology::coreMaxFrequency(int cpu) const {
+    int index = clusterOfCore(cpu);
+    return index >= 0 ? clusters_[index].max_freq_khz : 0;
+}
+
+uint32_t UIEECpuTopology::coreCapacity(int cpu) const {
+    if (cpu < 0 || cpu >= MAX_CPU_CORES) {
+        return 0;
+    }
+    return core_capacity_[cpu];
+}
+
+void UIEECpuTopology::sampleFrequencies(uint32_t* core_freq_khz, int max_cores) {
+    std::lock_guard<std::mutex> lock(freq_mutex_);
+
+    for (int cpu = 0; cpu < max_cores; ++cpu) {
+        core_freq_khz[cpu] = 0;
+    }
+
+    for (size_t i = 0; i < clusters_.size() && i < cur_freq_files_.size(); ++i) {
+        ssize_t n = cur_freq_files_[i].read(freq_buffer_, sizeof(freq_buffer_));
+        uint64_t freq = 0;
+        if (n > 0) {
+            UIEEScanner scanner(freq_buffer_, static_cast<size_t>(n));
+            scanner.readU64(freq);
+        }
+        for (int cpu = 0; cpu < max_cores && cpu < MAX_CPU_CORES; ++cpu) {
+            if (clusters_[i].cpu_mask & (1u << cpu)) {
+                core_freq_khz[cpu] = static_cast<uint32_t>(freq);
+            }
+        }
+    }
+}
+
+const char* UIEECpuTopology::clusterTypeName(ClusterType type) {
+    switch (type) {
+        case CLUSTER_LITTLE: return "little";
+        case CLUSTER_BIG: return "big";
+        case CLUSTER_PRIME: return "prime";
+    }
+    return "unknown";
+}
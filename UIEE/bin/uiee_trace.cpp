@@ -0,0 +1,221 @@
+#include "uiee_trace.h"
+#include <algorithm>
+#include <cstdio>
+#include <fcntl.h>
+#include <unistd.h>
+
+// 热路径分阶段计时实现
+
+UIEETracer& UIEETracer::instance() {
+    static UIEETracer tracer;
+    return tracer;
+}
+
+UIEETracer::UIEETracer() : marker_fd_(-1), marker_enabled_(false), pid_(static_cast<int>(getpid())) {
+    reset();
+}
+
+UIEETracer::~UIEETracer() {
+    marker_enabled_ = false;
+    if (marker_fd_ >= 0) {
+        close(marker_fd_);
+    }
+}
+
+void UIEETracer::reset() {
+    for (auto& histogram : histograms_) {
+        for (auto& bucket : histogram.buckets) {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+        histogram.count.store(0, std::memory_order_relaxed);
+        histogram.sum_ns.store(0, std::memory_order_relaxed);
+        histogram.max_ns.store(0, std::memory_order_relaxed);
+    }
+    for (auto& counter : counters_) {
+        counter.store(0, std::memory_order_relaxed);
+    }
+}
+
+int UIEETracer::bucketIndex(uint64_t nanoseconds) {
+    if (nanoseconds < LINEAR_BUCKETS) {
+        return static_cast<int>(nanoseconds);
+    }
+    int exponent = 63 - __builtin_clzll(nanoseconds);
+    if (exponent > MAX_EXPONENT) {
+        return BUCKETS - 1;
+    }
+    int sub = static_cast<int>((nanoseconds >> (exponent - SUB_BUCKET_BITS)) & ((1 << SUB_BUCKET_BITS) - 1));
+    return LINEAR_BUCKETS + (exponent - 4) * (1 << SUB_BUCKET_BITS) + sub;
+}
+
+uint64_t UIEETracer::bucketUpperBound(int index) {
+    if (index < LINEAR_BUCKETS) {
+        return static_cast<uint64_t>(index);
+    }
+    int exponent = 4 + (index - LINEAR_BUCKETS) / (1 << SUB_BUCKET_BITS);
+    uint64_t sub = static_cast<uint64_t>((index - LINEAR_BUCKETS) % (1 << SUB_BUCKET_BITS));
+    uint64_t width = 1ull << (exponent - SUB_BUCKET_BITS);
+    return ((1ull << SUB_BUCKET_BITS) + sub) * width + width - 1;
+}
+
+void UIEETracer::record(Phase phase, uint64_t nanoseconds) {
+    Histogram& histogram = histograms_[phase];
+    histogram.buckets[bucketIndex(nanoseconds)].fetch_add(1, std::memory_order_relaxed);
+    histogram.count.fetch_add(1, std::memory_order_relaxed);
+    histogram.sum_ns.fetch_add(nanoseconds, std::memory_order_relaxed);
+    uint64_t max = histogram.max_ns.load(std::memory_order_relaxed);
+    while (nanoseconds > max &&
+           !histogram.max_ns.compare_exchange_weak(max, nanoseconds, std::memory_order_relaxed)) {
+    }
+}
+
+double UIEETracer::percentile(const uint64_t* buckets, uint64_t count, double fraction) {
+    // 取累计计数首次达到 fraction 的桶的上界
+    uint64_t rank = static_cast<uint64_t>(fraction * count + 0.999999);
+    rank = rank == 0 ? 1 : rank;
+    uint64_t seen = 0;
+    for (int i = 0; i < BUCKETS; ++i) {
+        seen += buckets[i];
+        if (seen >= rank) {
+            return bucketUpperBound(i) / 1000.0;
+        }
+    }
+    return bucketUpperBound(BUCKETS - 1) / 1000.0;
+}
+
+UIEETracer::PhaseSummary UIEETracer::summary(Phase phase) const {
+    // 各桶分别 relaxed 读取，并发记录时总数可能与桶和差一两个，只影响近似分位
+    const Histogram& histogram = histograms_[phase];
+    uint64_t buckets[BUCKETS];
+    uint64_t count = 0;
+    for (int i = 0; i < BUCKETS; ++i) {
+        buckets[i] = histogram.buckets[i].load(std::memory_order_relaxed);
+        count += buckets[i];
+    }
+
+    PhaseSummary summary{};
+    summary.count = count;
+    if (count == 0) {
+        return summary;
+    }
+    uint64_t max_ns = histogram.max_ns.load(std::memory_order_relaxed);
+    summary.mean_us = histogram.sum_ns.load(std::memory_order_relaxed) / 1000.0 / count;
+    summary.max_us = max_ns / 1000.0;
+    summary.p50_us = std::min(percentile(buckets, count, 0.50), summary.max_us);
+    summary.p90_us = std::min(percentile(buckets, count, 0.90), summary.max_us);
+    summary.p99_us = std::min(percentile(buckets, count, 0.99), summary.max_us);
+    return summary;
+}
+
+bool UIEETracer::setMarkerEnabled(bool enabled) {
+    if (!enabled) {
+        marker_enabled_.store(false, std::memory_order_release);
+        return true;
+    }
+    if (marker_fd_ < 0) {
+        static const char* const kMarkerPaths[] = {
+            "/sys/kernel/tracing/trace_marker",
+            "/sys/kernel/debug/tracing/trace_marker",
+        };
+        for (const char* path : kMarkerPaths) {
+            marker_fd_ = open(path, O_WRONLY | O_CLOEXEC);
+            if (marker_fd_ >= 0) {
+                break;
+            }
+        }
+        if (marker_fd_ < 0) {
+            return false;
+        }
+    }
+    marker_enabled_.store(true, std::memory_order_release);
+    return true;
+}
+
+void UIEETracer::writeMarker(const char* buffer, int length) {
+    if (length <= 0) {
+        return;
+    }
+    // ftrace 关闭时写入失败，忽略即可
+    ssize_t written = write(marker_fd_, buffer, static_cast<size_t>(length));
+    (void)written;
+}
+
+void UIEETracer::markBegin(Phase phase) {
+    char buffer[64];
+    writeMarker(buffer, snprintf(buffer, sizeof(buffer), "B|%d|uiee:%s", pid_, phaseName(phase)));
+}
+
+void UIEETracer::markEnd() {
+    char buffer[24];
+    writeMarker(buffer, snprintf(buffer, sizeof(buffer), "E|%d", pid_));
+}
+
+const char* UIEETracer::phaseName(Phase phase) {
+    switch (phase) {
+        case PHASE_SCHEDULING: return "scheduling";
+        case PHASE_MONITOR_SCAN: return "monitor_scan";
+        case PHASE_METRICS_SAMPLE: return "metrics_sample";
+        case PHASE_FITNESS_BATCH: return "fitness_batch";
+        case PHASE_GAME_ROUND: return "game_round";
+        case PHASE_POLICY_APPLY: return "policy_apply";
+        default: return "unknown";
+    }
+}
+
+const char* UIEETracer::counterName(Counter counter) {
+    switch (counter) {
+        case COUNTER_POLICY_SYSCALLS: return "policy_syscalls";
+        case COUNTER_POLICY_FAILURES: return "policy_failures";
+        case COUNTER_POLICY_SKIPPED: return "policy_skipped";
+        case COUNTER_FITNESS_EVALUATIONS: return "fitness_evaluations";
+        case COUNTER_TASKS_SCANNED: return "tasks_scanned";
+        default: return "unknown";
+    }
+}
+
+void UIEETracer::appendJson(std::string& out) const {
+    char buffer[256];
+    for (int i = 0; i < PHASE_COUNT; ++i) {
+        PhaseSummary s = summary(static_cast<Phase>(i));
+        int n = snprintf(buffer, sizeof(buffer),
+                         "%s\"%s\": {\"count\": %llu, \"mean_us\": %.1f, \"p50_us\": %.1f, \"p90_us\": %.1f, "
+                         "\"p99_us\": %.1f, \"max_us\": %.1f}",
+                         i == 0 ? "" : ", ", phaseName(static_cast<Phase>(i)),
+                         static_cast<unsigned long long>(s.count), s.mean_us, s.p50_us, s.p90_us, s.p99_us, s.max_us);
+        if (n > 0) {
+            out.append(buffer, std::min(static_cast<size_t>(n), sizeof(buffer) - 1));
+        }
+    }
+    out += ", \"counters\": {";
+    for (int i = 0; i < COUNTER_COUNT; ++i) {
+        int n = snprintf(buffer, sizeof(buffer), "%s\"%s\": %llu", i == 0 ? "" : ", ",
+                         counterName(static_cast<Counter>(i)),
+                         static_cast<unsigned long long>(counter(static_cast<Counter>(i))));
+        if (n > 0) {
+            out.append(buffer, std::min(static_cast<size_t>(n), sizeof(buffer) - 1));
+        }
+    }
+    out += "}";
+}
+
+void UIEETracer::appendReport(std::string& out) const {
+    char buffer[256];
+    out += "阶段耗时 (微秒)     次数        均值       p50       p90       p99       最大\n";
+    for (int i = 0; i < PHASE_COUNT; ++i) {
+        PhaseSummary s = summary(static_cast<Phase>(i));
+        int n = snprintf(buffer, sizeof(buffer), "  %-16s %8llu %10.1f %9.1f %9.1f %9.1f %10.1f\n",
+                         phaseName(static_cast<Phase>(i)), static_cast<unsigned long long>(s.count),
+                         s.mean_us, s.p50_us, s.p90_us, s.p99_us, s.max_us);
+        if (n > 0) {
+            out.append(buffer, std::min(static_cast<size_t>(n), sizeof(buffer) - 1));
+        }
+    }
+    for (int i = 0; i < COUNTER_COUNT; ++i) {
+        int n = snprintf(buffer, sizeof(buffer), "  %s: %llu\n", counterName(static_cast<Counter>(i)),
+                         static_cast<unsigned long long>(counter(static_cast<Counter>(i))));
+        if (n > 0) {
+            out.append(buffer, std::min(static_cast<size_t>(n), sizeof(buffer) - 1));
+        }
+    }
+    out += std::string("  trace_marker: ") + (markerEnabled() ? "开" : "关") + "\n";
+}
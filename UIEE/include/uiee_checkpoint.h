@@ -0,0 +1,96 @@
+#ifndef UIEE_CHECKPOINT_H
+#define UIEE_CHECKPOINT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// 版本化二进制检查点
+// 布局：文件头 | 段表 | 各段数据（8字节对齐）。每段以四字符标签标识，读取端按标签取段，
+// 未知的段直接忽略，新增段不需要改版本号；段内记录格式变化时由调用方提升 format_version。
+// 校验和（FNV-1a 64）覆盖文件头之后的全部内容。
+// 写入先落到同目录临时文件，fsync 后 rename 覆盖，任何时刻磁盘上都是一份完整的检查点；
+// 读取端 mmap 整个文件，校验通过后段数据直接指向映射区，不做解析和拷贝。
+
+constexpr uint32_t uieeCheckpointTag(char a, char b, char c, char d) {
+    return static_cast<uint32_t>(static_cast<uint8_t>(a)) |
+           static_cast<uint32_t>(static_cast<uint8_t>(b)) << 8 |
+           static_cast<uint32_t>(static_cast<uint8_t>(c)) << 16 |
+           static_cast<uint32_t>(static_cast<uint8_t>(d)) << 24;
+}
+
+class UIEECheckpointWriter {
+public:
+    explicit UIEECheckpointWriter(uint32_t format_version) : format_version_(format_version) {}
+
+    // 数据立即拷贝，调用返回后源缓冲即可释放
+    void addSection(uint32_t tag, const void* data, size_t size);
+
+    template <typename T>
+    void addArray(uint32_t tag, const T* data, size_t count) {
+        static_assert(std::is_trivially_copyable<T>::value, "检查点段只能保存可平凡拷贝的记录");
+        addSection(tag, data, count * sizeof(T));
+    }
+
+    // 原子写入 path，失败时返回 false 并保留 errno，原文件不受影响
+    bool commit(const std::string& path) const;
+
+private:
+    struct Section {
+        uint32_t tag;
+        uint64_t offset;    // 相对数据区起点
+        uint64_t size;
+    };
+
+    uint32_t format_version_;
+    std::vector<Section> sections_;
+    std::vector<uint8_t> data_;
+};
+
+class UIEECheckpointReader {
+public:
+    UIEECheckpointReader() = default;
+    ~UIEECheckpointReader() { close(); }
+
+    UIEECheckpointReader(const UIEECheckpointReader&) = delete;
+    UIEECheckpointReader& operator=(const UIEECheckpointReader&) = delete;
+
+    // 映射并校验；文件不存在、魔数/版本不符、长度或校验和不一致时返回 false
+    bool open(const std::string& path, uint32_t format_version);
+    void close();
+    bool isOpen() const { return mapping_ != nullptr; }
+
+    // 段不存在时返回 nullptr；指针在 close() 之前有效
+    const void* section(uint32_t tag, size_t& size) const;
+
+    // 段长度必须是记录大小的整数倍，否则视为不存在
+    template <typename T>
+    const T* array(uint32_t tag, size_t& count) const {
+        static_assert(std::is_trivially_copyable<T>::value, "检查点段只能保存可平凡拷贝的记录");
+        size_t size = 0;
+        const void* data = section(tag, size);
+        if (data == nullptr || size % sizeof(T) != 0) {
+            count = 0;
+            return nullptr;
+        }
+        count = size / sizeof(T);
+        return static_cast<const T*>(data);
+    }
+
+    int64_t createdAt() const { return created_at_; }
+    const char* failureReason() const { return failure_reason_; }
+
+private:
+    void* mapping_ = nullptr;
+    size_t mapping_size_ = 0;
+    const uint8_t* sections_ = nullptr;
+    uint32_t section_count_ = 0;
+    const uint8_t* data_ = nullptr;
+    uint64_t data_size_ = 0;
+    int64_t created_at_ = 0;
+    const char* failure_reason_ = "";
+};
+
+#endif // UIEE_CHECKPOINT_H
@@ -0,0 +1,46 @@
+#ifndef UIEE_CONFIG_WATCHER_H
+#define UIEE_CONFIG_WATCHER_H
+
+#include <string>
+#include <sys/types.h>
+#include <time.h>
+
+// 配置文件变更检测
+// inotify 监听文件所在目录并按文件名过滤：编辑器和 sed -i 先写临时文件再 rename 覆盖，
+// 直接监听文件本身会在替换后失效。关注写完关闭（IN_CLOSE_WRITE）与改名移入（IN_MOVED_TO）。
+// 由调用方定期 poll()（非阻塞），同一周期内的多次写入合并为一次变更；
+// inotify 不可用时退化为比较文件的 mtime/大小/inode。
+class UIEEConfigWatcher {
+public:
+    UIEEConfigWatcher();
+    ~UIEEConfigWatcher();
+
+    UIEEConfigWatcher(const UIEEConfigWatcher&) = delete;
+    UIEEConfigWatcher& operator=(const UIEEConfigWatcher&) = delete;
+
+    // 开始监听 path，之前的监听被替换；文件所在目录不存在时返回 false
+    bool watch(const std::string& path);
+    void close();
+
+    // 自上次调用以来文件被改写或替换时返回 true
+    bool poll();
+
+    bool isEventDriven() const { return inotify_fd_ >= 0; }
+    const std::string& path() const { return path_; }
+
+private:
+    std::string path_;
+    std::string name_;     // 目录项名，用于过滤目录内的其他文件
+    int inotify_fd_;
+
+    // 轮询回退时比较的文件状态
+    bool have_stat_;
+    dev_t device_;
+    ino_t inode_;
+    off_t size_;
+    struct timespec mtime_;
+
+    bool statChanged();
+};
+
+#endif // UIEE_CONFIG_WATCHER_H
@@ -0,0 +1,57 @@
+#ifndef UIEE_EVENT_SCHEDULER_H
+#define UIEE_EVENT_SCHEDULER_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+// 引擎工作循环的统一定时/事件等待
+// 每个循环注册一个计时器（毫秒周期），在 waitFor 中等待自己的下一个截止时间或关注的触发事件。
+// 截止时间按周期累加，不随循环体耗时漂移；事件唤醒后重新从当前时刻起算一个完整周期。
+// 使用独立的互斥量和条件变量，与任务表等业务锁无关。
+class UIEEEventScheduler {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    enum Trigger : uint32_t {
+        TRIGGER_NONE              = 0,
+        TRIGGER_FOREGROUND_CHANGE = 1u << 0,   // 前台应用/场景变化
+        TRIGGER_THERMAL           = 1u << 1,   // 温度越过阈值档位
+        TRIGGER_NEW_TASK          = 1u << 2,   // 新进程启动
+        TRIGGER_CONFIG_CHANGE     = 1u << 3,   // 配置变化
+        TRIGGER_RESYNC            = 1u << 4,   // 需要全量校正任务表
+        TRIGGER_PRESSURE          = 1u << 5,   // PSI 内存/I/O 压力触发
+        TRIGGER_TIMER             = 1u << 30,  // 周期截止时间到达（仅作为返回值）
+        TRIGGER_SHUTDOWN          = 1u << 31   // 循环应当退出，总是会唤醒等待者
+    };
+
+    // 注册计时器，返回ID；min_gap 为两次事件唤醒之间的最小间隔，用于合并突发事件
+    int addTimer(std::chrono::milliseconds period,
+                 std::chrono::milliseconds min_gap = std::chrono::milliseconds(0));
+    // 修改周期，立即按新周期重算截止时间
+    void setPeriod(int timer_id, std::chrono::milliseconds period);
+
+    // 等待截止时间或 trigger_mask 中的事件，返回本次唤醒的原因（按位）
+    uint32_t waitFor(int timer_id, uint32_t trigger_mask);
+
+    // 向所有计时器投递事件 / 只向指定计时器投递
+    void notify(uint32_t triggers);
+    void wake(int timer_id, uint32_t triggers);
+
+private:
+    struct Timer {
+        std::chrono::milliseconds period;
+        std::chrono::milliseconds min_gap;
+        Clock::time_point deadline;
+        Clock::time_point last_wake;
+        uint32_t pending;
+    };
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::vector<Timer> timers_;
+};
+
+#endif // UIEE_EVENT_SCHEDULER_H
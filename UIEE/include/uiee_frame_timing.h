@@ -0,0 +1,120 @@
+#ifndef UIEE_FRAME_TIMING_H
+#define UIEE_FRAME_TIMING_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include "uiee_ring_buffer.h"
+
+// 前台应用帧时序采集
+// 首选 `dumpsys SurfaceFlinger --latency <layer>`：每帧的实际上屏时刻（CLOCK_MONOTONIC 纳秒），
+// 对 SurfaceView/GL 游戏同样有效；找不到图层时退化为 `dumpsys gfxinfo <pkg> framestats`
+// 的 FrameCompleted 时刻（只覆盖 HWUI 绘制的普通应用）。
+// 两者都只保留最近约 128 帧，由采集线程每 POLL_PERIOD_MS 取一次，按时间戳去重后追加到环形缓冲；
+// 一次取回的帧数接近来源容量时说明中间可能溢出丢帧，插入断点，跨断点的间隔不参与统计。
+// dumpsys 以 posix_spawn 直接执行（不经过 shell），超过 COMMAND_TIMEOUT_MS 后结束子进程。
+// 一次采集通常一到两次 dumpsys、数十毫秒；最坏情况（列举图层 + --latency + gfxinfo 三次都超时）约 2.4 秒，
+// 因此放在独立线程中，不占用监控线程的 1 秒周期。
+class UIEEFrameTimingCollector {
+public:
+    enum Source {
+        SOURCE_NONE,
+        SOURCE_SURFACEFLINGER,
+        SOURCE_GFXINFO
+    };
+
+    // 最近 WINDOW_MS 内的帧统计；frames 不足 MIN_FRAMES（应用静止或无权限）时 valid 为 false
+    struct FrameStats {
+        bool valid;
+        Source source;
+        uint32_t frames;             // 参与统计的帧间隔数
+        double fps;
+        double frame_time_p50_ms;
+        double frame_time_p90_ms;
+        double frame_time_p99_ms;
+        uint32_t jank_count;         // 间隔超过 2 个目标帧周期（另有半个周期容差）
+        uint32_t big_jank_count;     // 间隔超过 4 个目标帧周期（同上）
+        double jank_rate;            // jank_count / frames
+        double refresh_period_ms;    // 显示刷新周期，来源不提供时为 0
+    };
+
+    static constexpr int64_t WINDOW_MS = 5000;
+    static constexpr uint32_t MIN_FRAMES = 10;
+    static constexpr int64_t IDLE_GAP_MS = 500;     // 超过该间隔视为应用没有在绘制，不计入帧率与卡顿
+
+    UIEEFrameTimingCollector();
+    ~UIEEFrameTimingCollector();
+
+    UIEEFrameTimingCollector(const UIEEFrameTimingCollector&) = delete;
+    UIEEFrameTimingCollector& operator=(const UIEEFrameTimingCollector&) = delete;
+
+    // 系统中没有 dumpsys（非 Android 环境）时返回 false
+    bool available() const { return available_; }
+
+    // 启动采集线程；没有 dumpsys 时返回 false。stop() 最多等待正在执行的一次 dumpsys 结束
+    bool start();
+    void stop();
+    bool isRunning() const { return running_; }
+
+    // 关闭后采集线程不再执行 dumpsys，已有的帧窗口保留到下次切换目标（任意线程）
+    void setEnabled(bool enabled) { enabled_ = enabled; }
+
+    // 前台应用变化时调用（任意线程），下一次采集重新查找图层并清空帧窗口
+    void setTarget(const std::string& package);
+
+    // 以 target_fps 为基准统计窗口内的帧（target_fps <= 0 时按刷新率，刷新率未知按 60）
+    FrameStats stats(double target_fps) const;
+
+    static const char* sourceName(Source source);
+
+private:
+    static constexpr size_t CAPACITY = 2048;          // 5 秒 @ 240Hz 外加断点余量
+    static constexpr int64_t DISCONTINUITY = 0;       // 缓冲中的断点标记
+    static constexpr int COMMAND_TIMEOUT_MS = 800;
+    static constexpr int POLL_PERIOD_MS = 1000;
+    static constexpr int MAX_EMPTY_POLLS = 3;         // 同一图层连续无帧后换下一个候选
+
+    bool available_;
+    std::atomic<bool> enabled_;
+    std::atomic<bool> running_;
+    std::thread thread_;
+    std::mutex wake_mutex_;
+    std::condition_variable wake_cv_;
+
+    // 目标应用在 target_mutex_ 下交接给监控线程
+    mutable std::mutex target_mutex_;
+    std::string pending_package_;
+    bool target_changed_;
+
+    // 以下仅采集线程访问
+    std::string package_;
+    std::vector<std::string> layers_;                 // 候选图层，按优先级排序
+    size_t layer_index_;
+    int empty_polls_;
+    int list_backoff_;                                // 没有候选图层时，距下次重新列举的 poll 次数
+    std::string output_;                              // dumpsys 输出，复用容量
+    std::vector<int64_t> batch_;                      // 本次取回的上屏时刻
+
+    // 帧窗口在 frames_mutex_ 下由 stats() 读取
+    mutable std::mutex frames_mutex_;
+    UIEERingBuffer<int64_t> presents_{CAPACITY};
+    int64_t last_present_ns_;
+    int64_t refresh_period_ns_;
+    Source source_;
+
+    void run();
+    // 取回新帧，取到时返回 true；只在采集线程调用
+    bool poll();
+    bool runDumpsys(const std::vector<std::string>& args);
+    void listLayers();
+    bool pollSurfaceFlinger(int64_t& refresh_period_ns);
+    bool pollGfxinfo();
+    void appendBatch(Source source, size_t source_capacity, int64_t refresh_period_ns);
+};
+
+#endif // UIEE_FRAME_TIMING_H
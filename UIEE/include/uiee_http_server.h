@@ -0,0 +1,147 @@
+#ifndef UIEE_HTTP_SERVER_H
+#define UIEE_HTTP_SERVER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <sys/types.h>
+
+// 内嵌 Web UI / 控制接口服务
+// 单线程 epoll 事件循环（独立线程），同时承担：
+//   - webroot 静态文件：sendfile 零拷贝发送；
+//   - 接口路由：处理函数在事件循环线程中执行，只应读取已发布的快照，不做采样；
+//   - Server-Sent Events：publish() 可在任意线程调用，经 eventfd 唤醒事件循环后推送给所有订阅者，
+//     新订阅者会立即收到每类事件的最近一条。
+// 支持 HTTP/1.1 keep-alive，不支持 chunked 请求体。
+// 非 GET/HEAD 的接口视为写操作，处理函数执行前要求：
+//   - Host 为本连接实际到达的地址（或回环地址上的 localhost），防止 DNS rebinding；
+//   - 带 Origin 时必须是 http://<Host>，浏览器跨站提交一律拒绝（403）；
+//   - Content-Type 为 application/json，表单与 text/plain 这类无需预检的跨站请求无法构造（415）；
+//   - 设置了访问令牌时 X-UIEE-Token 必须一致（403）。
+class UIEEHttpServer {
+public:
+    struct Request {
+        std::string method;
+        std::string path;      // 已去掉查询串
+        std::string query;
+        std::string host;
+        std::string origin;
+        std::string content_type;
+        std::string token;     // X-UIEE-Token
+        std::string body;
+    };
+
+    struct Response {
+        int status = 200;
+        std::string content_type = "application/json; charset=utf-8";
+        std::string body;
+    };
+
+    using Handler = std::function<Response(const Request& request)>;
+
+    UIEEHttpServer();
+    ~UIEEHttpServer();
+
+    UIEEHttpServer(const UIEEHttpServer&) = delete;
+    UIEEHttpServer& operator=(const UIEEHttpServer&) = delete;
+
+    // 以下配置须在 start() 之前调用
+    void setDocumentRoot(const std::string& root) { document_root_ = root; }
+    void addRoute(const std::string& method, const std::string& path, Handler handler);
+    void setEventStreamPath(const std::string& path) { event_stream_path_ = path; }
+    // 写接口要求的访问令牌，为空时只做来源与 Content-Type 检查
+    void setAccessToken(const std::string& token) { access_token_ = token; }
+
+    bool start(uint16_t port, const std::string& bind_address = "127.0.0.1");
+    void stop();
+    bool isRunning() const { return running_; }
+    uint16_t port() const { return port_; }
+
+    // 线程安全：向全部 SSE 订阅者推送一条事件（data 中不应包含换行）
+    void publish(const std::string& event, const std::string& data);
+
+    size_t getConnectionCount() const { return connection_count_; }
+    size_t getSubscriberCount() const { return subscriber_count_; }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr size_t MAX_CONNECTIONS = 64;
+    static constexpr size_t MAX_REQUEST_SIZE = 16 * 1024;
+    static constexpr size_t MAX_EVENT_BACKLOG = 256 * 1024;   // 订阅者积压超过该值时断开
+    static constexpr int IDLE_TIMEOUT_MS = 30000;
+    static constexpr int KEEPALIVE_INTERVAL_MS = 15000;       // SSE 注释行心跳，防止代理/浏览器超时
+
+    struct Connection {
+        int fd = -1;
+        std::string in;
+        std::string out;
+        size_t out_offset = 0;
+        int file_fd = -1;            // 正在 sendfile 的静态文件
+        off_t file_offset = 0;
+        off_t file_end = 0;
+        bool keep_alive = true;
+        bool event_stream = false;
+        bool loopback = false;       // 连接到达的是回环地址
+        std::string local_host;      // 连接到达的 "地址:端口"，用于校验 Host
+        uint32_t epoll_events = 0;   // 当前注册的 epoll 事件
+        Clock::time_point last_active;
+    };
+
+    std::string document_root_;
+    std::string event_stream_path_;
+    std::string access_token_;
+    std::map<std::pair<std::string, std::string>, Handler> routes_;
+
+    int listen_fd_;
+    int epoll_fd_;
+    int wake_fd_;
+    uint16_t port_;
+    std::atomic<bool> running_;
+    std::thread thread_;
+
+    // 仅事件循环线程访问
+    std::unordered_map<int, Connection> connections_;
+    std::map<std::string, std::string> last_events_;   // 事件名 -> 最近一条已格式化的事件
+    Clock::time_point last_keepalive_;
+
+    std::mutex pending_mutex_;
+    std::vector<std::pair<std::string, std::string>> pending_events_;
+
+    std::atomic<size_t> connection_count_;
+    std::atomic<size_t> subscriber_count_;
+
+    void eventLoop();
+    void acceptConnections();
+    // 以下三个返回 false 表示连接应当关闭，由事件循环统一关闭
+    bool handleReadable(Connection& connection);
+    bool handleWritable(Connection& connection);
+    bool processRequests(Connection& connection);
+    void closeConnection(int fd);
+    void updateInterest(Connection& connection);
+    void deliverPendingEvents();
+    void sweepConnections();
+
+    bool parseRequest(Connection& connection, Request& request, size_t& consumed, int& error_status);
+    void dispatch(Connection& connection, const Request& request);
+    int checkWriteRequest(const Connection& connection, const Request& request) const;
+    void serveFile(Connection& connection, const Request& request);
+    void serveEventStream(Connection& connection);
+    void sendResponse(Connection& connection, const Response& response, bool head_only = false);
+    void sendError(Connection& connection, int status, bool head_only = false);
+
+    static const char* statusText(int status);
+    static const char* contentType(const std::string& path);
+    static bool decodePath(const std::string& raw, std::string& decoded);
+    static std::string formatEvent(const std::string& event, const std::string& data);
+};
+
+#endif // UIEE_HTTP_SERVER_H
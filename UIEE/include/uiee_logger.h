@@ -0,0 +1,123 @@
+#ifndef UIEE_LOGGER_H
+#define UIEE_LOGGER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+
+// 异步日志后端
+// 生产者把日志写入定长无锁环形队列（多生产者/单消费者），只做一次CAS与一次拷贝，不加锁、不做I/O；
+// 后台写线程批量取出，按级别汇总到各日志文件后一次 write()，文件fd常驻并按大小轮转
+class UIEELogger {
+public:
+    enum Level : uint8_t {
+        LEVEL_DEBUG,
+        LEVEL_INFO,
+        LEVEL_WARNING,
+        LEVEL_ERROR,
+        LEVEL_PERF      // 性能日志，不参与级别过滤，由 enable_performance_log 控制
+    };
+
+    UIEELogger();
+    ~UIEELogger();
+
+    UIEELogger(const UIEELogger&) = delete;
+    UIEELogger& operator=(const UIEELogger&) = delete;
+
+    // 启动写线程；start 之前写入的日志保留在队列中，启动后一并落盘
+    bool start(const std::string& log_dir);
+    // 停止写线程并把队列中剩余日志全部写出
+    void stop();
+    bool isRunning() const { return running_; }
+
+    // 级别未启用时直接返回；队列满时丢弃并计数，不阻塞调用方
+    void log(Level level, std::string_view message);
+    bool isEnabled(Level level) const;
+
+    void setMinLevel(Level level) { min_level_ = level; }
+    Level getMinLevel() const { return min_level_; }
+    // 接受 DEBUG/INFO/WARNING/WARN/ERROR（大小写不敏感）
+    static bool parseLevel(const std::string& text, Level& level);
+
+    // 单个日志文件的轮转阈值，0 表示不轮转
+    void setMaxFileSize(size_t bytes) { max_file_size_ = bytes; }
+    void setPerformanceLogEnabled(bool enabled) { performance_log_enabled_ = enabled; }
+    void setErrorLogEnabled(bool enabled) { error_log_enabled_ = enabled; }
+
+    uint64_t getDroppedCount() const { return dropped_count_; }
+    const std::string& getLogDirectory() const { return log_dir_; }
+
+private:
+    static constexpr size_t RING_CAPACITY = 1024;        // 必须是2的幂
+    static constexpr size_t MAX_MESSAGE_LENGTH = 240;    // 超长消息截断
+    static constexpr int WRITER_IDLE_TIMEOUT_MS = 200;
+
+    struct Slot {
+        std::atomic<uint64_t> sequence;
+        int64_t timestamp;       // system_clock 秒，由写线程格式化
+        Level level;
+        uint16_t length;
+        char text[MAX_MESSAGE_LENGTH];
+    };
+
+    enum Sink {
+        SINK_ENGINE,        // engine.log（INFO/DEBUG）
+        SINK_SERVICE,       // service.log（WARNING，与 service.sh 共用）
+        SINK_ERROR,         // error.log
+        SINK_PERFORMANCE,   // performance.log
+        SINK_COUNT
+    };
+
+    struct SinkFile {
+        const char* name;
+        int fd;
+        size_t size;
+        int64_t last_open_attempt;
+        std::string pending;
+    };
+
+    std::unique_ptr<Slot[]> slots_;
+    alignas(64) std::atomic<uint64_t> enqueue_pos_;
+    alignas(64) uint64_t dequeue_pos_;       // 仅写线程访问
+
+    std::atomic<bool> running_;
+    std::atomic<bool> writer_sleeping_;
+    std::thread writer_thread_;
+    std::mutex wake_mutex_;
+    std::condition_variable wake_cv_;
+
+    std::atomic<Level> min_level_;
+    std::atomic<size_t> max_file_size_;
+    std::atomic<bool> performance_log_enabled_;
+    std::atomic<bool> error_log_enabled_;
+    std::atomic<uint64_t> dropped_count_;
+    uint64_t reported_dropped_;
+
+    std::string log_dir_;
+    SinkFile sinks_[SINK_COUNT];
+    std::string console_out_;
+    std::string console_err_;
+
+    // 时间戳缓存：同一秒内的日志复用格式化结果
+    int64_t cached_second_;
+    char cached_timestamp_[32];
+
+    void writerLoop();
+    bool drain();
+    void appendLine(const Slot& slot);
+    void flushPending();
+    const char* formatTimestamp(int64_t second);
+    bool openSink(SinkFile& sink, int64_t now);
+    void rotateSink(SinkFile& sink);
+    void closeSinks();
+    static void writeAll(int fd, const std::string& data);
+    static const char* levelName(Level level);
+};
+
+#endif // UIEE_LOGGER_H
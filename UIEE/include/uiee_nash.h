@@ -0,0 +1,98 @@
+#ifndef UIEE_NASH_H
+#define UIEE_NASH_H
+
+#include <cstddef>
+#include <vector>
+
+// 收益矩阵：行主序连续存储，rows × cols，允许非方阵
+class UIEEPayoffMatrix {
+public:
+    UIEEPayoffMatrix() : rows_(0), cols_(0) {}
+    UIEEPayoffMatrix(size_t rows, size_t cols, double value = 0.0)
+        : rows_(rows), cols_(cols), data_(rows * cols, value) {}
+
+    // 从嵌套 vector 构造；行长不一致时缺失项按 0 处理
+    static UIEEPayoffMatrix fromRows(const std::vector<std::vector<double>>& rows);
+    // 转置（对称博弈中列玩家的收益矩阵）
+    UIEEPayoffMatrix transposed() const;
+
+    void resize(size_t rows, size_t cols, double value = 0.0) {
+        rows_ = rows;
+        cols_ = cols;
+        data_.assign(rows * cols, value);
+    }
+
+    double& at(size_t row, size_t col) { return data_[row * cols_ + col]; }
+    double at(size_t row, size_t col) const { return data_[row * cols_ + col]; }
+    double* row(size_t index) { return data_.data() + index * cols_; }
+    const double* row(size_t index) const { return data_.data() + index * cols_; }
+
+    size_t rows() const { return rows_; }
+    size_t cols() const { return cols_; }
+    bool empty() const { return data_.empty(); }
+
+private:
+    size_t rows_;
+    size_t cols_;
+    std::vector<double> data_;
+};
+
+// 双矩阵博弈纳什均衡求解器
+// 小规模博弈用支撑集枚举求精确解；规模较大或退化博弈用 regret matching+ 迭代逼近。
+// 求解器保存上一次的均衡，维度不变时直接以其热启动：若上次的解对新矩阵仍是 ε-均衡则零迭代返回。
+// 不做内部加锁，由持有者负责同步。
+class UIEENashSolver {
+public:
+    struct Result {
+        std::vector<double> row_strategy;   // 行玩家混合策略
+        std::vector<double> col_strategy;   // 列玩家混合策略
+        double row_value = 0.0;             // 行玩家期望收益
+        double col_value = 0.0;             // 列玩家期望收益
+        double exploitability = 0.0;        // 双方单方面偏离可多得的收益之和
+        int iterations = 0;                 // 迭代次数（支撑集枚举为 0）
+        bool exact = false;                 // 是否由支撑集枚举得到
+        bool warm_started = false;
+    };
+
+    // 行数、列数都不超过该值时先尝试支撑集枚举
+    static constexpr size_t SUPPORT_ENUMERATION_LIMIT = 6;
+
+    void setTolerance(double tolerance) { tolerance_ = tolerance; }
+    void setMaxIterations(int iterations) { max_iterations_ = iterations; }
+    void reset() { previous_.row_strategy.clear(); previous_.col_strategy.clear(); }
+
+    // row_payoff / col_payoff 维度必须相同，否则返回 false
+    bool solve(const UIEEPayoffMatrix& row_payoff, const UIEEPayoffMatrix& col_payoff, Result& result);
+
+    // 给定策略组合下的可利用度与双方收益
+    static double exploitability(const UIEEPayoffMatrix& row_payoff, const UIEEPayoffMatrix& col_payoff,
+                                 const double* x, const double* y,
+                                 double* row_value = nullptr, double* col_value = nullptr);
+
+private:
+    double tolerance_ = 1e-6;
+    int max_iterations_ = 5000;
+    Result previous_;
+
+    // 迭代过程复用的缓冲，稳态下不分配
+    std::vector<double> row_regret_;
+    std::vector<double> col_regret_;
+    std::vector<double> row_average_;
+    std::vector<double> col_average_;
+    std::vector<double> row_current_;
+    std::vector<double> col_current_;
+    std::vector<double> utilities_;
+    std::vector<double> system_;
+    std::vector<size_t> row_support_;
+    std::vector<size_t> col_support_;
+
+    bool supportEnumeration(const UIEEPayoffMatrix& row_payoff, const UIEEPayoffMatrix& col_payoff,
+                            std::vector<double>& x, std::vector<double>& y);
+    bool solveIndifference(const UIEEPayoffMatrix& payoff, bool transpose,
+                           const std::vector<size_t>& own_support, const std::vector<size_t>& other_support,
+                           std::vector<double>& mix);
+    int regretMatching(const UIEEPayoffMatrix& row_payoff, const UIEEPayoffMatrix& col_payoff,
+                       const Result* warm, std::vector<double>& x, std::vector<double>& y);
+};
+
+#endif // UIEE_NASH_H
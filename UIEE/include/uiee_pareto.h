@@ -0,0 +1,190 @@
+#ifndef UIEE_PARETO_H
+#define UIEE_PARETO_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+// 三目标帕累托前沿
+// 所有目标统一按“越小越好”存放（最大化的目标由调用方取负）。
+// 一次性计算用 Kung 扫描：按字典序排序后维护后两维的阶梯集合，O(n log n)；
+// 已有前沿上的增量插入只与前沿比较，批量较大时合并后重新扫描。
+// 每个点带插入时的序号（例如代数），长期维护的前沿可按序号淘汰旧点并限制容量，
+// 避免早期工况下的点一直支配后来的候选。
+// 不做内部加锁，由持有者负责同步。
+template <typename Payload>
+class UIEEParetoFrontier {
+public:
+    static constexpr size_t OBJECTIVES = 3;
+
+    struct Entry {
+        double objectives[OBJECTIVES];
+        Payload payload;
+        uint64_t stamp = 0;        // 插入（或被相同的点刷新）时的序号
+    };
+
+    // a 支配 b：各目标都不差且至少一项更好
+    static bool dominates(const double* a, const double* b) {
+        bool strictly_better = false;
+        for (size_t i = 0; i < OBJECTIVES; ++i) {
+            if (a[i] > b[i]) {
+                return false;
+            }
+            strictly_better |= a[i] < b[i];
+        }
+        return strictly_better;
+    }
+
+    // 非支配点的下标（按输入顺序返回）；objectives(i) 返回第 i 个点的目标数组。
+    // 完全相同的点互不支配，全部保留
+    template <typename Objectives>
+    static std::vector<size_t> nonDominated(size_t count, Objectives objectives) {
+        std::vector<size_t> order(count);
+        std::iota(order.begin(), order.end(), size_t(0));
+        std::sort(order.begin(), order.end(), [&objectives](size_t a, size_t b) {
+            const double* x = objectives(a);
+            const double* y = objectives(b);
+            return std::lexicographical_compare(x, x + OBJECTIVES, y, y + OBJECTIVES);
+        });
+
+        // 阶梯：第二目标 -> (第三目标, 第一目标)，第三目标随第二目标递增而严格递减。
+        // 排在前面的点第一目标都不大于当前点，只需查后两维
+        std::map<double, std::pair<double, double>> staircase;
+        std::vector<size_t> result;
+        result.reserve(count);
+        for (size_t index : order) {
+            const double* p = objectives(index);
+            auto it = staircase.upper_bound(p[1]);
+            if (it != staircase.begin()) {
+                --it;   // 第二目标 <= p[1] 中第三目标最小的一项
+                double q2 = it->second.first;
+                double q0 = it->second.second;
+                bool identical = it->first == p[1] && q2 == p[2] && q0 == p[0];
+                if (q2 <= p[2] && !identical) {
+                    continue;
+                }
+            }
+            result.push_back(index);
+
+            // 插入阶梯并剔除被新点覆盖的项
+            auto found = staircase.find(p[1]);
+            if (found != staircase.end() && found->second.first <= p[2]) {
+                continue;   // 相同的点已在阶梯中
+            }
+            auto next = staircase.lower_bound(p[1]);
+            while (next != staircase.end() && next->second.first >= p[2]) {
+                next = staircase.erase(next);
+            }
+            staircase[p[1]] = std::make_pair(p[2], p[0]);
+        }
+
+        std::sort(result.begin(), result.end());
+        return result;
+    }
+
+    // 增量插入：被已有点支配则拒绝；与已有点完全相同时只刷新载荷与序号；
+    // 否则剔除被它支配的点后加入，超过容量时淘汰序号最小的点。返回是否进入前沿
+    bool insert(const double* objectives, Payload payload, uint64_t stamp = 0) {
+        for (auto& entry : entries_) {
+            if (dominates(entry.objectives, objectives)) {
+                return false;
+            }
+            if (std::equal(objectives, objectives + OBJECTIVES, entry.objectives)) {
+                entry.payload = std::move(payload);
+                entry.stamp = std::max(entry.stamp, stamp);
+                return true;
+            }
+        }
+        entries_.erase(std::remove_if(entries_.begin(), entries_.end(),
+                                      [objectives](const Entry& entry) {
+                                          return dominates(objectives, entry.objectives);
+                                      }),
+                       entries_.end());
+
+        Entry entry;
+        std::copy(objectives, objectives + OBJECTIVES, entry.objectives);
+        entry.payload = std::move(payload);
+        entry.stamp = stamp;
+        entries_.push_back(std::move(entry));
+        trimToCapacity();
+        return true;
+    }
+
+    // 淘汰序号小于 min_stamp 的点，返回淘汰数量
+    size_t evictOlderThan(uint64_t min_stamp) {
+        size_t before = entries_.size();
+        entries_.erase(std::remove_if(entries_.begin(), entries_.end(),
+                                      [min_stamp](const Entry& entry) { return entry.stamp < min_stamp; }),
+                       entries_.end());
+        return before - entries_.size();
+    }
+
+    // 容量上限（0 表示不限），插入与批量合并后超出时淘汰序号最小的点
+    void setCapacity(size_t capacity) { capacity_ = capacity; }
+
+    // 批量合并：候选数超过当前前沿大小时合并后整体扫描，否则逐个增量插入
+    void insertBatch(std::vector<Entry>&& candidates) {
+        if (candidates.size() <= entries_.size()) {
+            for (auto& candidate : candidates) {
+                insert(candidate.objectives, std::move(candidate.payload), candidate.stamp);
+            }
+            return;
+        }
+
+        std::vector<Entry> merged = std::move(entries_);
+        merged.reserve(merged.size() + candidates.size());
+        for (auto& candidate : candidates) {
+            merged.push_back(std::move(candidate));
+        }
+        auto keep = nonDominated(merged.size(), [&merged](size_t i) { return merged[i].objectives; });
+
+        entries_.clear();
+        entries_.reserve(keep.size());
+        for (size_t index : keep) {
+            entries_.push_back(std::move(merged[index]));
+        }
+        trimToCapacity();
+    }
+
+    // 按权重取加权和最小的点；权重在调用方一次算好
+    const Entry* selectWeighted(const double* weights) const {
+        const Entry* best = nullptr;
+        double best_score = std::numeric_limits<double>::max();
+        for (const auto& entry : entries_) {
+            double score = 0.0;
+            for (size_t i = 0; i < OBJECTIVES; ++i) {
+                score += weights[i] * entry.objectives[i];
+            }
+            if (score < best_score) {
+                best_score = score;
+                best = &entry;
+            }
+        }
+        return best;
+    }
+
+    const std::vector<Entry>& entries() const { return entries_; }
+    size_t size() const { return entries_.size(); }
+    bool empty() const { return entries_.empty(); }
+    void clear() { entries_.clear(); }
+
+private:
+    // 逐个淘汰序号最小的点，其余点保持原有顺序
+    void trimToCapacity() {
+        while (capacity_ > 0 && entries_.size() > capacity_) {
+            auto oldest = std::min_element(entries_.begin(), entries_.end(),
+                                           [](const Entry& a, const Entry& b) { return a.stamp < b.stamp; });
+            entries_.erase(oldest);
+        }
+    }
+
+    std::vector<Entry> entries_;
+    size_t capacity_ = 0;
+};
+
+#endif // UIEE_PARETO_H
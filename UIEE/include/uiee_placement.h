@@ -0,0 +1,150 @@
+#ifndef UIEE_PLACEMENT_H
+#define UIEE_PLACEMENT_H
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include "uiee_procfs.h"
+#include "uiee_sampler.h"
+#include "uiee_topology.h"
+
+// 任务放置策略
+// 按档位（性能/交互/后台）把任务放到对应的簇上：
+//   1. Android cpuset/cpuctl 分组可用时，把整个进程写入对应分组的 cgroup.procs（一次写入覆盖全部线程，
+//      组内的 uclamp 由系统按分组下发）；
+//   2. 分组的CPU范围与目标掩码不一致或分组不可用时，对 /proc/<pid>/task 下每个线程调用 sched_setaffinity；
+//   3. 没有 cpuctl 分组时按线程 sched_setattr 设置 uclamp（内核 5.3+，不支持时自动关闭）。
+// 绑定核心数受 max_bound_cores 限制，在目标簇内选择负载最低的核心。
+// I/O 优先级按线程 ioprio_set 下发，与放置档位相互独立。
+// 非线程安全，调用方持有任务表锁。
+class UIEEPlacementEngine {
+public:
+    static constexpr int MAX_CPU_CORES = UIEECpuTopology::MAX_CPU_CORES;
+    static constexpr uint16_t UCLAMP_MAX_VALUE = 1024;
+
+    enum Tier : uint8_t {
+        TIER_DEFAULT,       // 不干预（恢复系统默认）
+        TIER_BACKGROUND,    // 后台让出：小核，限制 uclamp 上限
+        TIER_INTERACTIVE,   // 前台普通应用：大核
+        TIER_PERFORMANCE,   // 前台游戏/高优先级：超大核+大核，抬高 uclamp 下限
+        TIER_COUNT
+    };
+
+    enum CgroupGroup : uint8_t {
+        GROUP_ROOT,
+        GROUP_TOP_APP,
+        GROUP_FOREGROUND,
+        GROUP_BACKGROUND,
+        GROUP_SYSTEM_BACKGROUND,
+        GROUP_COUNT,
+        GROUP_UNKNOWN = 0xff
+    };
+
+    // I/O 优先级档位（新线程继承创建者的设置）
+    enum IoClass : uint8_t {
+        IO_DEFAULT,         // 不干预：IOPRIO_CLASS_NONE，由内核按 nice 推导
+        IO_FOREGROUND,      // best-effort 最高级
+        IO_BACKGROUND,      // best-effort 最低级
+        IO_IDLE,            // 空闲类：设备空闲时才得到服务
+        IO_CLASS_COUNT
+    };
+
+    struct Placement {
+        Tier tier;
+        uint32_t cpu_mask;      // 0 表示不限制
+        CgroupGroup group;      // GROUP_UNKNOWN 表示不移动分组
+        uint16_t uclamp_min;
+        uint16_t uclamp_max;
+    };
+
+    struct Stats {
+        int syscalls = 0;
+        int threads = 0;
+        int cgroup_moves = 0;
+        int permission_denied = 0;
+        int other_failures = 0;
+        int other_errno = 0;
+    };
+
+    explicit UIEEPlacementEngine(const UIEECpuTopology& topology);
+
+    UIEEPlacementEngine(const UIEEPlacementEngine&) = delete;
+    UIEEPlacementEngine& operator=(const UIEEPlacementEngine&) = delete;
+
+    // 探测 cpuset/cpuctl 分组，返回是否至少有一个 cpuset 分组可写；拓扑变化后需重新调用
+    bool discover(const std::string& cpuset_root = "/dev/cpuset", const std::string& cpuctl_root = "/dev/cpuctl");
+    bool hasCpusetGroups() const { return cpuset_groups_ != 0; }
+    bool hasCpuctlGroups() const { return cpuctl_groups_ != 0; }
+
+    // 每个任务最多绑定的核心数，<=0 表示不限制
+    void setMaxBoundCores(int max_cores) { max_bound_cores_ = max_cores; }
+    int maxBoundCores() const { return max_bound_cores_; }
+
+    // 预测即将过热时避开超大核：性能档改为只用大核，切换后下一轮 decide() 即迁移
+    void setPrimeAvoidance(bool avoid) { avoid_prime_ = avoid; }
+    bool primeAvoidance() const { return avoid_prime_; }
+
+    // 计算档位对应的放置；current_mask 为当前已下发的掩码，仍合适时保持不动以避免来回迁移
+    Placement decide(Tier tier, const UIEESystemSampler::CpuSample& sample, uint32_t current_mask) const;
+
+    // 下发放置，进程已退出时返回 false 且 errno 为 ESRCH
+    bool apply(int pid, const Placement& placement, Stats& stats);
+    // 撤销引擎对该进程做过的修改（分组移回原处，掩码与 uclamp 复位）
+    bool restore(int pid, Stats& stats);
+    // 进程退出后丢弃记录
+    void forget(int pid) { applied_.erase(pid); }
+    size_t trackedCount() const { return applied_.size(); }
+
+    static const char* tierName(Tier tier);
+
+    // 单线程操作（线程级调度复用），失败计入 stats，线程已退出不计为失败
+    bool setThreadAffinity(int tid, uint32_t mask, Stats& stats);   // mask 为 0 时放开全部核心
+    bool setThreadUclamp(int tid, uint16_t min_value, uint16_t max_value, Stats& stats);
+    bool setThreadNice(int tid, int nice_value, Stats& stats);
+    bool setThreadIoClass(int tid, IoClass io_class, Stats& stats);
+    bool uclampSupported() const { return uclamp_supported_; }
+    bool ioprioSupported() const { return ioprio_supported_; }
+
+    // 对进程的全部线程下发 I/O 优先级，进程已退出时返回 false 且 errno 为 ESRCH
+    bool setIoClass(int pid, IoClass io_class, Stats& stats);
+    static const char* ioClassName(IoClass io_class);
+
+private:
+    struct Group {
+        UIEEProcFile cpus_file;   // cpuset.cpus
+        uint32_t cpu_mask;
+        int procs_fd;             // cgroup.procs（写）
+    };
+
+    struct Applied {
+        uint8_t original_cpuset;
+        uint8_t original_cpuctl;
+        bool affinity;
+        bool uclamp;
+    };
+
+    const UIEECpuTopology& topology_;
+    int max_bound_cores_;
+    bool avoid_prime_;
+    Group cpuset_[GROUP_COUNT];
+    int cpuctl_fd_[GROUP_COUNT];
+    uint32_t cpuset_groups_;      // 位图：可写的 cpuset 分组
+    uint32_t cpuctl_groups_;
+    bool uclamp_supported_;
+    bool ioprio_supported_;
+    std::unordered_map<int, Applied> applied_;
+
+    static const char* groupName(CgroupGroup group);
+    static CgroupGroup parseGroupName(const char* path, size_t length);
+
+    void closeGroups();
+    uint32_t boundMask(uint32_t mask, const UIEESystemSampler::CpuSample& sample, uint32_t current_mask) const;
+    uint32_t groupCpus(CgroupGroup group);
+    CgroupGroup currentGroup(int pid, bool cpuctl) const;
+    bool moveToGroup(int fd, int pid, Stats& stats);
+    // 对进程的每个线程执行 fn(tid)，返回线程数；进程不存在返回 -1
+    template <typename Fn> int forEachThread(int pid, Fn fn) const;
+    static void recordFailure(Stats& stats, int err);
+};
+
+#endif // UIEE_PLACEMENT_H
@@ -0,0 +1,92 @@
+#ifndef UIEE_PRESSURE_H
+#define UIEE_PRESSURE_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include "uiee_procfs.h"
+
+// 资源压力监测（PSI，/proc/pressure/{cpu,memory,io}，内核 4.20+ 且开启 CONFIG_PSI）
+// 每个文件一个常驻fd，sample() 读取 some/full 的 avg10（最近10秒内任务因该资源停顿的时间占比）；
+// start() 另对 memory/io 各登记一个 PSI 触发器（"some <停顿微秒> <窗口微秒>"），
+// 窗口内停顿超过阈值时内核以 POLLPRI 唤醒监测线程，回调通知调用方，不必轮询就能看到回收与 I/O 卡顿。
+class UIEEPressureMonitor {
+public:
+    enum Resource {
+        RESOURCE_CPU,
+        RESOURCE_MEMORY,
+        RESOURCE_IO,
+        RESOURCE_COUNT
+    };
+
+    struct Pressure {
+        bool valid;
+        double some_avg10;     // 至少一个任务停顿的时间占比（%）
+        double full_avg10;     // 全部非空闲任务同时停顿的时间占比（%），CPU 在旧内核上没有该行
+    };
+
+    struct Sample {
+        bool valid;
+        Pressure resource[RESOURCE_COUNT];
+    };
+
+    using Callback = std::function<void(Resource resource)>;
+
+    // 触发阈值：1 秒窗口内停顿超过阈值即唤醒（窗口内至多一次）；无特权时按 2 秒窗口登记
+    static constexpr int TRIGGER_WINDOW_US = 1000000;
+    static constexpr int MEMORY_TRIGGER_STALL_US = 100000;
+    static constexpr int IO_TRIGGER_STALL_US = 150000;
+
+    UIEEPressureMonitor();
+    ~UIEEPressureMonitor();
+
+    UIEEPressureMonitor(const UIEEPressureMonitor&) = delete;
+    UIEEPressureMonitor& operator=(const UIEEPressureMonitor&) = delete;
+
+    // 打开 PSI 文件，内核未开启 PSI 时返回 false
+    bool open(const std::string& pressure_root = "/proc/pressure");
+    bool available() const { return available_; }
+
+    // 读取各资源的压力，任意线程可调用；结果同时保存为 latest()
+    Sample sample();
+    Sample latest() const;
+
+    // 登记触发器并启动监测线程；一个触发器都登记不上（无权限或内核不支持）时返回 false
+    bool start(Callback callback);
+    void stop();
+    bool isRunning() const { return running_; }
+
+    size_t getEventCount() const { return event_count_; }
+    // 最近 window 内是否收到过触发（没有触发器时总是 false）
+    bool triggeredWithin(std::chrono::milliseconds window) const;
+
+    static const char* resourceName(Resource resource);
+
+private:
+    static constexpr int POLL_INTERVAL_MS = 500;     // 也是停止标志的检查周期
+
+    std::string root_;
+    bool available_;
+    UIEEProcFile files_[RESOURCE_COUNT];
+    char buffer_[256];
+    mutable std::mutex sample_mutex_;
+    Sample latest_;
+
+    int trigger_fd_[RESOURCE_COUNT];
+    std::atomic<bool> running_;
+    std::thread thread_;
+    Callback callback_;
+    std::atomic<size_t> event_count_;
+    std::atomic<int64_t> last_event_ms_;
+
+    bool registerTrigger(Resource resource, int stall_us);
+    void closeTriggers();
+    void watchLoop();
+    static bool parse(const char* data, size_t length, Pressure& pressure);
+};
+
+#endif // UIEE_PRESSURE_H
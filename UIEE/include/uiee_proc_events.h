@@ -0,0 +1,77 @@
+#ifndef UIEE_PROC_EVENTS_H
+#define UIEE_PROC_EVENTS_H
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <thread>
+#include <vector>
+
+// 进程事件监听（netlink proc connector）
+// 订阅内核的 PROC_EVENT_FORK/EXEC/COMM/EXIT，只上报进程级事件（pid == tgid），
+// 一次 recv 收到的事件合并成一批回调，调用方可以每批只加一次锁
+class UIEEProcEventListener {
+public:
+    enum EventType {
+        EVENT_FORK,       // 新进程（子进程 comm 继承自父进程）
+        EVENT_EXEC,       // 进程执行了新程序
+        EVENT_COMM,       // 进程改名（Android 应用由 zygote fork 后改名，不会触发 exec）
+        EVENT_EXIT,       // 进程退出
+        EVENT_OVERFLOW    // 接收缓冲区溢出，事件已丢失，调用方需要全量同步
+    };
+
+    struct Event {
+        EventType type;
+        int pid;
+        int parent_pid;   // 仅 EVENT_FORK 有效
+    };
+
+    using Callback = std::function<void(const Event* events, size_t count)>;
+
+    UIEEProcEventListener();
+    ~UIEEProcEventListener();
+
+    UIEEProcEventListener(const UIEEProcEventListener&) = delete;
+    UIEEProcEventListener& operator=(const UIEEProcEventListener&) = delete;
+
+    // 建立订阅并启动接收线程；内核不支持或权限不足时返回 false
+    bool start(Callback callback);
+    void stop();
+    bool isRunning() const { return running_; }
+
+    size_t getEventCount() const { return event_count_; }
+    size_t getOverflowCount() const { return overflow_count_; }
+
+private:
+    static constexpr size_t MAX_BATCH_EVENTS = 64;
+
+    int socket_fd_;
+    std::atomic<bool> running_;
+    std::thread thread_;
+    Callback callback_;
+    std::atomic<size_t> event_count_;
+    std::atomic<size_t> overflow_count_;
+
+    bool subscribe(bool enable);
+    void receiveLoop();
+};
+
+// /proc 差量扫描（netlink 不可用时的回退路径，也用于定期校正）
+// 复用内部缓冲区，返回排好序的当前PID列表，便于与任务表做有序集合差
+class UIEEPidRescanner {
+public:
+    UIEEPidRescanner() = default;
+
+    // 重新读取 /proc 下的数字目录，返回排好序的PID列表
+    const std::vector<int>& rescan();
+    const std::vector<int>& current() const { return pids_; }
+
+    // 有序集合差：before 中有而 after 中没有的写入 removed，反之写入 added
+    static void diff(const std::vector<int>& before, const std::vector<int>& after,
+                     std::vector<int>& added, std::vector<int>& removed);
+
+private:
+    std::vector<int> pids_;
+};
+
+#endif // UIEE_PROC_EVENTS_H
@@ -0,0 +1,186 @@
+#ifndef UIEE_PROCFS_H
+#define UIEE_PROCFS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+
+// /proc 与 /sys 文件的持久句柄
+// 打开一次后通过 pread(fd, buf, n, 0) 重复读取，procfs/sysfs 在偏移0处会重新生成内容，
+// 这样每次采样只需要一次系统调用，不再有 open/close 与 ifstream 的堆分配
+class UIEEProcFile {
+public:
+    UIEEProcFile() : fd_(-1) {}
+    explicit UIEEProcFile(const std::string& path) : path_(path), fd_(-1) {}
+    ~UIEEProcFile() { close(); }
+
+    UIEEProcFile(const UIEEProcFile&) = delete;
+    UIEEProcFile& operator=(const UIEEProcFile&) = delete;
+
+    UIEEProcFile(UIEEProcFile&& other) noexcept : path_(std::move(other.path_)), fd_(other.fd_) {
+        other.fd_ = -1;
+    }
+
+    UIEEProcFile& operator=(UIEEProcFile&& other) noexcept {
+        if (this != &other) {
+            close();
+            path_ = std::move(other.path_);
+            fd_ = other.fd_;
+            other.fd_ = -1;
+        }
+        return *this;
+    }
+
+    // 打开文件（已打开时直接返回成功）
+    bool open() {
+        if (fd_ >= 0) {
+            return true;
+        }
+        if (path_.empty()) {
+            return false;
+        }
+        fd_ = ::open(path_.c_str(), O_RDONLY | O_CLOEXEC);
+        return fd_ >= 0;
+    }
+
+    bool open(const std::string& path) {
+        close();
+        path_ = path;
+        return open();
+    }
+
+    void close() {
+        if (fd_ >= 0) {
+            ::close(fd_);
+            fd_ = -1;
+        }
+    }
+
+    bool isOpen() const { return fd_ >= 0; }
+    const std::string& path() const { return path_; }
+
+    // 从偏移0读取最多 size-1 字节并以'\0'结尾，返回读取字节数，失败返回-1
+    // 读取失败时（例如节点被热插拔重建）会重新打开一次再试
+    ssize_t read(char* buffer, size_t size) {
+        if (size == 0 || !open()) {
+            return -1;
+        }
+        ssize_t n = readOnce(buffer, size);
+        if (n < 0 && errno != EINTR) {
+            close();
+            if (!open()) {
+                return -1;
+            }
+            n = readOnce(buffer, size);
+        }
+        buffer[n > 0 ? n : 0] = '\0';
+        return n;
+    }
+
+private:
+    std::string path_;
+    int fd_;
+
+    ssize_t readOnce(char* buffer, size_t size) {
+        ssize_t n;
+        do {
+            n = ::pread(fd_, buffer, size - 1, 0);
+        } while (n < 0 && errno == EINTR);
+        return n;
+    }
+};
+
+// 零分配文本扫描器
+// 直接在读取缓冲区上前进，用于解析 /proc/stat、/proc/meminfo 等固定格式文件
+class UIEEScanner {
+public:
+    UIEEScanner(const char* data, size_t length) : pos_(data), end_(data + length) {}
+
+    bool atEnd() const { return pos_ >= end_; }
+    const char* position() const { return pos_; }
+
+    // 跳过空格和制表符（不跨行）
+    void skipSpaces() {
+        while (pos_ < end_ && (*pos_ == ' ' || *pos_ == '\t')) {
+            ++pos_;
+        }
+    }
+
+    // 跳到下一行行首
+    void skipLine() {
+        while (pos_ < end_ && *pos_ != '\n') {
+            ++pos_;
+        }
+        if (pos_ < end_) {
+            ++pos_;
+        }
+    }
+
+    // 当前位置是否以指定前缀开头
+    bool startsWith(const char* prefix) const {
+        size_t len = std::strlen(prefix);
+        return static_cast<size_t>(end_ - pos_) >= len && std::memcmp(pos_, prefix, len) == 0;
+    }
+
+    // 若当前位置以前缀开头则越过它
+    bool consume(const char* prefix) {
+        size_t len = std::strlen(prefix);
+        if (static_cast<size_t>(end_ - pos_) >= len && std::memcmp(pos_, prefix, len) == 0) {
+            pos_ += len;
+            return true;
+        }
+        return false;
+    }
+
+    // 逐行查找以 key 开头的行，找到后定位到 key 之后
+    bool findLine(const char* key) {
+        while (pos_ < end_) {
+            if (consume(key)) {
+                return true;
+            }
+            skipLine();
+        }
+        return false;
+    }
+
+    // 读取无符号十进制整数（先跳过空白）
+    bool readU64(uint64_t& value) {
+        skipSpaces();
+        if (pos_ >= end_ || *pos_ < '0' || *pos_ > '9') {
+            return false;
+        }
+        uint64_t v = 0;
+        while (pos_ < end_ && *pos_ >= '0' && *pos_ <= '9') {
+            v = v * 10 + static_cast<uint64_t>(*pos_ - '0');
+            ++pos_;
+        }
+        value = v;
+        return true;
+    }
+
+    // 读取有符号十进制整数
+    bool readI64(int64_t& value) {
+        skipSpaces();
+        bool negative = false;
+        if (pos_ < end_ && (*pos_ == '-' || *pos_ == '+')) {
+            negative = (*pos_ == '-');
+            ++pos_;
+        }
+        uint64_t magnitude = 0;
+        if (!readU64(magnitude)) {
+            return false;
+        }
+        value = negative ? -static_cast<int64_t>(magnitude) : static_cast<int64_t>(magnitude);
+        return true;
+    }
+
+private:
+    const char* pos_;
+    const char* end_;
+};
+
+#endif // UIEE_PROCFS_H
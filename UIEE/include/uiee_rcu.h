@@ -0,0 +1,106 @@
+#ifndef UIEE_RCU_H
+#define UIEE_RCU_H
+
+#include <atomic>
+#include <thread>
+#include <utility>
+
+// 读多写少的对象发布（RCU 风格，两份副本 + 每份一个读者计数）
+// 读者：读当前下标、给该副本计数加一、再确认下标未变，随后直接读取副本，不加锁、不拷贝；
+// 下标在这期间被切换时撤销计数重试，写者不会阻塞读者。
+// 写者：等待非活动副本上残留的读者退出，写入该副本后切换下标。写者之间须由调用方串行化。
+// ReadGuard 只应在函数内短暂持有，持有期间不能去拿调用方用于串行化写者的锁。
+template <typename T>
+class UIEERcuCell {
+public:
+    class ReadGuard {
+    public:
+        ReadGuard(ReadGuard&& other) noexcept : cell_(other.cell_), index_(other.index_) { other.cell_ = nullptr; }
+        ReadGuard(const ReadGuard&) = delete;
+        ReadGuard& operator=(const ReadGuard&) = delete;
+        ReadGuard& operator=(ReadGuard&&) = delete;
+        ~ReadGuard() {
+            if (cell_ != nullptr) {
+                cell_->readers_[index_].fetch_sub(1, std::memory_order_release);
+            }
+        }
+
+        const T& operator*() const { return cell_->slots_[index_]; }
+        const T* operator->() const { return &cell_->slots_[index_]; }
+
+    private:
+        friend class UIEERcuCell;
+        ReadGuard(const UIEERcuCell* cell, int index) : cell_(cell), index_(index) {}
+
+        const UIEERcuCell* cell_;
+        int index_;
+    };
+
+    UIEERcuCell() : index_(0), version_(0) {
+        readers_[0].store(0, std::memory_order_relaxed);
+        readers_[1].store(0, std::memory_order_relaxed);
+    }
+
+    UIEERcuCell(const UIEERcuCell&) = delete;
+    UIEERcuCell& operator=(const UIEERcuCell&) = delete;
+
+    ReadGuard read() const {
+        for (;;) {
+            int index = index_.load(std::memory_order_seq_cst);
+            readers_[index].fetch_add(1, std::memory_order_seq_cst);
+            if (index_.load(std::memory_order_seq_cst) == index) {
+                return ReadGuard(this, index);
+            }
+            readers_[index].fetch_sub(1, std::memory_order_release);
+        }
+    }
+
+    T load() const { return *read(); }
+
+    // 以下仅写者调用
+    // 当前已发布的值；写者串行化后没有其他线程修改它，可以不经读者计数直接读取
+    const T& current() const { return slots_[index_.load(std::memory_order_relaxed)]; }
+
+    void publish(const T& value) {
+        T& slot = acquireInactive();
+        slot = value;
+        flip();
+    }
+
+    // 在当前值的副本上修改后发布
+    template <typename Mutator>
+    void update(Mutator&& mutate) {
+        int active = index_.load(std::memory_order_relaxed);
+        T& slot = acquireInactive();
+        slot = slots_[active];
+        std::forward<Mutator>(mutate)(slot);
+        flip();
+    }
+
+    // 已发布的次数
+    unsigned long version() const { return version_.load(std::memory_order_acquire); }
+
+private:
+    T& acquireInactive() {
+        int inactive = 1 - index_.load(std::memory_order_relaxed);
+        // 切换前进入该副本的读者仍在读取，等它们退出；之后再进入的读者会发现下标不符而重试
+        for (unsigned spin = 0; readers_[inactive].load(std::memory_order_seq_cst) != 0; ++spin) {
+            if (spin >= 64) {
+                std::this_thread::yield();
+            }
+        }
+        return slots_[inactive];
+    }
+
+    void flip() {
+        index_.store(1 - index_.load(std::memory_order_relaxed), std::memory_order_seq_cst);
+        version_.fetch_add(1, std::memory_order_release);
+    }
+
+    T slots_[2];
+    mutable std::atomic<int> readers_[2];
+    std::atomic<int> index_;
+    std::atomic<unsigned long> version_;
+};
+
+#endif // UIEE_RCU_H
@@ -0,0 +1,282 @@
+#ifndef UIEE_RING_BUFFER_H
+#define UIEE_RING_BUFFER_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+// 定长环形缓冲区
+// 写满后覆盖最旧元素，push 为 O(1)；下标 0 是最旧元素，size()-1 是最新元素。
+// 元素可平凡拷贝时可以挂到 mmap 文件上，引擎重启后直接恢复，不需要文本解析。
+// 不做内部加锁，由持有者负责同步。
+template <typename T>
+class UIEERingBuffer {
+public:
+    // 窗口统计结果
+    struct WindowStats {
+        size_t count = 0;
+        double min = 0.0;
+        double max = 0.0;
+        double mean = 0.0;
+    };
+
+    class const_iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+        const_iterator(const UIEERingBuffer* ring, size_t index) : ring_(ring), index_(index) {}
+        reference operator*() const { return (*ring_)[index_]; }
+        pointer operator->() const { return &(*ring_)[index_]; }
+        const_iterator& operator++() { ++index_; return *this; }
+        const_iterator operator++(int) { const_iterator old = *this; ++index_; return old; }
+        bool operator==(const const_iterator& other) const { return index_ == other.index_; }
+        bool operator!=(const const_iterator& other) const { return index_ != other.index_; }
+
+    private:
+        const UIEERingBuffer* ring_;
+        size_t index_;
+    };
+
+    explicit UIEERingBuffer(size_t capacity)
+        : capacity_(std::max<size_t>(capacity, 1)), heap_(capacity_), data_(heap_.data()),
+          header_(&local_header_), mapping_(nullptr), mapping_size_(0) {
+        initHeader(local_header_);
+    }
+
+    ~UIEERingBuffer() { detachFile(); }
+
+    UIEERingBuffer(const UIEERingBuffer&) = delete;
+    UIEERingBuffer& operator=(const UIEERingBuffer&) = delete;
+
+    // 挂载到持久化文件：文件头匹配（魔数/版本/元素大小/容量）时恢复已有数据，否则重新初始化。
+    // 失败时保持当前的内存存储，返回 false
+    bool attachFile(const std::string& path) {
+        static_assert(std::is_trivially_copyable<T>::value,
+                      "只有可平凡拷贝的元素才能映射到文件");
+        static_assert(alignof(T) <= DATA_OFFSET, "元素对齐超出数据区偏移");
+
+        detachFile();
+
+        int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+        if (fd < 0) {
+            return false;
+        }
+
+        size_t size = DATA_OFFSET + capacity_ * sizeof(T);
+        struct stat st;
+        bool fresh = fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) != size;
+        if (fresh && ftruncate(fd, static_cast<off_t>(size)) != 0) {
+            ::close(fd);
+            return false;
+        }
+
+        void* mapping = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        ::close(fd);  // 映射建立后不再需要 fd
+        if (mapping == MAP_FAILED) {
+            return false;
+        }
+
+        Header* header = static_cast<Header*>(mapping);
+        T* data = reinterpret_cast<T*>(static_cast<char*>(mapping) + DATA_OFFSET);
+        if (fresh || !headerMatches(*header)) {
+            initHeader(*header);
+            // 优先保留内存中已有的数据
+            for (size_t i = 0; i < local_header_.count; ++i) {
+                data[i] = (*this)[i];
+            }
+            header->count = local_header_.count;
+            header->head = local_header_.count % capacity_;
+        }
+
+        mapping_ = mapping;
+        mapping_size_ = size;
+        header_ = header;
+        data_ = data;
+        return true;
+    }
+
+    // 解除映射，数据拷回内存继续使用
+    void detachFile() {
+        if (!mapping_) {
+            return;
+        }
+        size_t count = header_->count;
+        for (size_t i = 0; i < count; ++i) {
+            heap_[i] = (*this)[i];
+        }
+        local_header_.count = count;
+        local_header_.head = count % capacity_;
+
+        munmap(mapping_, mapping_size_);
+        mapping_ = nullptr;
+        mapping_size_ = 0;
+        header_ = &local_header_;
+        data_ = heap_.data();
+    }
+
+    bool isPersistent() const { return mapping_ != nullptr; }
+
+    // 异步回写，不阻塞调用方
+    void sync() {
+        if (mapping_) {
+            msync(mapping_, mapping_size_, MS_ASYNC);
+        }
+    }
+
+    void push(const T& value) {
+        data_[header_->head] = value;
+        advance();
+    }
+
+    void push(T&& value) {
+        data_[header_->head] = std::move(value);
+        advance();
+    }
+
+    void clear() {
+        header_->head = 0;
+        header_->count = 0;
+    }
+
+    size_t size() const { return static_cast<size_t>(header_->count); }
+    size_t capacity() const { return capacity_; }
+    bool empty() const { return header_->count == 0; }
+    bool full() const { return header_->count == capacity_; }
+
+    const T& operator[](size_t index) const { return data_[physicalIndex(index)]; }
+    T& operator[](size_t index) { return data_[physicalIndex(index)]; }
+    const T& front() const { return (*this)[0]; }
+    const T& back() const { return (*this)[size() - 1]; }
+    T& back() { return (*this)[size() - 1]; }
+
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, size()); }
+
+    // 最近 window 个元素上的 min/max/mean，window 为 0 或超过当前数量时取全部
+    template <typename Projection>
+    WindowStats windowStats(size_t window, Projection projection) const {
+        WindowStats stats;
+        size_t count = clampWindow(window);
+        if (count == 0) {
+            return stats;
+        }
+
+        double min = std::numeric_limits<double>::max();
+        double max = std::numeric_limits<double>::lowest();
+        double sum = 0.0;
+        forEachRecent(count, [&](const T& item) {
+            double value = projection(item);
+            min = std::min(min, value);
+            max = std::max(max, value);
+            sum += value;
+        });
+
+        stats.count = count;
+        stats.min = min;
+        stats.max = max;
+        stats.mean = sum / static_cast<double>(count);
+        return stats;
+    }
+
+    // 最近 window 个元素按时间顺序计算的指数移动平均，alpha 为新样本权重
+    template <typename Projection>
+    double ema(size_t window, double alpha, Projection projection) const {
+        size_t count = clampWindow(window);
+        if (count == 0) {
+            return 0.0;
+        }
+
+        bool first = true;
+        double value = 0.0;
+        forEachRecent(count, [&](const T& item) {
+            double sample = projection(item);
+            value = first ? sample : alpha * sample + (1.0 - alpha) * value;
+            first = false;
+        });
+        return value;
+    }
+
+    // 按从旧到新的顺序访问最近 count 个元素，环回处拆成两段连续内存
+    template <typename Function>
+    void forEachRecent(size_t count, Function function) const {
+        count = clampWindow(count);
+        size_t start = physicalIndex(size() - count);
+        size_t first_span = std::min(count, capacity_ - start);
+        for (size_t i = 0; i < first_span; ++i) {
+            function(data_[start + i]);
+        }
+        for (size_t i = 0; i < count - first_span; ++i) {
+            function(data_[i]);
+        }
+    }
+
+private:
+    static constexpr uint32_t MAGIC = 0x55524230;   // "URB0"
+    static constexpr uint32_t VERSION = 1;
+    static constexpr size_t DATA_OFFSET = 64;
+
+    struct Header {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t element_size;
+        uint32_t capacity;
+        uint64_t head;        // 下一个写入位置
+        uint64_t count;
+    };
+    static_assert(sizeof(Header) <= DATA_OFFSET, "文件头超出数据区偏移");
+
+    size_t capacity_;
+    std::vector<T> heap_;
+    T* data_;
+    Header local_header_;
+    Header* header_;
+    void* mapping_;
+    size_t mapping_size_;
+
+    void initHeader(Header& header) const {
+        header.magic = MAGIC;
+        header.version = VERSION;
+        header.element_size = static_cast<uint32_t>(sizeof(T));
+        header.capacity = static_cast<uint32_t>(capacity_);
+        header.head = 0;
+        header.count = 0;
+    }
+
+    bool headerMatches(const Header& header) const {
+        return header.magic == MAGIC && header.version == VERSION &&
+               header.element_size == sizeof(T) && header.capacity == capacity_ &&
+               header.head < capacity_ && header.count <= capacity_;
+    }
+
+    void advance() {
+        header_->head = (header_->head + 1) % capacity_;
+        if (header_->count < capacity_) {
+            header_->count++;
+        }
+    }
+
+    size_t physicalIndex(size_t index) const {
+        size_t oldest = (static_cast<size_t>(header_->head) + capacity_ - size()) % capacity_;
+        return (oldest + index) % capacity_;
+    }
+
+    size_t clampWindow(size_t window) const {
+        return (window == 0 || window > size()) ? size() : window;
+    }
+};
+
+#endif // UIEE_RING_BUFFER_H
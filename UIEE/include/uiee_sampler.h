@@ -0,0 +1,147 @@
+#ifndef UIEE_SAMPLER_H
+#define UIEE_SAMPLER_H
+
+#include "uiee_procfs.h"
+#include <cstdint>
+#include <mutex>
+#include <chrono>
+#include <string>
+
+// 系统指标采样器
+// 持有 /proc/stat、/proc/meminfo 与温度节点的常驻fd，每次采样只做 pread + 零分配解析，
+// CPU使用率按两次采样之间的jiffies增量计算（全局与每核心），而不是开机以来的累计值。
+// GPU（kgsl / /sys/kernel/gpu / devfreq）与电池（power_supply）节点在 open() 时探测一次，
+// 之后同样走常驻fd；结果缓存 CACHE_INTERVAL，同一周期内多处读取只触发一次 pread
+class UIEESystemSampler {
+public:
+    static constexpr int MAX_CPU_CORES = 16;
+
+    // 一个CPU（全局或单核）的累计时间
+    struct CpuTimes {
+        uint64_t busy;
+        uint64_t total;
+    };
+
+    // CPU增量采样结果
+    struct CpuSample {
+        double total_usage;                    // 全局利用率（0-100）
+        double core_usage[MAX_CPU_CORES];      // 每核心利用率（0-100）
+        bool core_online[MAX_CPU_CORES];       // 本次采样中是否出现该核心
+        int core_count;                        // 已见到的最大核心编号+1
+    };
+
+    // GPU 采样结果
+    struct GpuSample {
+        bool available;          // 找到了 GPU 频率或负载节点
+        bool busy_measured;      // 负载来自驱动；为 false 时按频率比近似（调频器随负载升频）
+        double busy;             // 利用率（0-100）
+        uint32_t freq_mhz;
+        uint32_t max_freq_mhz;
+    };
+
+    // 电池采样结果（current_now/voltage_now 的单位各厂商不一，归一为 mA/mV：
+    // 电流单位在打开节点时按容量节点的量级确定一次，电压按读数量级区分 µV/mV）
+    struct BatterySample {
+        bool available;          // 电量节点可读
+        bool discharging;
+        double level;            // 电量（0-100），不可读时为 100
+        double current_ma;       // 电流绝对值
+        double voltage_mv;
+        double power_mw;         // 放电功率，即整机实测功耗；充电或电流节点缺失时为 0
+    };
+
+    enum GpuSource {
+        GPU_NONE,
+        GPU_KGSL,                // Adreno：/sys/class/kgsl/kgsl-3d0
+        GPU_KERNEL_GPU,          // Mali 等厂商的 /sys/kernel/gpu
+        GPU_DEVFREQ              // 只有 devfreq 频率节点
+    };
+
+    static constexpr std::chrono::milliseconds CACHE_INTERVAL{250};
+
+    UIEESystemSampler();
+    ~UIEESystemSampler() = default;
+
+    UIEESystemSampler(const UIEESystemSampler&) = delete;
+    UIEESystemSampler& operator=(const UIEESystemSampler&) = delete;
+
+    // 打开全部常驻fd并探测 GPU/电池节点，返回是否至少 /proc/stat 可用
+    bool open();
+    void close();
+
+    // 探测 GPU 与电池节点（open() 以 /sys 调用），测试时可指向伪造的目录树
+    void discoverPowerNodes(const std::string& sysfs_root);
+    GpuSource gpuSource() const { return gpu_source_; }
+
+    // CPU：距上次调用以来的增量利用率
+    // 两次调用间隔过短（jiffies无变化）时返回上一次的结果
+    CpuSample sampleCPU();
+    double readCPUUsage() { return sampleCPU().total_usage; }
+
+    // 内存：(MemTotal - MemAvailable) / MemTotal
+    double readMemoryUsage();
+
+    // 温度：thermal_zone0 映射到 0-100 的热状态分数
+    double readThermalState();
+
+    // 最近一次CPU采样（不触发读取）
+    CpuSample lastCPUSample() const;
+
+    // GPU 与电池：距上次读取不足 CACHE_INTERVAL 时返回缓存
+    GpuSample sampleGPU();
+    BatterySample sampleBattery();
+
+    static const char* gpuSourceName(GpuSource source);
+
+private:
+    static constexpr size_t STAT_BUFFER_SIZE = 4096;
+    static constexpr size_t MEMINFO_BUFFER_SIZE = 1024;
+
+    UIEEProcFile stat_file_;
+    UIEEProcFile meminfo_file_;
+    UIEEProcFile thermal_file_;
+
+    // 三个文件各自独立加锁，避免内存采样等待CPU采样
+    mutable std::mutex cpu_mutex_;
+    std::mutex meminfo_mutex_;
+    std::mutex thermal_mutex_;
+
+    char stat_buffer_[STAT_BUFFER_SIZE];
+    char meminfo_buffer_[MEMINFO_BUFFER_SIZE];
+    char thermal_buffer_[64];
+
+    // GPU 节点：负载为百分比（"37 %"）或 kgsl gpubusy 的 "busy total" 两列
+    std::mutex gpu_mutex_;
+    GpuSource gpu_source_;
+    UIEEProcFile gpu_busy_file_;
+    UIEEProcFile gpu_freq_file_;
+    bool gpu_busy_pair_;                 // gpubusy 两列格式
+    uint32_t gpu_max_freq_mhz_;
+    char gpu_buffer_[64];
+    GpuSample last_gpu_;
+    std::chrono::steady_clock::time_point last_gpu_time_;
+
+    std::mutex battery_mutex_;
+    UIEEProcFile battery_capacity_file_;
+    UIEEProcFile battery_current_file_;
+    UIEEProcFile battery_voltage_file_;
+    UIEEProcFile battery_status_file_;
+    double battery_current_scale_;                 // current_now 读数到 mA 的系数（µA 为 0.001，mA 为 1）
+    BatterySample last_battery_;
+    std::chrono::steady_clock::time_point last_battery_time_;
+    char battery_buffer_[64];
+
+    bool has_previous_;
+    CpuTimes prev_total_;
+    CpuTimes prev_cores_[MAX_CPU_CORES];
+    CpuSample last_sample_;
+
+    static bool parseCpuLine(UIEEScanner& scanner, CpuTimes& times);
+    bool discoverGpu(const std::string& sysfs_root);
+    void discoverBattery(const std::string& sysfs_root);
+    static bool readI64(UIEEProcFile& file, char* buffer, size_t size, int64_t& value);
+    static uint32_t toMegahertz(uint64_t frequency);
+    static double deltaUsage(const CpuTimes& now, const CpuTimes& prev, double fallback);
+};
+
+#endif // UIEE_SAMPLER_H
@@ -0,0 +1,83 @@
+#ifndef UIEE_SCENE_DETECTOR_H
+#define UIEE_SCENE_DETECTOR_H
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include "uiee_procfs.h"
+
+// 前台应用检测
+// Android 把前台应用的进程写入 /dev/cpuset/top-app/cgroup.procs（旧版本为 tasks），
+// 对这两个文件做 inotify，写入时立即重新读取并解析出包名，前台变化时回调；
+// inotify 不可用时退化为定时轮询（cgroup.procs 持久句柄 + pread）。
+// 包名到场景的映射从配置加载后编译成排好序的数组，精确匹配二分查找，前缀规则（以 * 结尾）其次。
+class UIEESceneDetector {
+public:
+    static constexpr uint8_t SCENE_NONE = 0xff;     // 表中没有该包名
+    static constexpr uint8_t SCENE_IGNORE = 0xfe;   // 表中标记为 ignore，不作为前台应用
+
+    struct ForegroundApp {
+        int pid = -1;
+        std::string package;
+        uint8_t scene = SCENE_NONE;
+    };
+
+    using Callback = std::function<void(const ForegroundApp& app)>;
+    // 场景名 -> 场景编号，无法识别返回 -1
+    using SceneParser = std::function<int(const std::string& name)>;
+
+    UIEESceneDetector();
+    ~UIEESceneDetector();
+
+    UIEESceneDetector(const UIEESceneDetector&) = delete;
+    UIEESceneDetector& operator=(const UIEESceneDetector&) = delete;
+
+    // 加载 "包名=场景" 格式的表，返回加载的条目数，文件无法打开返回 -1；可在运行中重新加载
+    int loadPackageTable(const std::string& path, const SceneParser& parser);
+    // 按包名查表（进程名中 ':' 之后的子进程后缀会被忽略）
+    uint8_t classify(std::string_view package) const;
+
+    // 启动检测线程；top-app cgroup 不存在时返回 false
+    bool start(Callback callback);
+    void stop();
+    bool isRunning() const { return running_; }
+    bool isEventDriven() const { return inotify_fd_ >= 0; }
+
+    ForegroundApp current() const;
+    size_t getChangeCount() const { return change_count_; }
+
+private:
+    struct PackageEntry {
+        std::string package;
+        uint8_t scene;
+    };
+
+    static constexpr int POLL_INTERVAL_MS = 500;    // 无 inotify 时的轮询周期，也是停止标志的检查周期
+    static constexpr size_t MAX_TOP_APP_PIDS = 64;
+
+    mutable std::mutex table_mutex_;
+    std::vector<PackageEntry> exact_;      // 按包名排序
+    std::vector<PackageEntry> prefixes_;   // 按前缀长度降序，最长前缀优先
+
+    UIEEProcFile procs_file_;
+    int inotify_fd_;
+    std::atomic<bool> running_;
+    std::thread thread_;
+    Callback callback_;
+
+    mutable std::mutex current_mutex_;
+    ForegroundApp current_;
+    std::atomic<size_t> change_count_;
+
+    void detectLoop();
+    bool refresh();
+    bool readTopApp(ForegroundApp& app);
+    static bool readPackageName(int pid, std::string& package);
+};
+
+#endif // UIEE_SCENE_DETECTOR_H
@@ -0,0 +1,76 @@
+#ifndef UIEE_SEQLOCK_H
+#define UIEE_SEQLOCK_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <type_traits>
+
+// 单写者顺序锁：发布可平凡拷贝的快照
+// 写者把序号置为奇数、写入数据、再置为偶数；读者在序号为偶数且前后一致时接受读到的副本，
+// 否则重读。读者不加锁、不影响写者，读者数量再多写入成本也不变。
+// 数据按64位原子字存放（relaxed 读写），读写并发时不构成数据竞争。
+// 只允许一个写线程调用 store()。
+template <typename T>
+class UIEESeqlock {
+    static_assert(std::is_trivially_copyable<T>::value, "快照类型必须可平凡拷贝");
+
+public:
+    UIEESeqlock() : sequence_(0) {
+        for (auto& word : words_) {
+            word.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    UIEESeqlock(const UIEESeqlock&) = delete;
+    UIEESeqlock& operator=(const UIEESeqlock&) = delete;
+
+    void store(const T& value) {
+        uint64_t buffer[WORDS] = {};
+        memcpy(buffer, &value, sizeof(T));
+
+        uint64_t sequence = sequence_.load(std::memory_order_relaxed);
+        sequence_.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (size_t i = 0; i < WORDS; ++i) {
+            words_[i].store(buffer[i], std::memory_order_relaxed);
+        }
+        sequence_.store(sequence + 2, std::memory_order_release);
+    }
+
+    T load() const {
+        uint64_t buffer[WORDS];
+        for (unsigned attempt = 0;; ++attempt) {
+            uint64_t before = sequence_.load(std::memory_order_acquire);
+            if ((before & 1) == 0) {
+                for (size_t i = 0; i < WORDS; ++i) {
+                    buffer[i] = words_[i].load(std::memory_order_relaxed);
+                }
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (sequence_.load(std::memory_order_relaxed) == before) {
+                    break;
+                }
+            }
+            // 写者在临界区内被抢占时让出CPU，避免读者空转
+            if (attempt >= 64) {
+                std::this_thread::yield();
+            }
+        }
+        T value;
+        memcpy(&value, buffer, sizeof(T));
+        return value;
+    }
+
+    // 已发布的次数，0 表示尚未发布
+    uint64_t version() const { return sequence_.load(std::memory_order_acquire) / 2; }
+
+private:
+    static constexpr size_t WORDS = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+    std::atomic<uint64_t> sequence_;
+    std::atomic<uint64_t> words_[WORDS];
+};
+
+#endif // UIEE_SEQLOCK_H
@@ -0,0 +1,120 @@
+#ifndef UIEE_TASK_TABLE_H
+#define UIEE_TASK_TABLE_H
+
+#include <chrono>
+#include <climits>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// 字符串驻留池：相同的进程名只存一份，任务记录里只保存32位ID
+// 引用计数归零后槽位回收复用
+class UIEEStringPool {
+public:
+    static constexpr uint32_t INVALID_ID = 0xffffffffu;
+
+    uint32_t intern(std::string_view text);
+    void release(uint32_t id);
+    const std::string& get(uint32_t id) const;
+    size_t size() const { return index_.size(); }
+
+private:
+    std::deque<std::string> strings_;     // deque 扩容不移动元素，index_ 中的视图保持有效
+    std::vector<uint32_t> refs_;
+    std::vector<uint32_t> free_ids_;
+    std::unordered_map<std::string_view, uint32_t> index_;
+};
+
+// 任务表：PID 开放寻址索引 + 热字段稠密数组
+// 查找/插入/删除均为 O(1)，删除时把末尾记录移入空位，遍历始终是连续内存
+class UIEETaskTable {
+public:
+    enum TaskFlags : uint8_t {
+        FLAG_FOREGROUND = 1u << 0,
+        FLAG_UID_CHECKED = 1u << 1,   // 已按进程 UID 判断过是否为应用进程（exec/改名后需重新判断）
+        FLAG_APP_UID = 1u << 2        // Android 应用 UID（>= 10000）
+    };
+
+    static constexpr int8_t NICE_UNSET = INT8_MIN;   // 尚未下发过 nice 值
+
+    // 热字段（调度每个tick都会访问）
+    struct TaskRecord {
+        int32_t pid;
+        int32_t priority;
+        uint32_t name_id;      // UIEEStringPool ID
+        uint8_t app_type;      // UIEECoreEngine::SceneType
+        uint8_t flags;         // TaskFlags
+        int8_t applied_nice;   // 最近一次下发的 nice 值，NICE_UNSET 表示未下发
+        uint8_t game_yield;    // 博弈中倾向合作（让出CPU份额）时为 1
+        uint8_t placement_tier; // 最近一次下发的放置档位（UIEEPlacementEngine::Tier）
+        uint8_t io_class;      // 最近一次下发的 I/O 档位（UIEEPlacementEngine::IoClass），0 表示未干预
+        uint32_t applied_mask; // 最近一次下发的CPU掩码，0 表示未由引擎绑定
+        uint32_t uid;          // 应用进程的 UID（置 FLAG_APP_UID 后有效）
+        float cpu_affinity;
+
+        bool isForeground() const { return (flags & FLAG_FOREGROUND) != 0; }
+        void setForeground(bool foreground) {
+            flags = foreground ? (flags | FLAG_FOREGROUND) : (flags & ~FLAG_FOREGROUND);
+        }
+    };
+
+    UIEETaskTable();
+
+    // 返回稠密数组下标，不存在返回 -1
+    int indexOf(int pid) const;
+    bool contains(int pid) const { return indexOf(pid) >= 0; }
+
+    // 插入新任务；已存在时不修改并返回已有下标，inserted 置为 false
+    int insert(int pid, std::string_view name, uint8_t app_type, int priority,
+               bool foreground, float cpu_affinity,
+               std::chrono::steady_clock::time_point start_time, bool* inserted = nullptr);
+    bool erase(int pid);
+    void clear();
+
+    // 更新进程名（exec/改名）
+    void rename(size_t index, std::string_view name);
+    const std::string& name(size_t index) const { return names_.get(records_[index].name_id); }
+
+    size_t size() const { return records_.size(); }
+    bool empty() const { return records_.empty(); }
+
+    TaskRecord& record(size_t index) { return records_[index]; }
+    const TaskRecord& record(size_t index) const { return records_[index]; }
+    std::chrono::steady_clock::time_point startTime(size_t index) const { return start_times_[index]; }
+
+    TaskRecord* begin() { return records_.data(); }
+    TaskRecord* end() { return records_.data() + records_.size(); }
+    const TaskRecord* begin() const { return records_.data(); }
+    const TaskRecord* end() const { return records_.data() + records_.size(); }
+
+    // 成员变化（增删）计数，用于 O(1) 判断任务集合是否改变
+    uint64_t version() const { return version_; }
+
+    // 把全部PID追加到 out（未排序）
+    void collectPids(std::vector<int>& out) const;
+
+private:
+    static constexpr int32_t EMPTY_SLOT = -1;
+
+    struct Slot {
+        int32_t pid;
+        int32_t index;
+    };
+
+    std::vector<Slot> slots_;              // 容量为2的幂，线性探测
+    size_t slot_mask_;
+    std::vector<TaskRecord> records_;
+    std::vector<std::chrono::steady_clock::time_point> start_times_;  // 冷字段
+    UIEEStringPool names_;
+    uint64_t version_;
+
+    size_t slotFor(int pid) const;
+    size_t findSlot(int pid) const;
+    void rehash(size_t capacity);
+    void eraseSlot(size_t slot);
+};
+
+#endif // UIEE_TASK_TABLE_H
@@ -0,0 +1,97 @@
+#ifndef UIEE_THERMAL_H
+#define UIEE_THERMAL_H
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "uiee_procfs.h"
+#include "uiee_ring_buffer.h"
+
+// 多分区热模型
+// 按 /sys/class/thermal/thermal_zone*/type 把温度分区归为 CPU/GPU/机身/电池四类（同类取最高），
+// 类型名按已知命名（cpu-*-*、cpuss-*、gpuss-*、*-therm、skin、battery 等）整体匹配，socd、*-lvl* 等非温度分区排除；
+// 每类用各自的降频点归一为 0-100 的热状态分数，取最大值作为整机热状态。
+// 监控线程每秒 update() 一次，把各类温度与当前整机功率记入历史环，并按一阶 RC 模型
+//     dT/dt = a·P − b·T + c       （c = b·T_环境）
+// 对最近的历史做最小二乘拟合，以当前功率外推 PREDICTION_HORIZON_S 秒后的温度；
+// 样本不足或拟合结果不符合物理意义（不散热、功率不升温）时退化为线性趋势外推。
+// 没有任何可识别分区时退化为 thermal_zone0，按原有 30-80°C 映射。
+class UIEEThermalModel {
+public:
+    enum Category {
+        CATEGORY_CPU,
+        CATEGORY_GPU,
+        CATEGORY_SKIN,        // 机身/外壳（xo、quiet 等板载热敏电阻）
+        CATEGORY_BATTERY,
+        CATEGORY_COUNT
+    };
+
+    static constexpr int MAX_ZONES = 32;
+    static constexpr int PREDICTION_HORIZON_S = 10;
+    static constexpr size_t HISTORY_SIZE = 120;          // 每秒一条，约2分钟
+
+    struct Estimate {
+        bool valid;                                      // 至少读到一个分区
+        bool present[CATEGORY_COUNT];
+        bool fitted[CATEGORY_COUNT];                     // 预测来自拟合的RC模型（否则为趋势外推）
+        double temp_c[CATEGORY_COUNT];                   // 当前温度（同类分区最大值）
+        double predicted_c[CATEGORY_COUNT];              // PREDICTION_HORIZON_S 秒后的预测温度
+        double state;                                    // 当前热状态分数（0-100）
+        double predicted_state;                          // 预测热状态分数（0-100）
+    };
+
+    UIEEThermalModel();
+
+    UIEEThermalModel(const UIEEThermalModel&) = delete;
+    UIEEThermalModel& operator=(const UIEEThermalModel&) = delete;
+
+    // 扫描温度分区并打开常驻fd，返回是否找到可读分区；重复调用会清空历史
+    bool discover(const std::string& thermal_root = "/sys/class/thermal");
+    int zoneCount() const;
+
+    // 读取全部分区、记入历史并重新拟合；power_w 为当前整机功率（瓦），未知时传 0。仅监控线程调用
+    Estimate update(double power_w);
+    // 读取当前温度，不记入历史也不拟合（没有 update() 过时使用），预测值等于当前值
+    Estimate sample();
+    // 最近一次 update() 的结果，任意线程可调用
+    Estimate latest() const;
+    bool hasEstimate() const;
+
+    static const char* categoryName(Category category);
+
+private:
+    struct Zone {
+        Category category;
+        UIEEProcFile temp_file;
+        double scale;                                    // 读数到摄氏度的系数，discover() 时按首次读数确定
+    };
+
+    // 历史环中的一条记录（可平凡拷贝）
+    struct Record {
+        int64_t time_ms;
+        float power_w;
+        float temp_c[CATEGORY_COUNT];                    // 缺失的类别记为 NaN
+    };
+
+    static constexpr size_t MIN_FIT_SAMPLES = 20;
+    static constexpr int TREND_WINDOW_S = 10;
+
+    mutable std::mutex mutex_;
+    std::vector<Zone> zones_;
+    bool legacy_;                                        // 只有 thermal_zone0，按旧映射计算
+    UIEERingBuffer<Record> history_{HISTORY_SIZE};
+    Estimate latest_;
+    bool has_estimate_;
+
+    bool readTemperatures(double* temp_c, bool* present);
+    bool fit(int category, double& a, double& b, double& c) const;
+    double trendSlope(int category) const;
+    double predict(int category, double temp_c, double power_w, bool& fitted) const;
+    double stateOf(int category, double temp_c) const;
+    void fillStates(Estimate& estimate) const;
+
+    static bool classify(const char* type, Category& category);
+};
+
+#endif // UIEE_THERMAL_H
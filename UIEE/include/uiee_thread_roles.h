@@ -0,0 +1,84 @@
+#ifndef UIEE_THREAD_ROLES_H
+#define UIEE_THREAD_ROLES_H
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include "uiee_placement.h"
+#include "uiee_topology.h"
+
+// 前台应用的线程级调度
+// 帧时间取决于主线程、RenderThread 和游戏引擎的工作线程，而不是整个进程。
+// 按 /proc/<pid>/task/<tid>/comm 把线程分为主线程/渲染/工作/后台几类，TID→角色结果缓存，
+// 每次只为新出现的线程读取 comm（未识别的线程隔几轮再读一次，线程可能在启动后才改名）。
+// 关键线程提升 nice、放到进程的目标簇并抬高 uclamp 下限，GC/JIT 等后台线程降级到小核。
+// 只在目标值变化时发起系统调用；非线程安全，调用方持有任务表锁。
+class UIEEThreadRoleScheduler {
+public:
+    enum Role : uint8_t {
+        ROLE_OTHER,        // 未识别，不做调整
+        ROLE_MAIN,         // 主线程（TID == PID，Android 的 UI 线程）
+        ROLE_RENDER,       // 渲染/游戏主循环线程
+        ROLE_WORKER,       // 游戏引擎工作线程
+        ROLE_BACKGROUND,   // GC、JIT 等与帧无关的后台线程
+        ROLE_COUNT
+    };
+
+    struct RoleSummary {
+        int threads = 0;
+        int roles[ROLE_COUNT] = {};
+    };
+
+    UIEEThreadRoleScheduler(UIEEPlacementEngine& placement, const UIEECpuTopology& topology);
+
+    UIEEThreadRoleScheduler(const UIEEThreadRoleScheduler&) = delete;
+    UIEEThreadRoleScheduler& operator=(const UIEEThreadRoleScheduler&) = delete;
+
+    // comm 为线程名（最长15字节，不含换行）
+    static Role classify(const char* comm, size_t length, bool is_main);
+    static const char* roleName(Role role);
+
+    // 刷新线程列表并按进程当前的放置下发线程级调整；进程已退出时返回 false 且 errno 为 ESRCH
+    bool apply(int pid, const UIEEPlacementEngine::Placement& placement, UIEEPlacementEngine::Stats& stats);
+    // 撤销线程级调整：nice 恢复为调整前的值，掩码恢复为 restore_mask（0 表示全部核心），uclamp 复位
+    bool restore(int pid, uint32_t restore_mask, UIEEPlacementEngine::Stats& stats);
+    // 进程级放置重新下发后线程掩码/uclamp 已被覆盖，下次 apply 时重新下发
+    void invalidate(int pid);
+    bool tracks(int pid) const { return processes_.count(pid) != 0; }
+    void forget(int pid) { processes_.erase(pid); }
+
+    bool summary(int pid, RoleSummary& out) const;
+
+private:
+    static constexpr int8_t NICE_UNSET = INT8_MIN;
+    static constexpr uint8_t RECLASSIFY_SCANS = 8;   // 未识别线程每隔几轮重读一次 comm
+    static constexpr size_t MAX_THREADS = 512;
+
+    struct ThreadEntry {
+        int32_t tid;
+        uint8_t role;
+        uint8_t scans_since_classify;
+        int8_t original_nice;        // 第一次调整前的 nice，NICE_UNSET 表示未调整过
+        int8_t applied_nice;
+        uint32_t applied_mask;       // 0 表示未由线程级调度设置
+        uint16_t applied_uclamp_min;
+        uint16_t applied_uclamp_max;
+        bool uclamp_applied;
+    };
+
+    struct ProcessThreads {
+        std::vector<ThreadEntry> threads;   // 按 TID 排序
+    };
+
+    UIEEPlacementEngine& placement_;
+    const UIEECpuTopology& topology_;
+    std::unordered_map<int, ProcessThreads> processes_;
+    std::vector<int> tid_buffer_;
+    std::vector<ThreadEntry> merge_buffer_;
+
+    bool scan(int pid, ProcessThreads& process);
+    static Role readRole(int pid, int tid);
+};
+
+#endif // UIEE_THREAD_ROLES_H
@@ -0,0 +1,75 @@
+#ifndef UIEE_TOPOLOGY_H
+#define UIEE_TOPOLOGY_H
+
+#include "uiee_procfs.h"
+#include "uiee_sampler.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <mutex>
+
+// CPU拓扑（big.LITTLE 簇划分）
+// 遍历 /sys/devices/system/cpu/cpu*/cpufreq 的 related_cpus、cpuinfo_max_freq、
+// scaling_cur_freq 以及 cpu*/cpu_capacity，按容量把 cpufreq policy 划分为小核/大核/超大核簇
+class UIEECpuTopology {
+public:
+    static constexpr int MAX_CPU_CORES = UIEESystemSampler::MAX_CPU_CORES;
+    static constexpr int MAX_CLUSTERS = 4;
+
+    enum ClusterType {
+        CLUSTER_LITTLE,   // 小核
+        CLUSTER_BIG,      // 大核
+        CLUSTER_PRIME     // 超大核
+    };
+
+    struct Cluster {
+        ClusterType type;
+        uint32_t cpu_mask;           // 簇内CPU位图
+        int first_cpu;               // policy 所在CPU
+        int core_count;
+        uint32_t max_freq_khz;       // cpuinfo_max_freq
+        uint32_t min_freq_khz;       // cpuinfo_min_freq
+        uint32_t capacity;           // cpu_capacity（缺失时按最高频率折算）
+    };
+
+    UIEECpuTopology();
+
+    UIEECpuTopology(const UIEECpuTopology&) = delete;
+    UIEECpuTopology& operator=(const UIEECpuTopology&) = delete;
+
+    // 扫描拓扑，失败时退化为单簇（全部核心视为大核）
+    bool discover(int fallback_cores, const std::string& sysfs_root = "/sys/devices/system/cpu");
+
+    int coreCount() const { return core_count_; }
+    int clusterCount() const { return static_cast<int>(clusters_.size()); }
+    const Cluster& cluster(int index) const { return clusters_[index]; }
+    int clusterOfCore(int cpu) const;
+
+    // 指定类型簇的CPU位图；不存在时向下回退（超大核→大核→小核）
+    uint32_t clusterMask(ClusterType type) const;
+    int clusterIndex(ClusterType type) const;
+
+    uint32_t coreMaxFrequency(int cpu) const;
+    uint32_t coreCapacity(int cpu) const;
+
+    // 读取各簇的 scaling_cur_freq（每簇一个常驻fd），结果按核心展开
+    void sampleFrequencies(uint32_t* core_freq_khz, int max_cores);
+
+    static const char* clusterTypeName(ClusterType type);
+    // 解析 "0-3,6" 或 "0 1 2 3" 形式的CPU列表为位图
+    static uint32_t parseCpuList(const char* text, size_t length);
+
+private:
+    int core_count_;
+    std::vector<Cluster> clusters_;
+    int core_to_cluster_[MAX_CPU_CORES];
+    uint32_t core_capacity_[MAX_CPU_CORES];
+
+    std::mutex freq_mutex_;
+    std::vector<UIEEProcFile> cur_freq_files_;  // 与 clusters_ 一一对应
+    char freq_buffer_[32];
+
+    static bool readU64File(const std::string& path, uint64_t& value);
+};
+
+#endif // UIEE_TOPOLOGY_H
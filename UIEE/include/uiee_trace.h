@@ -0,0 +1,140 @@
+#ifndef UIEE_TRACE_H
+#define UIEE_TRACE_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// 热路径分阶段计时
+// 每个阶段一个对数-线性分桶直方图（HDR 风格：每个二进制数量级 8 个子桶，相对误差约12.5%），
+// 记录只是几次 relaxed 原子加，可在任意线程并发调用；另有若干累加计数器。
+// 可选地把阶段的开始/结束写入 ftrace trace_marker（atrace 格式 B|pid|name / E|pid），
+// Perfetto 抓取 ftrace/atrace 时引擎的各阶段会和应用的帧显示在同一时间轴上。
+// 编译时未定义 UIEE_ENABLE_TRACING 时 UIEE_TRACE_* 宏展开为空，发布版本没有任何开销。
+class UIEETracer {
+public:
+    enum Phase {
+        PHASE_SCHEDULING,       // performScheduling 整体
+        PHASE_MONITOR_SCAN,     // 监控循环的 /proc 校正扫描
+        PHASE_METRICS_SAMPLE,   // 一次性能指标采样
+        PHASE_FITNESS_BATCH,    // 批量适应度评估
+        PHASE_GAME_ROUND,       // 一轮重复博弈
+        PHASE_POLICY_APPLY,     // 调度策略差量下发（系统调用）
+        PHASE_COUNT
+    };
+
+    enum Counter {
+        COUNTER_POLICY_SYSCALLS,
+        COUNTER_POLICY_FAILURES,
+        COUNTER_POLICY_SKIPPED,
+        COUNTER_FITNESS_EVALUATIONS,
+        COUNTER_TASKS_SCANNED,
+        COUNTER_COUNT
+    };
+
+    struct PhaseSummary {
+        uint64_t count;
+        double mean_us;
+        double p50_us;
+        double p90_us;
+        double p99_us;
+        double max_us;
+    };
+
+    static UIEETracer& instance();
+
+    void record(Phase phase, uint64_t nanoseconds);
+    void add(Counter counter, uint64_t value) { counters_[counter].fetch_add(value, std::memory_order_relaxed); }
+
+    PhaseSummary summary(Phase phase) const;
+    uint64_t counter(Counter counter) const { return counters_[counter].load(std::memory_order_relaxed); }
+    void reset();
+
+    // trace_marker 输出；tracefs 不可写时返回 false（需要 root，且内核开启了 ftrace）。
+    // 文件打开后保留到进程退出，关闭输出只清除开关，其他线程正在写入时不会用到失效的fd
+    bool setMarkerEnabled(bool enabled);
+    bool markerEnabled() const { return marker_enabled_.load(std::memory_order_acquire); }
+    // B/E 必须成对：调用方只在写过 markBegin() 时才调用 markEnd()
+    void markBegin(Phase phase);
+    void markEnd();
+
+    static const char* phaseName(Phase phase);
+    static const char* counterName(Counter counter);
+
+    // 追加到 JSON 对象中的 "trace" 字段内容（不含外层花括号）；报告为多行文本
+    void appendJson(std::string& out) const;
+    void appendReport(std::string& out) const;
+
+private:
+    // 0..15 ns 各一个桶，之后每个数量级 8 个子桶，上限约 2^44 ns（约4.9小时）
+    static constexpr int LINEAR_BUCKETS = 16;
+    static constexpr int SUB_BUCKET_BITS = 3;
+    static constexpr int MAX_EXPONENT = 44;
+    static constexpr int BUCKETS = LINEAR_BUCKETS + (MAX_EXPONENT - 4 + 1) * (1 << SUB_BUCKET_BITS);
+
+    struct Histogram {
+        std::atomic<uint64_t> buckets[BUCKETS];
+        std::atomic<uint64_t> count;
+        std::atomic<uint64_t> sum_ns;
+        std::atomic<uint64_t> max_ns;
+    };
+
+    UIEETracer();
+    ~UIEETracer();
+
+    void writeMarker(const char* buffer, int length);
+    UIEETracer(const UIEETracer&) = delete;
+    UIEETracer& operator=(const UIEETracer&) = delete;
+
+    static int bucketIndex(uint64_t nanoseconds);
+    static uint64_t bucketUpperBound(int index);
+    static double percentile(const uint64_t* buckets, uint64_t count, double fraction);
+
+    Histogram histograms_[PHASE_COUNT];
+    std::atomic<uint64_t> counters_[COUNTER_COUNT];
+    int marker_fd_;
+    std::atomic<bool> marker_enabled_;
+    int pid_;
+};
+
+// 作用域计时：构造到析构的耗时计入阶段直方图。
+// 构造时记下是否写了 B 事件，析构时据此写 E，作用域内开关切换也不会留下不成对的事件
+class UIEETraceScope {
+public:
+    explicit UIEETraceScope(UIEETracer::Phase phase)
+        : phase_(phase), marked_(UIEETracer::instance().markerEnabled()), start_(std::chrono::steady_clock::now()) {
+        if (marked_) {
+            UIEETracer::instance().markBegin(phase_);
+        }
+    }
+    ~UIEETraceScope() {
+        UIEETracer& tracer = UIEETracer::instance();
+        auto elapsed = std::chrono::steady_clock::now() - start_;
+        tracer.record(phase_, static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+        if (marked_) {
+            tracer.markEnd();
+        }
+    }
+
+    UIEETraceScope(const UIEETraceScope&) = delete;
+    UIEETraceScope& operator=(const UIEETraceScope&) = delete;
+
+private:
+    UIEETracer::Phase phase_;
+    bool marked_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+#ifdef UIEE_ENABLE_TRACING
+#define UIEE_TRACE_CONCAT_(a, b) a##b
+#define UIEE_TRACE_CONCAT(a, b) UIEE_TRACE_CONCAT_(a, b)
+#define UIEE_TRACE_SCOPE(phase) UIEETraceScope UIEE_TRACE_CONCAT(uiee_trace_scope_, __LINE__)(UIEETracer::phase)
+#define UIEE_TRACE_COUNT(counter, value) UIEETracer::instance().add(UIEETracer::counter, static_cast<uint64_t>(value))
+#else
+#define UIEE_TRACE_SCOPE(phase) ((void)0)
+#define UIEE_TRACE_COUNT(counter, value) ((void)0)
+#endif
+
+#endif // UIEE_TRACE_H
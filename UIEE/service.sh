@@ -87,6 +87,7 @@ init_directories() {
     mkdir -p "$MODDATA/cache"
     mkdir -p "$MODDATA/logs"
     mkdir -p "$MODDATA/performance"
+    mkdir -p "$MODDATA/evolution"
     
     # 设置正确权限
     chmod 755 "$MODPATH"
@@ -135,6 +136,7 @@ auto_smart_priority=4
 [scene_perception]
 # 场景感知
 enable_scene_detection=true
+enable_frame_timing=true
 game_fps_target=60
 social_fps_target=30
 media_fps_target=30
@@ -145,6 +147,18 @@ productivity_fps_target=60
 log_level=INFO
 max_log_size=10
 enable_performance_log=true
+enable_trace_marker=false
+
+[web_ui]
+# 内置Web UI服务
+enable_web_ui=true
+web_ui_port=8080
+
+[device_discovery]
+# 设备自发现设置
+enable_auto_discovery=true
+cache_device_info=true
+performance_profiling=true
 EOF
     
     log_success "默认配置创建完成"
@@ -251,53 +265,14 @@ start_uiee_engine() {
 
 # 启动Web UI服务
 start_web_ui() {
-    log_info "启动Web UI服务"
-    
-    # 检查Web UI文件
+    # Web UI 由核心引擎内置的服务提供（静态文件、/api 接口与 SSE 推送），这里只做检查
     if [ ! -f "$MODPATH/webroot/index.html" ]; then
-        log_info "Web UI文件不存在，跳过Web UI启动"
+        log_info "Web UI文件不存在，引擎将只提供 /api 接口"
         return 0
     fi
     
-    # 使用busybox内置的httpd启动Web UI
-    cd "$MODPATH/webroot"
-    
-    # 尝试使用busybox httpd
-    if command -v busybox >/dev/null 2>&1; then
-        busybox httpd -f -p 8080 -h "$MODPATH/webroot" > "$MODLOGS/web_ui.log" 2>&1 &
-        local web_pid=$!
-    else
-        # 备用方案：使用简单的shell脚本提供Web服务
-        start_simple_web_server
-        return $?
-    fi
-    
-    # 检查Web UI是否启动成功
-    sleep 2
-    if kill -0 "$web_pid" 2>/dev/null; then
-        echo "$web_pid" > "$MODDATA/web_ui.pid"
-        log_success "Web UI服务启动成功，PID: $web_pid，端口: 8080"
-    else
-        log_error "Web UI服务启动失败"
-    fi
-    
-    cd "$MODPATH"
-}
-
-# 简单的Web服务器（备用方案）
-start_simple_web_server() {
-    log_info "启动简单Web服务器"
-    
-    # 创建一个简单的shell Web服务器
-    while true; do
-        # 监听8080端口
-        nc -l -p 8080 -e /system/bin/sh -c 'echo -e "HTTP/1.1 200 OK\nContent-Type: text/html\n\n$(cat $MODPATH/webroot/index.html)"' 2>/dev/null || break
-        sleep 1
-    done &
-    
-    local web_pid=$!
-    echo "$web_pid" > "$MODDATA/web_ui.pid"
-    log_success "简单Web服务器启动成功，PID: $web_pid"
+    local web_port=$(grep -E '^web_ui_port=' "$MODDATA/config/uiee.conf" 2>/dev/null | cut -d= -f2)
+    log_success "Web UI由核心引擎提供，端口: ${web_port:-8080}"
 }
 
 # 性能监控
@@ -4,11 +4,13 @@
 class UIEEModule {
     constructor() {
         this.apiBase = '/api';
-        this.updateInterval = 2000; // 2秒更新一次
+        this.updateInterval = 2000; // SSE不可用时的轮询间隔
         this.isEngineRunning = false;
         this.currentScene = 0;
         this.logContainer = null;
         this.updateTimer = null;
+        this.eventSource = null;
+        this.accessToken = this.loadAccessToken();
         
         this.init();
     }
@@ -105,12 +107,27 @@ class UIEEModule {
         }
     }
     
+    // 写接口令牌：引擎启动时写入 data/web_ui.token，通过 ?token= 打开页面后在本会话内保留
+    loadAccessToken() {
+        try {
+            const token = new URLSearchParams(window.location.search).get('token');
+            if (token) {
+                sessionStorage.setItem('uiee_token', token);
+                return token;
+            }
+            return sessionStorage.getItem('uiee_token') || '';
+        } catch (error) {
+            return '';
+        }
+    }
+    
     // API调用封装
     async apiCall(endpoint, options = {}) {
         try {
             const response = await fetch(`${this.apiBase}${endpoint}`, {
                 headers: {
                     'Content-Type': 'application/json',
+                    'X-UIEE-Token': this.accessToken,
                     ...options.headers
                 },
                 ...options
@@ -130,31 +147,21 @@ class UIEEModule {
     
     // 获取引擎状态
     async getEngineStatus() {
-        try {
-            const data = await this.apiCall('/status');
-            return data;
-        } catch (error) {
-            // 如果API不可用，返回模拟数据
-            return this.getMockStatus();
-        }
-    }
-    
-    // 模拟状态数据（用于测试）
-    getMockStatus() {
-        return {
-            engine_status: this.isEngineRunning ? 'running' : 'stopped',
-            current_scene: this.currentScene,
-            active_tasks: Math.floor(Math.random() * 20) + 5,
-            ces_score: (Math.random() * 30 + 70).toFixed(1),
-            cpu_usage: (Math.random() * 50 + 20).toFixed(1),
-            memory_usage: (Math.random() * 40 + 30).toFixed(1),
-            thermal_state: (Math.random() * 30 + 10).toFixed(1),
-            timestamp: new Date().toLocaleString('zh-CN')
-        };
+        return await this.apiCall('/status');
+    }
+    
+    // 提交配置（只包含需要修改的字段）
+    async postConfig(settings) {
+        return await this.apiCall('/config', { method: 'POST', body: JSON.stringify(settings) });
     }
     
     // 更新状态显示
     updateStatusDisplay(status) {
+        // “启动/停止”按钮控制的是调度优化开关
+        this.isEngineRunning = status.engine_status === 'running' && status.optimization_enabled !== false;
+        this.currentScene = status.current_scene;
+        this.updateControlButtons();
+        
         // 更新引擎状态
         const engineStatus = document.getElementById('engine-status');
         if (engineStatus) {
@@ -165,28 +172,28 @@ class UIEEModule {
         // 更新CES分数
         const cesScore = document.getElementById('ces-score');
         if (cesScore) {
-            cesScore.textContent = status.ces_score;
+            cesScore.textContent = Number(status.ces_score).toFixed(1);
             this.updateScoreColor(cesScore, parseFloat(status.ces_score));
         }
         
         // 更新CPU使用率
         const cpuUsage = document.getElementById('cpu-usage');
         if (cpuUsage) {
-            cpuUsage.textContent = status.cpu_usage + '%';
+            cpuUsage.textContent = Number(status.cpu_usage).toFixed(1) + '%';
             this.updateUsageColor(cpuUsage, parseFloat(status.cpu_usage));
         }
         
         // 更新内存使用率
         const memoryUsage = document.getElementById('memory-usage');
         if (memoryUsage) {
-            memoryUsage.textContent = status.memory_usage + '%';
+            memoryUsage.textContent = Number(status.memory_usage).toFixed(1) + '%';
             this.updateUsageColor(memoryUsage, parseFloat(status.memory_usage));
         }
         
         // 更新热状态
         const thermalState = document.getElementById('thermal-state');
         if (thermalState) {
-            thermalState.textContent = status.thermal_state + '%';
+            thermalState.textContent = Number(status.thermal_state).toFixed(1) + '%';
             this.updateThermalColor(thermalState, parseFloat(status.thermal_state));
         }
         
@@ -256,42 +263,27 @@ class UIEEModule {
         });
     }
     
-    // 启动引擎
+    // 启动引擎（恢复调度优化，引擎进程本身由服务脚本守护）
     async startEngine() {
-        this.addLog('正在启动UIEE引擎...', 'info');
+        this.addLog('正在启用UIEE调度...', 'info');
         
         try {
-            // 模拟启动过程
-            await this.delay(2000);
-            
-            this.isEngineRunning = true;
-            this.addLog('UIEE引擎启动成功', 'success');
-            
-            // 更新按钮状态
-            this.updateControlButtons();
-            
-            // 立即更新一次状态
+            await this.postConfig({ optimization_enabled: true });
+            this.addLog('UIEE调度已启用', 'success');
             await this.updateStatus();
-            
         } catch (error) {
             this.addLog(`启动引擎失败: ${error.message}`, 'error');
         }
     }
     
-    // 停止引擎
+    // 停止引擎（暂停调度优化）
     async stopEngine() {
-        this.addLog('正在停止UIEE引擎...', 'info');
+        this.addLog('正在暂停UIEE调度...', 'info');
         
         try {
-            // 模拟停止过程
-            await this.delay(1000);
-            
-            this.isEngineRunning = false;
-            this.addLog('UIEE引擎已停止', 'warning');
-            
-            // 更新按钮状态
-            this.updateControlButtons();
-            
+            await this.postConfig({ optimization_enabled: false });
+            this.addLog('UIEE调度已暂停', 'warning');
+            await this.updateStatus();
         } catch (error) {
             this.addLog(`停止引擎失败: ${error.message}`, 'error');
         }
@@ -312,8 +304,7 @@ class UIEEModule {
         this.addLog(`切换到场景模式: ${this.getSceneName(sceneId)}`, 'info');
         
         try {
-            // 这里可以调用API更新场景设置
-            // await this.apiCall('/scene', { method: 'POST', body: JSON.stringify({ scene: sceneId }) });
+            await this.apiCall('/scene', { method: 'POST', body: JSON.stringify({ scene: this.currentScene }) });
             
             // 更新UI
             this.updateSceneDescription(this.currentScene);
@@ -340,8 +331,7 @@ class UIEEModule {
         this.addLog('更新CTO设置...', 'info');
         
         try {
-            // 这里可以调用API更新CTO设置
-            // await this.apiCall('/cto', { method: 'POST', body: JSON.stringify(settings) });
+            await this.postConfig(settings);
             
             this.addLog('CTO设置已更新', 'success');
             
@@ -355,9 +345,8 @@ class UIEEModule {
         this.addLog(`更新调度间隔: ${interval}秒`, 'info');
         
         try {
-            // 这里可以调用API更新调度间隔
-            // await this.apiCall('/config', { method: 'POST', body: JSON.stringify({ scheduling_interval: interval }) });
-            
+            await this.postConfig({ scheduling_interval: parseInt(interval) });
+            this.addLog('调度间隔已更新', 'success');
         } catch (error) {
             this.addLog(`更新调度间隔失败: ${error.message}`, 'error');
         }
@@ -368,9 +357,8 @@ class UIEEModule {
         this.addLog(`更新优化级别: ${level}%`, 'info');
         
         try {
-            // 这里可以调用API更新优化级别
-            // await this.apiCall('/config', { method: 'POST', body: JSON.stringify({ optimization_level: level }) });
-            
+            // 优化级别为0时关闭调度优化，其余级别保持开启
+            await this.postConfig({ optimization_enabled: parseInt(level) > 0 });
         } catch (error) {
             this.addLog(`更新优化级别失败: ${error.message}`, 'error');
         }
@@ -395,10 +383,35 @@ class UIEEModule {
         }
     }
     
-    // 启动状态更新
+    // 启动状态更新：优先订阅引擎推送（SSE），连接失败时回退到轮询
     startStatusUpdate() {
-        if (this.updateTimer) {
-            clearInterval(this.updateTimer);
+        this.stopStatusUpdate();
+        
+        if (window.EventSource) {
+            this.eventSource = new EventSource(`${this.apiBase}/events`);
+            this.eventSource.addEventListener('status', (e) => {
+                this.updateStatusDisplay(JSON.parse(e.data));
+            });
+            this.eventSource.addEventListener('evolution', (e) => {
+                this.updateEvolutionDisplay(JSON.parse(e.data));
+            });
+            this.eventSource.onopen = () => {
+                if (this.updateTimer) {
+                    clearInterval(this.updateTimer);
+                    this.updateTimer = null;
+                    this.addLog('已恢复引擎实时推送', 'success');
+                }
+            };
+            this.eventSource.onerror = () => {
+                // EventSource 会自行重连，重连期间先用轮询保持刷新
+                if (!this.updateTimer) {
+                    this.addLog('实时推送中断，改为定时刷新', 'warning');
+                    this.updateTimer = setInterval(() => {
+                        this.updateStatus();
+                    }, this.updateInterval);
+                }
+            };
+            return;
         }
         
         this.updateTimer = setInterval(() => {
@@ -411,12 +424,24 @@ class UIEEModule {
     
     // 停止状态更新
     stopStatusUpdate() {
+        if (this.eventSource) {
+            this.eventSource.close();
+            this.eventSource = null;
+        }
         if (this.updateTimer) {
             clearInterval(this.updateTimer);
             this.updateTimer = null;
         }
     }
     
+    // 更新进化状态
+    updateEvolutionDisplay(evolution) {
+        const generation = document.getElementById('evolution-generation');
+        if (generation && evolution.evolution_status) {
+            generation.textContent = evolution.evolution_status.generation;
+        }
+    }
+    
     // 更新状态
     async updateStatus() {
         try {
@@ -516,12 +541,12 @@ window.addEventListener('offline', () => {
 // 处理页面可见性变化
 document.addEventListener('visibilitychange', () => {
     if (document.hidden) {
-        // 页面隐藏时暂停更新
+        // 页面隐藏时断开推送
         if (window.uieeModule) {
             window.uieeModule.stopStatusUpdate();
         }
     } else {
-        // 页面显示时恢复更新
+        // 页面显示时重新订阅
         if (window.uieeModule) {
             window.uieeModule.startStatusUpdate();
         }